@@ -0,0 +1,330 @@
+/**
+ * @file       bench_common.hpp
+ *
+ * @brief      Timing helpers shared by the host benchmarks
+ *
+ *      Cycle counter, cache eviction and the warm/cold measurement loops used by
+ *      bench_kernels. Everything is header-only so each benchmark executable is a
+ *      single translation unit plus the mc library.
+ *
+ *      "cycles" are counter ticks: the invariant TSC on x86 (reference cycles, not
+ *      core cycles when turbo is active) and CNTVCT on AArch64. Elsewhere the
+ *      counter falls back to steady_clock nanoseconds.
+ */
+#ifndef BENCH_COMMON_HPP_
+#define BENCH_COMMON_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #define BENCH_X86 1
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+    #endif
+#endif
+
+namespace bench {
+
+using clock = std::chrono::steady_clock;
+
+//*****************************************************************************
+//
+// counters
+//
+//*****************************************************************************
+inline uint64_t cycles()
+{
+#if defined(BENCH_X86)
+    _mm_lfence();
+    uint64_t t = __rdtsc();
+    _mm_lfence();
+    return t;
+#elif defined(__aarch64__)
+    uint64_t t;
+    asm volatile("isb; mrs %0, cntvct_el0" : "=r"(t) :: "memory");
+    return t;
+#else
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        clock::now().time_since_epoch()).count();
+#endif
+}
+
+inline double now_ns()
+{
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        clock::now().time_since_epoch()).count();
+}
+
+// counter ticks per nanosecond, measured once against steady_clock
+inline double ticks_per_ns()
+{
+    static double ratio = 0;
+    if (ratio == 0) {
+        double   t0 = now_ns();
+        uint64_t c0 = cycles();
+        while (now_ns() - t0 < 50e6) {
+        }
+        ratio = (double)(cycles() - c0) / (now_ns() - t0);
+    }
+    return ratio;
+}
+
+// keep the compiler from caching values across the call under test
+inline void clobber()
+{
+#if defined(_MSC_VER)
+    _ReadWriteBarrier();
+#else
+    asm volatile("" ::: "memory");
+#endif
+}
+
+template <class T>
+inline void keep(T const& v)
+{
+#if defined(_MSC_VER)
+    volatile T sink = v;
+    (void)sink;
+#else
+    asm volatile("" : : "r,m"(v) : "memory");
+#endif
+}
+
+//*****************************************************************************
+//
+// cache eviction
+//
+//*****************************************************************************
+
+// evict [p, p+bytes) from every cache level. Works on code addresses too.
+inline void flush(const void* p, size_t bytes)
+{
+#if defined(BENCH_X86)
+    const char* first = (const char*)((uintptr_t)p & ~(uintptr_t)63);
+    const char* last  = (const char*)p + bytes;
+    for (; first < last; first += 64) {
+        _mm_clflush(first);
+    }
+    _mm_mfence();
+#else
+    // no user-level flush instruction: thrash a buffer larger than the LLC
+    static std::vector<uint8_t> junk(32u << 20);
+    for (size_t i = 0; i < junk.size(); i += 64) {
+        junk[i]++;
+    }
+    clobber();
+    (void)p;
+    (void)bytes;
+#endif
+}
+
+// function bodies are small; flushing the first few lines covers the hot path
+template <class F>
+inline void flush_code(F* fn, size_t bytes = 512)
+{
+    flush((const void*)fn, bytes);
+}
+
+//*****************************************************************************
+//
+// random inputs
+//
+//*****************************************************************************
+class Rng
+{
+public:
+    explicit Rng(uint32_t seed = 0x5eed1234u) : gen_(seed) {}
+
+    float uniform(float lo, float hi)
+    {
+        return std::uniform_real_distribution<float>(lo, hi)(gen_);
+    }
+
+    std::vector<float> vec(size_t n, float lo, float hi)
+    {
+        std::vector<float> v(n);
+        for (auto& x : v) {
+            x = uniform(lo, hi);
+        }
+        return v;
+    }
+
+private:
+    std::mt19937 gen_;
+};
+
+//*****************************************************************************
+//
+// measurement
+//
+//*****************************************************************************
+struct Options
+{
+    const char* filter       = nullptr;     // substring match on kernel name
+    size_t      warm_calls   = 1u << 21;
+    size_t      cold_samples = 2000;
+    bool        csv          = false;
+};
+
+struct Result
+{
+    double warm_ns;
+    double warm_cyc;
+    double cold_ns;
+    double cold_cyc;
+};
+
+inline bool selected(const Options& opt, const char* name)
+{
+    return opt.filter == nullptr || std::strstr(name, opt.filter) != nullptr;
+}
+
+inline void print_header(const Options& opt)
+{
+    if (opt.csv) {
+        std::printf("kernel,warm_ns,warm_cycles,cold_ns,cold_cycles\n");
+    }
+    else {
+        std::printf("%-28s %12s %12s %12s %12s\n", "kernel",
+                    "warm ns", "warm cyc", "cold ns", "cold cyc");
+    }
+}
+
+inline void print_result(const Options& opt, const char* name, const Result& r)
+{
+    if (opt.csv) {
+        std::printf("%s,%.3f,%.2f,%.3f,%.2f\n", name, r.warm_ns, r.warm_cyc, r.cold_ns, r.cold_cyc);
+    }
+    else {
+        std::printf("%-28s %12.2f %12.1f %12.2f %12.1f\n", name,
+                    r.warm_ns, r.warm_cyc, r.cold_ns, r.cold_cyc);
+    }
+}
+
+/**
+ * @brief      Warm-cache cost: call fn(i) back to back over the input set
+ *
+ * @param      fn     kernel invocation for input index i
+ * @param[in]  n      number of distinct input vectors (cycled through)
+ * @param[in]  calls  total number of calls
+ */
+template <class Fn>
+inline void measure_warm(Fn&& fn, size_t n, size_t calls, double& ns, double& cyc)
+{
+    for (size_t i = 0; i < n; i++) {     // warm up caches and predictors
+        fn(i);
+    }
+
+    double   t0 = now_ns();
+    uint64_t c0 = cycles();
+    for (size_t k = 0, i = 0; k < calls; k++) {
+        fn(i);
+        clobber();
+        if (++i == n) {
+            i = 0;
+        }
+    }
+    uint64_t c1 = cycles();
+    double   t1 = now_ns();
+
+    ns  = (t1 - t0) / (double)calls;
+    cyc = (double)(c1 - c0) / (double)calls;
+}
+
+/**
+ * @brief      Cold-cache cost: evict, then time a single call; median of samples
+ *
+ * @param      fn     kernel invocation for input index i
+ * @param      evict  evicts the state, inputs and code touched by fn(i)
+ * @param[in]  n      number of distinct input vectors
+ */
+template <class Fn, class Evict>
+inline void measure_cold(Fn&& fn, Evict&& evict, size_t n, size_t samples, double& ns, double& cyc)
+{
+    std::vector<uint64_t> t(samples);
+    std::vector<uint64_t> empty(samples);
+
+    for (size_t s = 0; s < samples; s++) {
+        size_t i = s % n;
+
+        evict(i);
+        uint64_t c0 = cycles();
+        clobber();
+        uint64_t c1 = cycles();
+        empty[s] = c1 - c0;
+
+        evict(i);
+        c0 = cycles();
+        fn(i);
+        clobber();
+        c1 = cycles();
+        t[s] = c1 - c0;
+    }
+
+    std::nth_element(t.begin(), t.begin() + samples / 2, t.end());
+    std::nth_element(empty.begin(), empty.begin() + samples / 2, empty.end());
+    double med = (double)t[samples / 2] - (double)empty[samples / 2];
+    if (med < 0) {
+        med = 0;
+    }
+
+    cyc = med;
+    ns  = med / ticks_per_ns();
+}
+
+template <class Fn, class Evict>
+inline void run(const Options& opt, const char* name, size_t n, Fn&& fn, Evict&& evict)
+{
+    if (!selected(opt, name)) {
+        return;
+    }
+
+    Result r;
+    measure_warm(fn, n, opt.warm_calls, r.warm_ns, r.warm_cyc);
+    measure_cold(fn, evict, n, opt.cold_samples, r.cold_ns, r.cold_cyc);
+    print_result(opt, name, r);
+}
+
+inline Options parse_args(int argc, char** argv)
+{
+    Options opt;
+    for (int k = 1; k < argc; k++) {
+        if (!std::strcmp(argv[k], "--csv")) {
+            opt.csv = true;
+        }
+        else if (!std::strcmp(argv[k], "--filter") && k + 1 < argc) {
+            opt.filter = argv[++k];
+        }
+        else if (!std::strcmp(argv[k], "--calls") && k + 1 < argc) {
+            opt.warm_calls = std::strtoull(argv[++k], nullptr, 0);
+        }
+        else if (!std::strcmp(argv[k], "--samples") && k + 1 < argc) {
+            opt.cold_samples = std::strtoull(argv[++k], nullptr, 0);
+        }
+        else {
+            std::fprintf(stderr,
+                "usage: %s [--filter <substr>] [--calls N] [--samples N] [--csv]\n", argv[0]);
+            std::exit(2);
+        }
+    }
+    if (opt.warm_calls == 0) {
+        opt.warm_calls = 1;
+    }
+    if (opt.cold_samples == 0) {
+        opt.cold_samples = 1;
+    }
+    return opt;
+}
+
+} // namespace bench
+
+#endif // <-- !defined BENCH_COMMON_HPP_
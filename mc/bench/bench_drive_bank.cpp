@@ -0,0 +1,296 @@
+/**
+ * @file       bench_drive_bank.cpp
+ * @date       Oct 2026
+ *
+ * @brief      Throughput of the multi-motor drive bank (drive_bank.h)
+ *
+ *      Three parts:
+ *        check   every instruction set against one FOC_Obj_t per drive over
+ *                --steps ticks of random inputs with the PI limits active:
+ *                duties, sectors, id/iq and the PI states must be bit-identical
+ *        width   ns per tick and per drive for 32..256 drives, one
+ *                foc_current_step() per drive against drive_bank_step() on
+ *                each instruction set the CPU has, and the modulator_batch()
+ *                share of the step (its own dispatch, the same under every
+ *                column); at 256 drives the step less that share, the part
+ *                the bank kernels are, per instruction set
+ *        cores   --banks banks of 256 drives stepped by 1, 2, 4 .. --threads
+ *                threads, each thread its own contiguous share of the banks;
+ *                drives per second and the scaling over one thread
+ *      Times are medians of 31 runs of --steps ticks, warm caches.
+ *
+ *      Usage: bench_drive_bank [--steps N] [--banks N] [--threads N]
+ *
+ *      Exit status: 0 when every instruction set is bit-identical to
+ *      foc_current_step() and the widest one runs 256 drives faster than the
+ *      per-drive calls, 1 otherwise, 2 on a usage error.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench_common.hpp"
+#include "ctrl_common.h"
+#include "drive_bank.h"
+#include "foc.h"
+
+namespace {
+
+struct Options
+{
+    uint32_t    steps   = 200;
+    uint32_t    banks   = 8;
+    uint32_t    threads = 0;        // 0: hardware_concurrency()
+};
+
+const SVM_mode_t kMode = (SVM_mode_t)SVM_MODE(SVPWM, SVM_OVM_MPE);
+
+// n drives with different gains and limits, as a bank and as FOC_Obj_t each
+struct Drives
+{
+    std::unique_ptr<DriveBank_Obj_t>    bank{new DriveBank_Obj_t};
+    std::vector<FOC_Obj_t>              foc;
+
+    Drives(uint16_t n, bench::Rng& rng) : foc(n)
+    {
+        drive_bank_init(bank.get(), n, 3, kMode);
+        for (uint16_t i = 0; i < n; i++) {
+            float lim = rng.uniform(0.3f, 0.8f);
+            foc_init(&foc[i], 3, kMode);
+            PID_Param_Init(&foc[i].pid_d, lim, -lim, 0.05f, rng.uniform(0.2f, 1.0f), 1e-4f, 1e-3f, 1, 0, 0, 0.3f);
+            PID_Param_Init(&foc[i].pid_q, lim, -lim, 0.05f, rng.uniform(0.2f, 1.0f), 1e-4f, 1e-3f, 1, 0, 0, 0.3f);
+            drive_bank_set_pi(bank.get(), i, &foc[i].pid_d, &foc[i].pid_q);
+        }
+    }
+
+    void inputs(bench::Rng& rng)
+    {
+        DriveBank_Obj_t* b = bank.get();
+        for (uint16_t i = 0; i < b->n; i++) {
+            b->ia[i] = rng.uniform(-1, 1);
+            b->ib[i] = rng.uniform(-1, 1);
+            b->ic[i] = -b->ia[i] - b->ib[i];
+            b->theta_e[i] = rng.uniform(-PI, PI);
+            b->id_ref[i] = rng.uniform(-0.2f, 0.2f);
+            b->iq_ref[i] = rng.uniform(-1.5f, 1.5f);
+        }
+    }
+
+    void step_foc()
+    {
+        const DriveBank_Obj_t* b = bank.get();
+        float duty[3];
+        for (uint16_t i = 0; i < b->n; i++) {
+            foc_current_step(&foc[i], b->ia[i], b->ib[i], b->ic[i], b->theta_e[i], b->id_ref[i], b->iq_ref[i],
+                             duty);
+            bench::keep(duty[0]);
+        }
+    }
+};
+
+// median ns of one call of fn, 31 runs of `steps` calls
+template <class Fn>
+double median_ns(Fn&& fn, uint32_t steps)
+{
+    std::vector<double> t(31);
+    fn();
+    for (double& x : t) {
+        double t0 = bench::now_ns();
+        for (uint32_t k = 0; k < steps; k++) {
+            fn();
+            bench::clobber();
+        }
+        x = (bench::now_ns() - t0) / steps;
+    }
+    std::nth_element(t.begin(), t.begin() + t.size() / 2, t.end());
+    return t[t.size() / 2];
+}
+
+// the instruction sets this CPU has, narrowest first
+std::vector<std::string> isas()
+{
+    std::vector<std::string> list;
+    for (const char* isa : {"scalar", "avx2", "avx512"}) {
+        if (drive_bank_set_isa(isa) == 0) {
+            list.push_back(isa);
+        }
+    }
+    return list;
+}
+
+// lanes differing from the per-drive loop over `steps` ticks, limited lanes counted in *limited
+uint64_t check(const std::string& isa, uint16_t n, uint32_t steps, uint64_t* limited)
+{
+    bench::Rng rng(n);
+    Drives d(n, rng);
+    uint64_t bad = 0;
+
+    drive_bank_set_isa(isa.c_str());
+    for (uint32_t s = 0; s < steps; s++) {
+        d.inputs(rng);
+        drive_bank_step(d.bank.get());
+        for (uint16_t i = 0; i < n; i++) {
+            const DriveBank_Obj_t* b = d.bank.get();
+            FOC_Obj_t* f = &d.foc[i];
+            PID_Obj_t pid_d = f->pid_d, pid_q = f->pid_q;
+            float duty[3];
+            foc_current_step(f, b->ia[i], b->ib[i], b->ic[i], b->theta_e[i], b->id_ref[i], b->iq_ref[i], duty);
+            drive_bank_get_pi(b, i, &pid_d, &pid_q);
+            const float m[3] = {b->ma[i], b->mb[i], b->mc[i]};
+            if (std::memcmp(duty, m, sizeof(m)) != 0 || b->sector[i] != f->svm.sector ||
+                std::memcmp(&f->id, &b->id[i], sizeof(float)) != 0 ||
+                std::memcmp(&f->iq, &b->iq[i], sizeof(float)) != 0 ||
+                std::memcmp(&pid_d, &f->pid_d, sizeof(pid_d)) != 0 ||
+                std::memcmp(&pid_q, &f->pid_q, sizeof(pid_q)) != 0) {
+                bad++;
+            }
+            *limited += b->sat[i] != 0;
+        }
+    }
+    return bad;
+}
+
+// drives per second of `banks` full banks on `threads` threads
+double cores(uint32_t banks, uint32_t threads, uint32_t steps)
+{
+    bench::Rng rng(1);
+    std::vector<std::unique_ptr<Drives>> all;
+    for (uint32_t k = 0; k < banks; k++) {
+        all.emplace_back(new Drives(DRIVE_BANK_MAX, rng));
+        all.back()->inputs(rng);
+    }
+
+    auto work = [&](uint32_t first, uint32_t last) {
+        for (uint32_t s = 0; s < steps; s++) {
+            for (uint32_t k = first; k < last; k++) {
+                drive_bank_step(all[k]->bank.get());
+            }
+        }
+    };
+
+    std::vector<double> t(5);
+    for (double& x : t) {
+        std::vector<std::thread> pool;
+        double t0 = bench::now_ns();
+        for (uint32_t w = 1; w < threads; w++) {
+            pool.emplace_back(work, banks * w / threads, banks * (w + 1) / threads);
+        }
+        work(0, banks / threads);
+        for (auto& th : pool) {
+            th.join();
+        }
+        x = bench::now_ns() - t0;
+    }
+    std::nth_element(t.begin(), t.begin() + t.size() / 2, t.end());
+    return (double)banks * DRIVE_BANK_MAX * steps / (t[t.size() / 2] * 1e-9);
+}
+
+Options parse_args(int argc, char** argv)
+{
+    Options opt;
+    bool ok = true;
+    for (int i = 1; i < argc; i++) {
+        bool more = i + 1 < argc;
+        if (std::strcmp(argv[i], "--steps") == 0 && more) {
+            opt.steps = (uint32_t)std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--banks") == 0 && more) {
+            opt.banks = (uint32_t)std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--threads") == 0 && more) {
+            opt.threads = (uint32_t)std::atoi(argv[++i]);
+        }
+        else {
+            ok = false;
+        }
+    }
+    if (!ok || opt.steps == 0 || opt.banks == 0) {
+        std::fprintf(stderr, "usage: %s [--steps N] [--banks N] [--threads N]\n", argv[0]);
+        std::exit(2);
+    }
+    if (opt.threads == 0) {
+        opt.threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    return opt;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opt = parse_args(argc, argv);
+    const std::vector<std::string> sets = isas();
+    bool pass = true;
+
+    std::printf("drive_bank: %s, modulator_batch: %s\n\n", sets.back().c_str(), modulator_batch_isa());
+
+    std::printf("check, %u ticks against foc_current_step()\n", opt.steps);
+    std::printf("%-8s %6s %12s %12s\n", "isa", "drives", "mismatches", "limited");
+    for (const auto& isa : sets) {
+        for (uint16_t n : {37, 256}) {
+            uint64_t limited = 0;
+            uint64_t bad = check(isa, n, opt.steps, &limited);
+            std::printf("%-8s %6u %12llu %12llu\n", isa.c_str(), n, (unsigned long long)bad,
+                        (unsigned long long)limited);
+            pass = pass && bad == 0;
+        }
+    }
+
+    std::printf("\nwidth, ns per tick (ns per drive)\n");
+    std::printf("%6s %18s", "drives", "foc_current_step");
+    for (const auto& isa : sets) {
+        std::printf(" %18s", ("bank/" + isa).c_str());
+    }
+    std::printf(" %18s %9s\n", ("svm/" + std::string(modulator_batch_isa())).c_str(), "speedup");
+    std::vector<double> kernel_ns;
+    for (uint16_t n : {32, 64, 128, 256}) {
+        bench::Rng rng(n);
+        Drives d(n, rng);
+        d.inputs(rng);
+        double t_foc = median_ns([&] { d.step_foc(); }, opt.steps);
+        double t_best = 0;
+        std::printf("%6u %9.0f (%6.2f)", n, t_foc, t_foc / n);
+        DriveBank_Obj_t* b = d.bank.get();
+        double t_svm = median_ns([&] {
+            modulator_batch(b->Ualpha, b->Ubeta, n, kMode, b->ma, b->mb, b->mc, b->sector);
+        }, opt.steps);
+        for (const auto& isa : sets) {
+            drive_bank_set_isa(isa.c_str());
+            double t = median_ns([&] { drive_bank_step(b); }, opt.steps);
+            std::printf(" %9.0f (%6.2f)", t, t / n);
+            t_best = t;
+            if (n == DRIVE_BANK_MAX) {
+                kernel_ns.push_back(t - t_svm);
+            }
+        }
+        std::printf(" %9.0f (%6.2f) %8.2fx\n", t_svm, t_svm / n, t_foc / t_best);
+        if (n == DRIVE_BANK_MAX && t_best >= t_foc) {
+            pass = false;
+        }
+    }
+
+    std::printf("transforms + PI, %u drives:", DRIVE_BANK_MAX);
+    for (size_t k = 0; k < sets.size(); k++) {
+        std::printf(" %s %.0f ns (%.2fx)%s", sets[k].c_str(), kernel_ns[k], kernel_ns[0] / kernel_ns[k],
+                    k + 1 < sets.size() ? "," : "\n");
+    }
+
+    drive_bank_set_isa(sets.back().c_str());
+    std::printf("\ncores, %u banks of %u drives on %s (%u hardware threads)\n", opt.banks, DRIVE_BANK_MAX,
+                sets.back().c_str(), std::thread::hardware_concurrency());
+    std::printf("%7s %14s %9s\n", "threads", "Mdrives/s", "scaling");
+    double base = 0;
+    for (uint32_t th = 1; th <= opt.threads; th *= 2) {
+        double rate = cores(opt.banks, std::min(th, opt.banks), opt.steps);
+        base = th == 1 ? rate : base;
+        std::printf("%7u %14.1f %8.2fx\n", th, rate * 1e-6, rate / base);
+    }
+
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,593 @@
+/**
+ * @file       bench_kernels.cpp
+ *
+ * @brief      Per-call cost of every control kernel
+ *
+ *      Each kernel is driven with a fixed-seed set of randomized input vectors and
+ *      reported twice:
+ *        - warm: back-to-back calls, state and code resident in L1, inputs in L2
+ *        - cold: state, current input and the kernel's code evicted before a single
+ *                timed call (median over samples, timer overhead subtracted)
+ *
+ *      Usage: bench_kernels [--filter <substr>] [--calls N] [--samples N] [--csv]
+ */
+
+#include <cmath>
+
+#include "bench_common.hpp"
+
+#include "adc_clarke.h"
+#include "ctrl_common.h"
+#include "decim.h"
+#include "filters.h"
+#include "foc.h"
+#include "instrument.h"
+#include "pid.h"
+#include "pll.h"
+#include "smo.h"
+#include "svm.h"
+#include "telemetry.h"
+#include "transforms.h"
+#include "trig.h"
+
+namespace {
+
+constexpr size_t kInputs = 16384;   // enough that branch predictors cannot learn the sequence
+
+struct AB
+{
+    float a;
+    float b;
+};
+
+std::vector<AB> random_ab(bench::Rng& rng, float lo, float hi)
+{
+    std::vector<AB> v(kInputs);
+    for (auto& x : v) {
+        x.a = rng.uniform(lo, hi);
+        x.b = rng.uniform(lo, hi);
+    }
+    return v;
+}
+
+void bench_svm(const bench::Options& opt, bench::Rng& rng)
+{
+    // mostly inside the hexagon, with some overmodulated samples
+    std::vector<AB> in = random_ab(rng, -0.7f, 0.7f);
+    SVM_t svm = {};
+
+    const struct
+    {
+        const char* name;
+        void (*fn)(SVM_t*, const float32_t, const float32_t, SVM_mode_t);
+        SVM_mode_t  mode;
+    } variants[] = {
+        {"modulator/SVPWM",      modulator,     SVPWM},
+        {"modulator/DMPWM3",     modulator,     DMPWM3},
+        {"modulator_lut/SVPWM",  modulator_lut, SVPWM},
+        {"modulator_lut/DMPWM3", modulator_lut, DMPWM3},
+        {"modulator/DPWM1",      modulator,     DPWM1},
+        {"modulator/DPWM1+MME",  modulator,     SVM_MODE(DPWM1, SVM_OVM_MME)},
+        {"modulator_lut/DPWM_ADAPTIVE", modulator_lut, DPWM_ADAPTIVE},
+        {"modulator_lut/DPWM1+MME", modulator_lut, SVM_MODE(DPWM1, SVM_OVM_MME)},
+    };
+
+    for (const auto& v : variants) {
+        auto fn = v.fn;
+        SVM_mode_t mode = v.mode;
+        bench::run(opt, v.name, kInputs,
+            [&](size_t i) { fn(&svm, in[i].a, in[i].b, mode); },
+            [&](size_t i) {
+                bench::flush(&svm, sizeof(svm));
+                bench::flush(&in[i], sizeof(in[i]));
+                bench::flush_code(fn);
+            });
+    }
+
+    // batched: one call modulates a block of kBlock samples, so the figures are per
+    // block; the warm call count is scaled down to keep the sample count comparable
+    constexpr size_t kBlock = 64;
+    std::vector<float>   ua(kInputs), ub(kInputs), ma(kBlock), mb(kBlock), mc(kBlock);
+    std::vector<int16_t> sector(kBlock);
+    for (size_t i = 0; i < kInputs; i++) {
+        ua[i] = in[i].a;
+        ub[i] = in[i].b;
+    }
+
+    bench::Options block_opt = opt;
+    block_opt.warm_calls = opt.warm_calls / kBlock + 1;
+
+    char batch_name[64], batch_ovm_name[64];
+    std::snprintf(batch_name, sizeof(batch_name), "modulator_batch/%s x%zu", modulator_batch_isa(), kBlock);
+    std::snprintf(batch_ovm_name, sizeof(batch_ovm_name), "modulator_batch/%s x%zu MME", modulator_batch_isa(),
+                  kBlock);
+
+    const struct
+    {
+        const char* name;
+        void (*fn)(const float32_t*, const float32_t*, uint32_t, SVM_mode_t,
+                   float32_t*, float32_t*, float32_t*, int16_t*);
+        SVM_mode_t  mode;
+    } batches[] = {
+        {batch_name,                  modulator_batch,        SVPWM},
+        {batch_ovm_name,              modulator_batch,        SVM_MODE(SVPWM, SVM_OVM_MME)},
+        {"modulator_batch_scalar x64", modulator_batch_scalar, SVPWM},
+    };
+
+    for (const auto& v : batches) {
+        auto fn = v.fn;
+        SVM_mode_t mode = v.mode;
+        bench::run(block_opt, v.name, kInputs / kBlock,
+            [&](size_t i) {
+                fn(&ua[i * kBlock], &ub[i * kBlock], kBlock, mode, ma.data(), mb.data(), mc.data(), sector.data());
+            },
+            [&](size_t i) {
+                bench::flush(&ua[i * kBlock], kBlock * sizeof(float));
+                bench::flush(&ub[i * kBlock], kBlock * sizeof(float));
+                bench::flush(ma.data(), kBlock * sizeof(float));
+                bench::flush(mb.data(), kBlock * sizeof(float));
+                bench::flush(mc.data(), kBlock * sizeof(float));
+                bench::flush(sector.data(), kBlock * sizeof(int16_t));
+                bench::flush_code(fn);
+            });
+    }
+}
+
+void bench_pid(const bench::Options& opt, bench::Rng& rng)
+{
+    std::vector<AB> in = random_ab(rng, -1.0f, 1.0f);   // (ref, fb)
+    PID_Obj_t pid;
+
+    PID_Data_Init(&pid, 0, 0, 0, 0, 0);
+    PID_Param_Init(&pid, 1.0f, -1.0f, 0.05f, 0.5f, 50e-6f, 1e-3f, 1, 0.0f, 0, 0.2f);
+
+    bench::run(opt, "PID_Update/PI", kInputs,
+        [&](size_t i) { PID_Update(&pid, in[i].a, in[i].b, 0.0f); },
+        [&](size_t i) {
+            bench::flush(&pid, sizeof(pid));
+            bench::flush(&in[i], sizeof(in[i]));
+            bench::flush_code(&PID_Update);
+        });
+
+    bench::run(opt, "PID_Update_PI", kInputs,
+        [&](size_t i) { PID_Update_PI(&pid, in[i].a, in[i].b, 0.0f); },
+        [&](size_t i) {
+            bench::flush(&pid, sizeof(pid));
+            bench::flush(&in[i], sizeof(in[i]));
+            bench::flush_code(&PID_Update_PI);
+        });
+
+    PID_Param_Init(&pid, 1.0f, -1.0f, 0.05f, 0.5f, 50e-6f, 1e-3f, 1, 1e-5f, 1, 0.2f);
+
+    bench::run(opt, "PID_Update/PID", kInputs,
+        [&](size_t i) { PID_Update(&pid, in[i].a, in[i].b, 0.0f); },
+        [&](size_t i) {
+            bench::flush(&pid, sizeof(pid));
+            bench::flush(&in[i], sizeof(in[i]));
+            bench::flush_code(&PID_Update);
+        });
+}
+
+void bench_transforms(const bench::Options& opt, bench::Rng& rng)
+{
+    std::vector<AB>    in    = random_ab(rng, -1.0f, 1.0f);
+    std::vector<float> theta = rng.vec(kInputs, 0.0f, TWO_PI);
+    Transform_Obj_t T = {};
+
+    auto evict = [&](size_t i, const void* code) {
+        bench::flush(&T, sizeof(T));
+        bench::flush(&in[i], sizeof(in[i]));
+        bench::flush(&theta[i], sizeof(theta[i]));
+        bench::flush(code, 512);
+    };
+
+    bench::run(opt, "abc2AB0/2-sensor", kInputs,
+        [&](size_t i) {
+            T.abc.a = in[i].a;
+            T.abc.b = in[i].b;
+            abc2AB0(&T, 2);
+        },
+        [&](size_t i) { evict(i, (const void*)&abc2AB0); });
+
+    bench::run(opt, "abc2AB0/3-sensor", kInputs,
+        [&](size_t i) {
+            T.abc.a = in[i].a;
+            T.abc.b = in[i].b;
+            T.abc.c = -in[i].a - in[i].b;
+            abc2AB0(&T, 3);
+        },
+        [&](size_t i) { evict(i, (const void*)&abc2AB0); });
+
+    bench::run(opt, "AB02abc", kInputs,
+        [&](size_t i) {
+            T.AB0.alpha = in[i].a;
+            T.AB0.beta  = in[i].b;
+            AB02abc(&T);
+        },
+        [&](size_t i) { evict(i, (const void*)&AB02abc); });
+
+    bench::run(opt, "AB02dq0", kInputs,
+        [&](size_t i) {
+            T.AB0.alpha = in[i].a;
+            T.AB0.beta  = in[i].b;
+            AB02dq0(&T, theta[i]);
+        },
+        [&](size_t i) { evict(i, (const void*)&AB02dq0); });
+
+    SinCos_t sc;
+    trig_sincos(theta[0], &sc);
+
+    bench::run(opt, "AB02dq0_sincos", kInputs,
+        [&](size_t i) {
+            T.AB0.alpha = in[i].a;
+            T.AB0.beta  = in[i].b;
+            AB02dq0_sincos(&T, &sc);
+        },
+        [&](size_t i) { evict(i, (const void*)&AB02dq0_sincos); });
+
+    bench::run(opt, "dq02AB0", kInputs,
+        [&](size_t i) {
+            T.dq0.d = in[i].a;
+            T.dq0.q = in[i].b;
+            dq02AB0(&T, theta[i]);
+        },
+        [&](size_t i) { evict(i, (const void*)&dq02AB0); });
+}
+
+void bench_trig(const bench::Options& opt, bench::Rng& rng)
+{
+    std::vector<float> theta = rng.vec(kInputs, -TWO_PI, TWO_PI);
+    SinCos_t sc;
+
+    const struct
+    {
+        const char* name;
+        void (*fn)(float32_t, SinCos_t*);
+    } backends[] = {
+        {"trig_sincos/libm",  trig_sincos_libm},
+        {"trig_sincos/poly",  trig_sincos_poly},
+        {"trig_sincos/table", trig_sincos_table},
+    };
+
+    for (const auto& b : backends) {
+        auto fn = b.fn;
+        bench::run(opt, b.name, kInputs,
+            [&](size_t i) { fn(theta[i], &sc); },
+            [&](size_t i) {
+                bench::flush(&sc, sizeof(sc));
+                bench::flush(&theta[i], sizeof(theta[i]));
+                bench::flush_code(fn);
+            });
+    }
+}
+
+void bench_foc(const bench::Options& opt, bench::Rng& rng)
+{
+    std::vector<AB>    in    = random_ab(rng, -1.0f, 1.0f);     // (ia, ib)
+    std::vector<float> theta = rng.vec(kInputs, 0.0f, TWO_PI);
+    const float id_ref = 0.0f, iq_ref = 0.5f;
+    float duty[3];
+
+    FOC_Obj_t foc;
+    foc_init(&foc, 2, SVPWM);
+    PID_Param_Init(&foc.pid_d, 0.5f, -0.5f, 0.05f, 0.5f, 50e-6f, 1e-3f, 1, 0.0f, 0, 0.2f);
+    PID_Param_Init(&foc.pid_q, 0.5f, -0.5f, 0.05f, 0.5f, 50e-6f, 1e-3f, 1, 0.0f, 0, 0.2f);
+
+    bench::run(opt, "foc_current_step", kInputs,
+        [&](size_t i) {
+            foc_current_step(&foc, in[i].a, in[i].b, 0.0f, theta[i], id_ref, iq_ref, duty);
+        },
+        [&](size_t i) {
+            bench::flush(&foc, sizeof(foc));
+            bench::flush(&in[i], sizeof(in[i]));
+            bench::flush(&theta[i], sizeof(theta[i]));
+            bench::flush_code(&foc_current_step);
+            bench::flush_code(&modulator_lut);
+            bench::flush_code(&trig_sincos);
+        });
+
+    // the same tick as separate blocks, the way the Qspice schematic wires it
+    Transform_Obj_t T = {};
+    PID_Obj_t pid_d = foc.pid_d, pid_q = foc.pid_q;
+    SVM_t svm = {};
+
+    bench::run(opt, "foc/separate kernels", kInputs,
+        [&](size_t i) {
+            T.abc.a = in[i].a;
+            T.abc.b = in[i].b;
+            abc2AB0(&T, 2);
+            AB02dq0(&T, theta[i]);
+            PID_Update(&pid_d, id_ref, T.dq0.d, 0.0f);
+            PID_Update(&pid_q, iq_ref, T.dq0.q, 0.0f);
+            T.dq0.d = pid_d.u;
+            T.dq0.q = pid_q.u;
+            dq02AB0(&T, theta[i]);
+            modulator(&svm, T.AB0.alpha, T.AB0.beta, SVPWM);
+        },
+        [&](size_t i) {
+            bench::flush(&T, sizeof(T));
+            bench::flush(&pid_d, sizeof(pid_d));
+            bench::flush(&pid_q, sizeof(pid_q));
+            bench::flush(&svm, sizeof(svm));
+            bench::flush(&in[i], sizeof(in[i]));
+            bench::flush(&theta[i], sizeof(theta[i]));
+            bench::flush_code(&abc2AB0);
+            bench::flush_code(&AB02dq0);
+            bench::flush_code(&PID_Update);
+            bench::flush_code(&dq02AB0);
+            bench::flush_code(&modulator);
+            bench::flush_code(&trig_sincos);
+        });
+}
+
+void bench_filters(const bench::Options& opt, bench::Rng& rng)
+{
+    std::vector<float> in = rng.vec(kInputs, -1.0f, 1.0f);
+    Lpf1st_Obj_t lpf;
+
+    lpf_1st_init(&lpf, 0, 0, 0.05f, 0.05f, 0.9f);
+
+    bench::run(opt, "lpf_1st_update", kInputs,
+        [&](size_t i) { lpf_1st_update(&lpf, in[i]); },
+        [&](size_t i) {
+            bench::flush(&lpf, sizeof(lpf));
+            bench::flush(&in[i], sizeof(in[i]));
+            bench::flush_code(&lpf_1st_update);
+        });
+
+    // two sections (low pass + resonance notch) per channel, 1 channel vs. the 6 of a dual-motor drive
+    constexpr uint16_t kCh = 6;
+    std::vector<float> multi = rng.vec(kInputs * kCh, -1.0f, 1.0f);
+    Biquad_Coef_t lp, notch;
+    biquad_design_lpf(&lp, 2000.0f, 0.7071f, 50e-6f);
+    biquad_design_notch(&notch, 600.0f, 2.0f, 50e-6f);
+
+    const struct
+    {
+        const char* name;
+        uint16_t    n_ch;
+        void (*fn)(Biquad_Obj_t* const, const float32_t*, float32_t*);
+    } variants[] = {
+        {"biquad_update/1ch", 1, biquad_update},
+        {"biquad_update/6ch", kCh, biquad_update},
+        {"biquad_update_scalar/1ch", 1, biquad_update_scalar},
+        {"biquad_update_scalar/6ch", kCh, biquad_update_scalar},
+    };
+    for (const auto& v : variants) {
+        Biquad_Obj_t bq;
+        float y[BIQUAD_MAX_CHANNELS];
+        biquad_init(&bq, v.n_ch, 2);
+        biquad_set_stage(&bq, 0, BIQUAD_ALL_CHANNELS, &lp);
+        biquad_set_stage(&bq, 1, BIQUAD_ALL_CHANNELS, &notch);
+        bench::run(opt, v.name, kInputs,
+            [&](size_t i) { v.fn(&bq, &multi[i * kCh], y); },
+            [&](size_t i) {
+                bench::flush(&bq, sizeof(bq));
+                bench::flush(&multi[i * kCh], kCh * sizeof(float));
+                bench::flush_code(v.fn);
+            });
+    }
+}
+
+void bench_decim(const bench::Options& opt, bench::Rng& rng)
+{
+    // one control period of a 6-channel, 8x oversampled ADC: 48 raw samples
+    constexpr uint16_t kCh = 6, kR = 8;
+    constexpr size_t kPeriods = kInputs / kR;
+    std::vector<uint16_t> raw(kInputs * kCh);
+    std::vector<float> raw_f(kInputs * kCh);
+    for (size_t i = 0; i < raw.size(); i++) {
+        raw[i] = (uint16_t)rng.uniform(1000.0f, 3000.0f);
+        raw_f[i] = (float)raw[i];
+    }
+
+    Decim_Cic_Obj_t cic;
+    float out[kCh];
+    decim_cic_init(&cic, kCh, kR, 2, 1);
+    bench::run(opt, "decim_cic_process/6ch R8 N2", kPeriods,
+        [&](size_t p) { decim_cic_process(&cic, &raw[p * kR * kCh], kR, out); },
+        [&](size_t p) {
+            bench::flush(&cic, sizeof(cic));
+            bench::flush(&raw[p * kR * kCh], kR * kCh * sizeof(uint16_t));
+            bench::flush_code(&decim_cic_process);
+        });
+
+    // the same period through lpf_1st_update(), one raw sample at a time
+    Lpf1st_Obj_t lpf[kCh];
+    for (auto& l : lpf) {
+        lpf_1st_init(&l, 0, 0, 0.05f, 0.05f, 0.9f);
+    }
+    bench::run(opt, "lpf_1st_update/6ch x8 raw", kPeriods,
+        [&](size_t p) {
+            const float* x = &raw_f[p * kR * kCh];
+            for (uint16_t f = 0; f < kR; f++) {
+                for (uint16_t c = 0; c < kCh; c++) {
+                    lpf_1st_update(&lpf[c], x[f * kCh + c]);
+                }
+            }
+        },
+        [&](size_t p) {
+            bench::flush(lpf, sizeof(lpf));
+            bench::flush(&raw_f[p * kR * kCh], kR * kCh * sizeof(float));
+            bench::flush_code(&lpf_1st_update);
+        });
+}
+
+void bench_adc_clarke(const bench::Options& opt, bench::Rng& rng)
+{
+    // 12-bit ADC counts of phases a and b around mid-scale
+    constexpr size_t kBlock = 64;      // frames per DMA block
+    constexpr size_t kBlocks = kInputs / kBlock;
+    const float gain[2] = {0.0125f, 0.0122f};
+    const float offset[2] = {2048.0f, 2051.5f};
+    std::vector<int16_t> counts(kInputs * 2);
+    for (auto& c : counts) {
+        c = (int16_t)rng.uniform(200.0f, 3900.0f);
+    }
+
+    AdcClarke_Obj_t fe;
+    adc_clarke_init(&fe, 2, gain, offset, 100.0f);
+    Transform_Obj_t T = {};
+
+    bench::run(opt, "adc_clarke/2-sensor", kInputs,
+        [&](size_t i) { adc_clarke(&fe, &counts[2 * i], &T.AB0); },
+        [&](size_t i) {
+            bench::flush(&fe, sizeof(fe));
+            bench::flush(&counts[2 * i], 2 * sizeof(int16_t));
+            bench::flush_code(&adc_clarke);
+        });
+
+    // the separate passes: counts to calibrated currents, then abc2AB0()
+    bench::run(opt, "scale+abc2AB0/2-sensor", kInputs,
+        [&](size_t i) {
+            T.abc.a = gain[0] * ((float)counts[2 * i] - offset[0]);
+            T.abc.b = gain[1] * ((float)counts[2 * i + 1] - offset[1]);
+            abc2AB0(&T, 2);
+        },
+        [&](size_t i) {
+            bench::flush(&T, sizeof(T));
+            bench::flush(&counts[2 * i], 2 * sizeof(int16_t));
+            bench::flush_code(&abc2AB0);
+        });
+
+    std::vector<float> alpha(kBlock), beta(kBlock);
+    bench::run(opt, "adc_clarke_batch/2-sensor x64", kBlocks,
+        [&](size_t b) { adc_clarke_batch(&fe, &counts[b * kBlock * 2], kBlock, alpha.data(), beta.data()); },
+        [&](size_t b) {
+            bench::flush(&fe, sizeof(fe));
+            bench::flush(&counts[b * kBlock * 2], kBlock * 2 * sizeof(int16_t));
+            bench::flush_code(&adc_clarke_batch);
+        });
+
+    bench::run(opt, "scale+abc2AB0/2-sensor x64", kBlocks,
+        [&](size_t b) {
+            const int16_t* x = &counts[b * kBlock * 2];
+            for (size_t f = 0; f < kBlock; f++) {
+                T.abc.a = gain[0] * ((float)x[2 * f] - offset[0]);
+                T.abc.b = gain[1] * ((float)x[2 * f + 1] - offset[1]);
+                abc2AB0(&T, 2);
+                alpha[f] = T.AB0.alpha;
+                beta[f] = T.AB0.beta;
+            }
+        },
+        [&](size_t b) {
+            bench::flush(&T, sizeof(T));
+            bench::flush(&counts[b * kBlock * 2], kBlock * 2 * sizeof(int16_t));
+            bench::flush_code(&abc2AB0);
+        });
+}
+
+void bench_pll(const bench::Options& opt, bench::Rng& rng)
+{
+    // noisy sin/cos encoder at 500 rad/s electrical
+    const float Ts = 50e-6f, w = 500.0f;
+    std::vector<AB> in(kInputs);    // (sin, cos)
+    for (size_t k = 0; k < kInputs; k++) {
+        float th = w * Ts * (float)k;
+        in[k].a = std::sin(th) + rng.uniform(-0.02f, 0.02f);
+        in[k].b = std::cos(th) + rng.uniform(-0.02f, 0.02f);
+    }
+
+    PLL_Obj_t pll;
+    pll_init(&pll, Ts, 400.0f, 40000.0f, 5000.0f, 300.0f);
+
+    bench::run(opt, "pll_update", kInputs,
+        [&](size_t i) { pll_update(&pll, in[i].a, in[i].b); },
+        [&](size_t i) {
+            bench::flush(&pll, sizeof(pll));
+            bench::flush(&in[i], sizeof(in[i]));
+            bench::flush_code(&pll_update);
+            bench::flush_code(&lpf_1st_update);
+            bench::flush_code(&trig_sincos);
+        });
+}
+
+void bench_smo(const bench::Options& opt, bench::Rng& rng)
+{
+    // steady-state PMSM at 628 rad/s electrical: v = R i + L di/dt + e
+    const float R = 0.5f, L = 1e-3f, psi = 0.01f, Ts = 50e-6f, w = 628.3f;
+    std::vector<float> va(kInputs), vb(kInputs), ia(kInputs), ib(kInputs);
+    for (size_t k = 0; k < kInputs; k++) {
+        float th = w * Ts * (float)k;
+        float ph = th + 1.7f;
+        ia[k] = 2.0f * std::cos(ph) + rng.uniform(-0.01f, 0.01f);
+        ib[k] = 2.0f * std::sin(ph) + rng.uniform(-0.01f, 0.01f);
+        va[k] = R * ia[k] - L * 2.0f * w * std::sin(ph) - psi * w * std::sin(th);
+        vb[k] = R * ib[k] + L * 2.0f * w * std::cos(ph) + psi * w * std::cos(th);
+    }
+
+    SMO_Obj_t smo;
+    smo_init(&smo, R, L, Ts, 10.0f, 0.05f, 1256.6f, 45.0f, 6370.0f, 5000.0f);
+
+    bench::run(opt, "smo_update", kInputs,
+        [&](size_t i) { smo_update(&smo, va[i], vb[i], ia[i], ib[i]); },
+        [&](size_t i) {
+            bench::flush(&smo, sizeof(smo));
+            bench::flush(&va[i], sizeof(float));
+            bench::flush(&vb[i], sizeof(float));
+            bench::flush(&ia[i], sizeof(float));
+            bench::flush(&ib[i], sizeof(float));
+            bench::flush_code(&smo_update);
+            bench::flush_code(&lpf_1st_update);
+            bench::flush_code(&trig_sincos);
+        });
+}
+
+void bench_telemetry(const bench::Options& opt, bench::Rng& rng)
+{
+    std::vector<float> in = rng.vec(kInputs, -1.0f, 1.0f);
+    std::vector<Telem_Record_t> buf(1024);
+    Telem_Ring_t ring;
+    Telem_Record_t rec = {};
+
+    telem_ring_init(&ring, buf.data(), (uint32_t)buf.size());
+
+    // the consumer is emulated by emptying the ring every half capacity, so no push is dropped
+    bench::run(opt, "telem_push", kInputs,
+        [&](size_t i) {
+            rec.tick = (uint32_t)i;
+            rec.pid_err = in[i];
+            telem_push(&ring, &rec);
+            if ((i & 511) == 0) {
+                ring.tail = ring.head;
+            }
+        },
+        [&](size_t i) {
+            bench::flush(&ring, sizeof(ring));
+            bench::flush(&ring.buf[ring.head & ring.mask], sizeof(Telem_Record_t));
+            bench::flush(&in[i], sizeof(in[i]));
+        });
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    bench::Options opt = bench::parse_args(argc, argv);
+    bench::Rng     rng;
+
+    if (!opt.csv) {
+        std::printf("counter: %.3f ticks/ns, %zu warm calls, %zu cold samples, biquad_update on %s\n\n",
+                    bench::ticks_per_ns(), opt.warm_calls, opt.cold_samples, biquad_isa());
+    }
+    bench::print_header(opt);
+
+    bench_svm(opt, rng);
+    bench_pid(opt, rng);
+    bench_transforms(opt, rng);
+    bench_trig(opt, rng);
+    bench_filters(opt, rng);
+    bench_decim(opt, rng);
+    bench_adc_clarke(opt, rng);
+    bench_foc(opt, rng);
+    bench_pll(opt, rng);
+    bench_smo(opt, rng);
+    bench_telemetry(opt, rng);
+
+    if (MC_INSTRUMENT && !opt.csv) {     // per-call cycles as the kernels recorded them
+        std::printf("\n");
+        mc_instr_report(std::printf);
+    }
+
+    return 0;
+}
@@ -0,0 +1,258 @@
+/**
+ * @file       footprint.cpp
+ * @date       Oct 2026
+ *
+ * @brief      Memory and cache footprint of the control objects before and after the hot/cold split
+ *
+ *      Two parts:
+ *        layout  bytes, alignment and the cache lines an object can span, for
+ *                the current objects and the layouts before the hot/cold
+ *                split (PID_Obj_t with Ts/Ti/Td/err_k1/uff, SVM_t with
+ *                interleaved 16-bit fields, FOC_Obj_t/SMO_Obj_t unaligned)
+ *        sweep   ns per drive of the d/q PI updates and the modulator outputs
+ *                of --drives drives visited in random order, the same code on
+ *                both layouts, so that the difference is the memory traffic
+ *      Times are medians of 7 sweeps.
+ *
+ *      Usage: footprint [--drives N]
+ *
+ *      Exit status: 0 when no object spans more cache lines than before, 1
+ *      otherwise, 2 on a usage error.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+#include "bench_common.hpp"
+#include "ctrl_common.h"
+#include "filters.h"
+#include "foc.h"
+#include "pid.h"
+#include "pid_q.h"
+#include "pll.h"
+#include "smo.h"
+#include "svm.h"
+#include "transforms.h"
+
+namespace {
+
+struct Options
+{
+    uint32_t    drives  = 262144;
+};
+
+// the layouts before the hot/cold split, field for field
+namespace legacy {
+
+struct PID
+{
+    float32_t   err, err_k1, ui, u, uff, err_aw;
+    float32_t   OutHiLim, OutLoLim, IntRateLim, Kp, Ts, Ti, Ki, Td, Kd, Kp_aw;
+};
+
+struct PIDq
+{
+    q_t         err, ui, u, uff, err_aw;
+    q_t         OutHiLim, OutLoLim, IntRateLim;
+    q_gain_t    Kp, Ki, Kd, Kp_aw;
+};
+
+struct SVM
+{
+    float32_t   UAB[2];
+    int16_t     sector;
+    float32_t   m[3];
+    int16_t     zs_shift;
+};
+
+struct FOC
+{
+    PID         pid_d, pid_q;
+    SVM         svm;
+    SVM_mode_t  mode;
+    int16_t     numSensors;
+    float32_t   id, iq;
+};
+
+struct PLL
+{
+    PID             pid;
+    Lpf1st_Obj_t    lpf_omega;
+    float32_t       Ts, err, omega, omega_f, theta_e;
+    SinCos_t        sc;
+};
+
+struct SMO
+{
+    float32_t       F, G, k_slide, phi_rec, i_est[2], z[2];
+    Lpf1st_Obj_t    lpf_e[2];
+    float32_t       wc_rec;
+    PLL             pll;
+    float32_t       e[2], omega, theta;
+};
+
+} // namespace legacy
+
+// most cache lines an object of `size` bytes spans at any address its alignment allows
+uint32_t lines(size_t size, size_t align)
+{
+    uint32_t worst = 0;
+    for (size_t off = 0; off < MC_CACHE_LINE; off += align) {
+        worst = std::max(worst, (uint32_t)((off + size - 1) / MC_CACHE_LINE + 1));
+    }
+    return worst;
+}
+
+struct Row
+{
+    const char* name;
+    size_t      size_old, align_old, size_new, align_new;
+};
+
+template <class Old, class New>
+Row row(const char* name)
+{
+    return {name, sizeof(Old), alignof(Old), sizeof(New), alignof(New)};
+}
+
+// PID_Update_Inline() on either layout
+template <class P>
+inline float32_t pi(P& s, float32_t ref, float32_t fb)
+{
+    float32_t err = ref - fb;
+    float32_t err_k1 = s.err;
+    float32_t up = s.Kp * err;
+    float32_t delta_ui = (s.Ki * (err + err_k1) / 2) + (s.Kp_aw * s.err_aw);
+    SATURATE(delta_ui, s.IntRateLim, -s.IntRateLim);
+    float32_t ui = s.ui + delta_ui;
+    SATURATE(ui, s.OutHiLim, s.OutLoLim);
+    s.ui = ui;
+    float32_t u = up + ui + s.Kd * (err - err_k1);
+    float32_t u_sat = u;
+    SATURATE(u_sat, s.OutHiLim, s.OutLoLim);
+    s.u = u_sat;
+    s.err_aw = u_sat - u;
+    s.err = err;
+    return u_sat;
+}
+
+// the state one current-loop tick reads and writes, the transforms left out
+template <class F>
+inline void tick(F& f, float32_t id, float32_t iq)
+{
+    float32_t vd = pi(f.pid_d, 0.0f, id);
+    float32_t vq = pi(f.pid_q, 0.5f, iq);
+    f.id = id;
+    f.iq = iq;
+    f.svm.UAB[0] = vd;
+    f.svm.UAB[1] = vq;
+    f.svm.m[0] = 0.5f + vd;
+    f.svm.m[1] = 0.5f - vq;
+    f.svm.m[2] = 0.5f + vq - vd;
+    f.svm.sector = (int16_t)(vd > vq);
+}
+
+// median ns per drive of a sweep over `drives` in the order of `order`
+template <class F>
+double sweep(uint32_t drives, const std::vector<uint32_t>& order)
+{
+    std::vector<F> all(drives);
+    bench::Rng rng(drives);
+    for (F& f : all) {
+        std::memset((void*)&f, 0, sizeof(f));
+        float lim = rng.uniform(0.3f, 0.8f);
+        f.pid_d.OutHiLim = f.pid_q.OutHiLim = lim;
+        f.pid_d.OutLoLim = f.pid_q.OutLoLim = -lim;
+        f.pid_d.IntRateLim = f.pid_q.IntRateLim = 0.05f;
+        f.pid_d.Kp = f.pid_q.Kp = rng.uniform(0.2f, 1.0f);
+        f.pid_d.Ki = f.pid_q.Ki = 1e-2f;
+        f.pid_d.Kp_aw = f.pid_q.Kp_aw = 0.3f;
+    }
+    const std::vector<float> id = rng.vec(drives, -0.2f, 0.2f);
+    const std::vector<float> iq = rng.vec(drives, -1.0f, 1.0f);
+
+    std::vector<double> t(7);
+    for (double& x : t) {
+        double t0 = bench::now_ns();
+        for (uint32_t k = 0; k < drives; k++) {
+            uint32_t i = order[k];
+            tick(all[i], id[i], iq[i]);
+        }
+        bench::clobber();
+        x = (bench::now_ns() - t0) / drives;
+    }
+    bench::keep(all[order[0]].svm.m[0]);
+    std::nth_element(t.begin(), t.begin() + t.size() / 2, t.end());
+    return t[t.size() / 2];
+}
+
+Options parse_args(int argc, char** argv)
+{
+    Options opt;
+    bool ok = true;
+    for (int i = 1; i < argc; i++) {
+        bool more = i + 1 < argc;
+        if (std::strcmp(argv[i], "--drives") == 0 && more) {
+            opt.drives = (uint32_t)std::atoi(argv[++i]);
+        }
+        else {
+            ok = false;
+        }
+    }
+    if (!ok || opt.drives < 64) {
+        std::fprintf(stderr, "usage: %s [--drives N (>= 64)]\n", argv[0]);
+        std::exit(2);
+    }
+    return opt;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opt = parse_args(argc, argv);
+    bool pass = true;
+
+    const Row rows[] = {
+        row<legacy::PID, PID_Obj_t>("PID_Obj_t"),
+        row<legacy::PIDq, PIDq_Obj_t>("PIDq_Obj_t"),
+        row<legacy::SVM, SVM_t>("SVM_t"),
+        row<legacy::FOC, FOC_Obj_t>("FOC_Obj_t"),
+        row<legacy::PLL, PLL_Obj_t>("PLL_Obj_t"),
+        row<legacy::SMO, SMO_Obj_t>("SMO_Obj_t"),
+        row<Transform_Obj_t, Transform_Obj_t>("Transform_Obj_t"),
+    };
+
+    std::printf("layout, %d-byte cache lines; lines: the most an object spans at any aligned address\n",
+                MC_CACHE_LINE);
+    std::printf("%-16s %8s %6s %6s   %8s %6s %6s\n", "", "before", "align", "lines", "now", "align", "lines");
+    for (const Row& r : rows) {
+        uint32_t l_old = lines(r.size_old, r.align_old), l_new = lines(r.size_new, r.align_new);
+        std::printf("%-16s %8zu %6zu %6u   %8zu %6zu %6u\n", r.name, r.size_old, r.align_old, l_old, r.size_new,
+                    r.align_new, l_new);
+        pass = pass && l_new <= l_old;
+    }
+    std::printf("PID_Cfg_t, the cold PID design values kept by the owner: %zu bytes\n", sizeof(PID_Cfg_t));
+
+    std::printf("\nsweep, d/q PI and modulator outputs per drive, drives in random order, ns per drive\n");
+    std::printf("%8s %12s %12s %12s %12s %9s\n", "drives", "KiB before", "KiB now", "ns before", "ns now",
+                "speedup");
+    for (uint32_t n = 64; n <= opt.drives; n *= 8) {
+        std::vector<uint32_t> order(n);
+        std::iota(order.begin(), order.end(), 0u);
+        bench::Rng rng(n);
+        for (uint32_t k = n - 1; k > 0; k--) {
+            std::swap(order[k], order[(uint32_t)rng.uniform(0.0f, (float)k + 0.999f)]);
+        }
+        double t_old = sweep<legacy::FOC>(n, order);
+        double t_new = sweep<FOC_Obj_t>(n, order);
+        std::printf("%8u %12.1f %12.1f %12.2f %12.2f %8.2fx\n", n, n * sizeof(legacy::FOC) / 1024.0,
+                    n * sizeof(FOC_Obj_t) / 1024.0, t_old, t_new, t_old / t_new);
+    }
+
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,177 @@
+/**
+ * @file       insn_count.hpp
+ *
+ * @brief      Retired user-space instructions per kernel call (Linux)
+ *
+ *      Uses the hardware instruction counter through perf_event_open() when the
+ *      kernel allows it. VMs and containers often do not, so the fallback runs the
+ *      calls in a forked child and single-steps it with ptrace(), which gives the
+ *      exact dynamic count at the price of speed. In both cases the cost of an
+ *      empty call sequence is measured the same way and subtracted.
+ */
+#ifndef INSN_COUNT_HPP_
+    #define INSN_COUNT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__linux__)
+    #include <csignal>
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/ptrace.h>
+    #include <sys/syscall.h>
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
+
+namespace bench {
+
+enum class InsnSource
+{
+    none,
+    perf,
+    ptrace,
+};
+
+inline const char* insn_source_name(InsnSource s)
+{
+    return s == InsnSource::perf ? "perf_event" : (s == InsnSource::ptrace ? "ptrace single-step" : "n/a");
+}
+
+#if defined(__linux__)
+
+namespace detail {
+
+inline int perf_open()
+{
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.size           = sizeof(attr);
+    attr.config         = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.disabled       = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    return (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+template <class Fn>
+inline uint64_t perf_count(int fd, Fn&& fn, size_t calls)
+{
+    uint64_t n = 0;
+    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    for (size_t i = 0; i < calls; i++) {
+        fn(i);
+        asm volatile("" ::: "memory");     // keeps the empty baseline loop
+    }
+    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    if (read(fd, &n, sizeof(n)) != (ssize_t)sizeof(n)) {
+        return 0;
+    }
+    return n;
+}
+
+// steps between the child's two SIGSTOPs; -1 when tracing is not permitted
+template <class Fn>
+inline int64_t ptrace_count(Fn&& fn, size_t calls)
+{
+    pid_t child = fork();
+    if (child == 0) {
+        if (ptrace(PTRACE_TRACEME, 0, nullptr, nullptr) != 0) {
+            _exit(1);
+        }
+        raise(SIGSTOP);
+        for (size_t i = 0; i < calls; i++) {
+            fn(i);
+            asm volatile("" ::: "memory");
+        }
+        raise(SIGSTOP);
+        _exit(0);
+    }
+    if (child < 0) {
+        return -1;
+    }
+
+    int status = 0;
+    waitpid(child, &status, 0);
+    if (!WIFSTOPPED(status)) {
+        return -1;
+    }
+
+    int64_t steps = 0;
+    for (;;) {
+        if (ptrace(PTRACE_SINGLESTEP, child, nullptr, nullptr) != 0) {
+            steps = -1;
+            break;
+        }
+        waitpid(child, &status, 0);
+        if (!WIFSTOPPED(status) || WSTOPSIG(status) == SIGSTOP) {
+            break;
+        }
+        steps++;
+    }
+    kill(child, SIGKILL);
+    waitpid(child, &status, 0);
+    return steps;
+}
+
+} // namespace detail
+
+/**
+ * @brief      Instructions per call of fn(i), i = 0..calls-1
+ *
+ * @param      fn      kernel invocation for input index i
+ * @param[in]  calls   number of calls averaged over; keep it small (~100) since
+ *                     the ptrace fallback takes a few microseconds per instruction
+ * @param[out] source  which counter was used
+ *
+ * @return     instructions per call, or -1 if no counter is available
+ */
+template <class Fn>
+inline double insns_per_call(Fn&& fn, size_t calls, InsnSource& source)
+{
+    auto empty = [](size_t) {};
+
+    for (size_t i = 0; i < calls; i++) {    // resolve lazy bindings, touch the data
+        fn(i);
+    }
+
+    int fd = detail::perf_open();
+    if (fd >= 0) {
+        uint64_t n  = detail::perf_count(fd, fn, calls);
+        uint64_t n0 = detail::perf_count(fd, empty, calls);
+        close(fd);
+        if (n > 0) {
+            source = InsnSource::perf;
+            return (double)(int64_t)(n - n0) / (double)calls;
+        }
+    }
+
+    int64_t s  = detail::ptrace_count(fn, calls);
+    int64_t s0 = detail::ptrace_count(empty, calls);
+    if (s >= 0 && s0 >= 0) {
+        source = InsnSource::ptrace;
+        return (double)(s - s0) / (double)calls;
+    }
+
+    source = InsnSource::none;
+    return -1;
+}
+
+#else
+
+template <class Fn>
+inline double insns_per_call(Fn&&, size_t, InsnSource& source)
+{
+    source = InsnSource::none;
+    return -1;
+}
+
+#endif
+
+} // namespace bench
+
+#endif // <-- !defined INSN_COUNT_HPP_
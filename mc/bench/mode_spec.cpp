@@ -0,0 +1,274 @@
+/**
+ * @file       mode_spec.cpp
+ *
+ * @brief      Run-time sensor count and SVM mode against the compile-time specializations
+ *
+ *      abc2AB0() against mc::clarke<2>/<3> (transforms.hpp) and modulator()
+ *      against mc::modulator<Mode> (svm.hpp), both sides one out-of-line call
+ *      per input on identical inputs. Reported per call: retired instructions
+ *      (see insn_count.hpp), warm ns, and whether the outputs matched bit for
+ *      bit over the whole input set. Before that, every zero-sequence rule with
+ *      every overmodulation rule is checked against modulator() (DPWM_ADAPTIVE
+ *      with every zs_shift), for mc::modulator<Mode> on the random inputs and
+ *      for modulator_lut() and modulator_batch() on a polar sweep: 0.1 degree
+ *      steps plus the sector boundaries (k*30 degrees, a few ulp either side),
+ *      magnitudes from zero through the hexagon side (1) and corners
+ *      (2/sqrt(3)) to 2.
+ *
+ *      Usage: mode_spec [--filter <substr>] [--calls N]
+ *
+ *      Exit status: 0 when every specialization is bit-exact, 1 otherwise.
+ */
+
+#include <cmath>
+#include <cstring>
+
+#include "bench_common.hpp"
+#include "insn_count.hpp"
+
+#include "svm.h"
+#include "svm.hpp"
+#include "transforms.h"
+#include "transforms.hpp"
+
+namespace {
+
+#if defined(_MSC_VER)
+    #define SPEC_NOINLINE           __declspec(noinline)
+#else
+    #define SPEC_NOINLINE           __attribute__((noinline))
+#endif
+
+constexpr size_t kInputs    = 16384;
+constexpr size_t kInsnCalls = 256;
+
+// the corners of the +-0.8 box reach past the hexagon side (at 1, corners at 2/sqrt(3))
+struct Inputs
+{
+    std::vector<float> a, b, c, alpha, beta;
+
+    explicit Inputs(bench::Rng& rng)
+        : a(rng.vec(kInputs, -1.0f, 1.0f)), b(rng.vec(kInputs, -1.0f, 1.0f)), c(rng.vec(kInputs, -1.0f, 1.0f)),
+          alpha(rng.vec(kInputs, -0.8f, 0.8f)), beta(rng.vec(kInputs, -0.8f, 0.8f))
+    {
+    }
+};
+
+template <int N>
+SPEC_NOINLINE void clarke_spec(Transform_Obj_t* T)
+{
+    mc::clarke<N>(*T);
+}
+
+template <int N>
+bool clarke_exact(const Inputs& in)
+{
+    for (size_t i = 0; i < kInputs; i++) {
+        Transform_Obj_t x = {}, y = {};
+        x.abc = y.abc = ABC_t{in.a[i], in.b[i], in.c[i]};
+        abc2AB0(&x, N);
+        clarke_spec<N>(&y);
+        if (std::memcmp(&x, &y, sizeof(x)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool same(const SVM_t& x, const SVM_t& y)
+{
+    return x.sector == y.sector && std::memcmp(x.m, y.m, sizeof(x.m)) == 0 &&
+           std::memcmp(x.UAB, y.UAB, sizeof(x.UAB)) == 0;
+}
+
+template <SVM_mode_t Mode>
+bool modulator_exact(const Inputs& in)
+{
+    for (int16_t shift = -1; shift <= 1; shift++) {
+        SVM_t x = {}, y = {};
+        x.zs_shift = y.zs_shift = shift;
+        for (size_t i = 0; i < kInputs; i++) {
+            modulator(&x, in.alpha[i], in.beta[i], Mode);
+            mc::modulator<Mode>(y, in.alpha[i], in.beta[i]);
+            if (!same(x, y)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <SVM_mode_t Zs>
+bool row_exact(const Inputs& in)
+{
+    return modulator_exact<SVM_MODE(Zs, SVM_OVM_CLAMP)>(in) && modulator_exact<SVM_MODE(Zs, SVM_OVM_MPE)>(in) &&
+           modulator_exact<SVM_MODE(Zs, SVM_OVM_MME)>(in);
+}
+
+bool all_modes_exact(const Inputs& in)
+{
+    return row_exact<SVPWM>(in) && row_exact<DMPWM3>(in) && row_exact<DPWMMIN>(in) && row_exact<DPWMMAX>(in) &&
+           row_exact<DPWM0>(in) && row_exact<DPWM1>(in) && row_exact<DPWM2>(in) && row_exact<DPWM_ADAPTIVE>(in);
+}
+
+constexpr SVM_mode_t kZs[]  = {SVPWM, DMPWM3, DPWMMIN, DPWMMAX, DPWM0, DPWM1, DPWM2, DPWM_ADAPTIVE};
+constexpr SVM_mode_t kOvm[] = {SVM_OVM_CLAMP, SVM_OVM_MPE, SVM_OVM_MME};
+
+// angle x magnitude; the hexagon side is at 1, its corners at 2/sqrt(3)
+struct Sweep
+{
+    std::vector<float> alpha, beta;
+
+    Sweep()
+    {
+        static const float mag[] = {0.0f, 1e-6f, 0.1f, 0.4f, 0.7f, 0.9f, 0.99f, 1.0f, 1.01f, 1.05f, 1.1f,
+                                    1.1547f, 1.16f, 1.25f, 1.4f, 2.0f};
+        std::vector<double> ang;
+        for (int i = 0; i < 3600; i++) {
+            ang.push_back(i * (2.0 * M_PI / 3600));
+        }
+        for (int k = 0; k < 12; k++) {
+            float th = (float)(k * (M_PI / 6));
+            for (int u = -4; u <= 4; u++) {
+                float t = th;
+                for (int n = 0; n < std::abs(u); n++) {
+                    t = std::nextafter(t, u < 0 ? -10.0f : 10.0f);
+                }
+                ang.push_back(t);
+            }
+        }
+        for (float m : mag) {
+            for (double t : ang) {
+                alpha.push_back((float)(m * std::cos(t)));
+                beta.push_back((float)(m * std::sin(t)));
+            }
+        }
+    }
+};
+
+// modulator_lut() and modulator_batch() against modulator(), every mode; prints the first mismatch
+bool lut_exact(const Sweep& sw)
+{
+    const uint32_t     n = (uint32_t)sw.alpha.size();
+    std::vector<float> ma(n), mb(n), mc(n);
+    std::vector<int16_t> sector(n);
+    bool               exact = true;
+
+    for (SVM_mode_t z : kZs) {
+        for (SVM_mode_t o : kOvm) {
+            const SVM_mode_t mode = SVM_MODE(z, o);
+            for (int16_t shift = -1; shift <= 1; shift++) {
+                SVM_t x = {}, y = {};
+                x.zs_shift = y.zs_shift = shift;
+                for (uint32_t i = 0; i < n && exact; i++) {
+                    modulator(&x, sw.alpha[i], sw.beta[i], mode);
+                    modulator_lut(&y, sw.alpha[i], sw.beta[i], mode);
+                    if (!same(x, y)) {
+                        std::printf("modulator_lut mode 0x%02x zs_shift %d at (%.9g, %.9g): sector %d/%d\n",
+                                    (unsigned)mode, shift, sw.alpha[i], sw.beta[i], x.sector, y.sector);
+                        exact = false;
+                    }
+                }
+            }
+
+            // no SVM_t in the batch: DPWM_ADAPTIVE modulates as DPWM1 (zs_shift 0)
+            modulator_batch(sw.alpha.data(), sw.beta.data(), n, mode, ma.data(), mb.data(), mc.data(), sector.data());
+            SVM_t x = {};
+            for (uint32_t i = 0; i < n && exact; i++) {
+                modulator(&x, sw.alpha[i], sw.beta[i], mode);
+                const float m[3] = {ma[i], mb[i], mc[i]};
+                if (x.sector != sector[i] || std::memcmp(x.m, m, sizeof(m)) != 0) {
+                    std::printf("modulator_batch (%s) mode 0x%02x at (%.9g, %.9g): sector %d/%d\n",
+                                modulator_batch_isa(), (unsigned)mode, sw.alpha[i], sw.beta[i], x.sector, sector[i]);
+                    exact = false;
+                }
+            }
+        }
+    }
+    return exact;
+}
+
+double insn_generic = 0;
+
+// one line of the table; the first variant of a config is the run-time one
+template <class Fn>
+void report(const bench::Options& opt, const char* config, const char* kernel, bool runtime, bool exact, Fn&& call,
+            bench::InsnSource& source)
+{
+    double insn = bench::insns_per_call(call, kInsnCalls, source);
+    double ns, cyc;
+    bench::measure_warm(call, kInputs, opt.warm_calls, ns, cyc);
+
+    if (runtime) {
+        insn_generic = insn;
+        std::printf("%-18s %-22s %10.1f %10.2f\n", config, kernel, insn, ns);
+    }
+    else {
+        std::printf("%-18s %-22s %10.1f %10.2f %10s   (%+.0f%% insn)\n", "", kernel, insn, ns, exact ? "yes" : "NO",
+                    insn_generic > 0 ? 100.0 * (insn / insn_generic - 1.0) : 0.0);
+    }
+}
+
+template <int N>
+bool run_clarke(const bench::Options& opt, const Inputs& in, const char* config, const char* kernel,
+                bench::InsnSource& source)
+{
+    if (!bench::selected(opt, config)) {
+        return true;
+    }
+    bool exact = clarke_exact<N>(in);
+    Transform_Obj_t T = {};
+    auto load = [&](size_t i) { T.abc = ABC_t{in.a[i], in.b[i], in.c[i]}; };
+
+    report(opt, config, "abc2AB0", true, exact, [&](size_t i) { load(i); abc2AB0(&T, N); }, source);
+    report(opt, config, kernel, false, exact, [&](size_t i) { load(i); clarke_spec<N>(&T); }, source);
+    return exact;
+}
+
+template <SVM_mode_t Mode>
+bool run_modulator(const bench::Options& opt, const Inputs& in, const char* config, const char* kernel,
+                   bench::InsnSource& source)
+{
+    if (!bench::selected(opt, config)) {
+        return true;
+    }
+    bool exact = modulator_exact<Mode>(in);
+    SVM_t svm = {};
+
+    report(opt, config, "modulator", true, exact,
+           [&](size_t i) { modulator(&svm, in.alpha[i], in.beta[i], Mode); }, source);
+    report(opt, config, kernel, false, exact,
+           [&](size_t i) { mc::modulator<Mode>(svm, in.alpha[i], in.beta[i]); }, source);
+    return exact;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    bench::Options opt = bench::parse_args(argc, argv);
+    bench::Rng     rng;
+    Inputs         in(rng);
+    bool           pass = all_modes_exact(in);
+
+    std::printf("modulator<Mode>, 8 zero-sequence x 3 overmodulation rules against modulator(): %s\n",
+                pass ? "bit-exact" : "MISMATCH");
+    Sweep sweep;
+    bool  lut = lut_exact(sweep);
+    std::printf("modulator_lut(), modulator_batch() (%s), same rules, %zu angle x magnitude points: %s\n\n",
+                modulator_batch_isa(), sweep.alpha.size(), lut ? "bit-exact" : "MISMATCH");
+    pass = pass && lut;
+
+    bench::InsnSource source = bench::InsnSource::none;
+
+    std::printf("%-18s %-22s %10s %10s %10s\n", "config", "kernel", "insn/call", "warm ns", "bit-exact");
+    pass = run_clarke<2>(opt, in, "clarke, 2 sensors", "clarke<2>", source) && pass;
+    pass = run_clarke<3>(opt, in, "clarke, 3 sensors", "clarke<3>", source) && pass;
+    pass = run_modulator<SVPWM>(opt, in, "SVPWM", "modulator<SVPWM>", source) && pass;
+    pass = run_modulator<DMPWM3>(opt, in, "DMPWM3", "modulator<DMPWM3>", source) && pass;
+    pass = run_modulator<SVM_MODE(DPWM1, SVM_OVM_MME)>(opt, in, "DPWM1 | MME", "modulator<DPWM1 | MME>", source) &&
+           pass;
+    std::printf("\ninstruction counter: %s\n", bench::insn_source_name(source));
+
+    return pass ? 0 : 1;
+}
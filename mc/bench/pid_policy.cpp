@@ -0,0 +1,119 @@
+/**
+ * @file       pid_policy.cpp
+ *
+ * @brief      Generic PID_Update() against the compile-time specialized controllers
+ *
+ *      For each configuration the generic C update and the Pid<Policy> version run
+ *      on identical states and inputs. Reported per call: retired instructions
+ *      (see insn_count.hpp), warm ns, and whether the outputs matched bit for bit
+ *      over the whole input set.
+ *
+ *      Usage: pid_policy [--filter <substr>] [--calls N]
+ */
+
+#include <cstring>
+
+#include "bench_common.hpp"
+#include "insn_count.hpp"
+
+#include "pid.h"
+#include "pid.hpp"
+
+namespace {
+
+constexpr size_t kInputs    = 16384;
+constexpr size_t kInsnCalls = 256;
+
+using UpdateFn = void (*)(PID_Obj_t* const, float32_t, float32_t, float32_t);
+
+struct Config
+{
+    const char* name;
+    int16_t     Ki_enable;
+    int16_t     Kd_enable;
+    float32_t   Kp_aw;
+    UpdateFn    specialized;
+};
+
+void init(PID_Obj_t& pid, const Config& c)
+{
+    PID_Data_Init(&pid, 0, 0, 0, 0, 0);
+    PID_Param_Init(&pid, 0.5f, -0.5f, 0.05f, 0.5f, 50e-6f, 1e-3f, c.Ki_enable, 1e-5f, c.Kd_enable, c.Kp_aw);
+}
+
+bool same_outputs(const Config& c, const std::vector<float>& ref, const std::vector<float>& fb)
+{
+    PID_Obj_t a, b;
+    init(a, c);
+    init(b, c);
+    for (size_t i = 0; i < kInputs; i++) {
+        PID_Update(&a, ref[i], fb[i], 0.0f);
+        c.specialized(&b, ref[i], fb[i], 0.0f);
+        if (std::memcmp(&a.u, &b.u, sizeof(a.u)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    bench::Options opt = bench::parse_args(argc, argv);
+    bench::Rng     rng;
+
+    std::vector<float> ref = rng.vec(kInputs, -1.0f, 1.0f);
+    std::vector<float> fb  = rng.vec(kInputs, -1.0f, 1.0f);
+
+    const Config configs[] = {
+        {"P",                 0, 0, 0.0f, PID_Update_P},
+        {"PI, current loop",  1, 0, 0.2f, PID_Update_PI},
+        {"PID",               1, 1, 0.2f, PID_Update_PID},
+    };
+
+    bench::InsnSource source = bench::InsnSource::none;
+
+    std::printf("%-18s %-16s %10s %10s %10s\n", "config", "update", "insn/call", "warm ns", "bit-exact");
+    for (const Config& c : configs) {
+        if (!bench::selected(opt, c.name)) {
+            continue;
+        }
+
+        const struct
+        {
+            const char* name;
+            UpdateFn    fn;
+        } variants[] = {
+            {"PID_Update", PID_Update},
+            {"specialized", c.specialized},
+        };
+
+        bool exact = same_outputs(c, ref, fb);
+        double insn_generic = 0;
+
+        for (const auto& v : variants) {
+            PID_Obj_t pid;
+            UpdateFn  fn = v.fn;
+            init(pid, c);
+
+            auto call = [&](size_t i) { fn(&pid, ref[i], fb[i], 0.0f); };
+
+            double insn = bench::insns_per_call(call, kInsnCalls, source);
+            double ns, cyc;
+            bench::measure_warm(call, kInputs, opt.warm_calls, ns, cyc);
+
+            if (fn == PID_Update) {
+                insn_generic = insn;
+                std::printf("%-18s %-16s %10.1f %10.2f\n", c.name, v.name, insn, ns);
+            }
+            else {
+                std::printf("%-18s %-16s %10.1f %10.2f %10s   (%+.0f%% insn)\n", "", v.name, insn, ns,
+                            exact ? "yes" : "NO", insn_generic > 0 ? 100.0 * (insn / insn_generic - 1.0) : 0.0);
+            }
+        }
+    }
+    std::printf("\ninstruction counter: %s\n", bench::insn_source_name(source));
+
+    return 0;
+}
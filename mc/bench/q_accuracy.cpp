@@ -0,0 +1,281 @@
+/**
+ * @file       q_accuracy.cpp
+ *
+ * @brief      Error of the fixed-point kernels against the float reference
+ *
+ *      Every *_q kernel is fed random per-unit inputs; the float kernel gets the
+ *      same inputs converted back from q_t, so input quantization is not counted.
+ *      The stateful kernels (PID, LPF) run as one long sequence, their error
+ *      includes whatever the state accumulates; the PI with a small discrete Ki
+ *      (1e-6..1e-3) is compared with the float PI of the unquantized gains, so
+ *      it also shows what the gain format loses. Reported per output: worst and RMS
+ *      absolute error, and the worst error in LSBs of the compiled Q format. In Q31
+ *      the float reference itself (24-bit mantissa) sets most of the figures.
+ *
+ *      Usage: q_accuracy [samples]
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "bench_common.hpp"
+
+#include "ctrl_common.h"
+#include "filters.h"
+#include "filters_q.h"
+#include "fixedpoint.h"
+#include "pid.h"
+#include "pid_q.h"
+#include "svm.h"
+#include "svm_q.h"
+#include "transforms.h"
+#include "transforms_q.h"
+#include "trig.h"
+
+namespace {
+
+const double kLsb = 1.0 / Q_SCALE;
+
+struct Err
+{
+    double max = 0;
+    double sum_sq = 0;
+    long   n = 0;
+
+    void add(double ref, q_t q)
+    {
+        double e = std::fabs((double)q_to_float(q) - ref);
+        max = e > max ? e : max;
+        sum_sq += e * e;
+        n++;
+    }
+};
+
+void report(const char* kernel, const Err& e)
+{
+    std::printf("%-28s %12.3e %12.3e %10.1f %10ld\n", kernel, e.max,
+                e.n ? std::sqrt(e.sum_sq / (double)e.n) : 0.0, e.max / kLsb, e.n);
+}
+
+// random per-unit q_t and the float it stands for
+q_t rand_q(bench::Rng& rng, float lo, float hi, float& f)
+{
+    q_t q = q_from_float(rng.uniform(lo, hi));
+    f = q_to_float(q);
+    return q;
+}
+
+void check_trig(long samples, bench::Rng& rng)
+{
+    Err es, ec;
+    for (long k = 0; k < samples; k++) {
+        float      t;
+        q_t        theta = rand_q(rng, -1.0f, 1.0f, t);
+        SinCos_q_t sc;
+
+        q_sincos(theta, &sc);
+        es.add(std::sin((double)t * 3.141592653589793), sc.sin);
+        ec.add(std::cos((double)t * 3.141592653589793), sc.cos);
+    }
+    report("q_sincos/sin", es);
+    report("q_sincos/cos", ec);
+}
+
+void check_transforms(long samples, bench::Rng& rng)
+{
+    Err c2_alpha, c2_beta, c3_alpha, c3_beta, c3_zero, ic_a, ic_b, ic_c, p_d, p_q, ip_alpha, ip_beta;
+    Transform_Obj_t  T = {};
+    Transformq_Obj_t Tq = {};
+
+    for (long k = 0; k < samples; k++) {
+        float t;
+        q_t   theta = rand_q(rng, -1.0f, 1.0f, t);
+
+        // 2 sensors, a + b kept in range so that c fits
+        Tq.abc.a = rand_q(rng, -0.5f, 0.5f, T.abc.a);
+        Tq.abc.b = rand_q(rng, -0.5f, 0.5f, T.abc.b);
+        abc2AB0(&T, 2);
+        abc2AB0_q(&Tq, 2);
+        c2_alpha.add(T.AB0.alpha, Tq.AB0.alpha);
+        c2_beta.add(T.AB0.beta, Tq.AB0.beta);
+
+        Tq.abc.a = rand_q(rng, -0.6f, 0.6f, T.abc.a);
+        Tq.abc.b = rand_q(rng, -0.6f, 0.6f, T.abc.b);
+        Tq.abc.c = rand_q(rng, -0.6f, 0.6f, T.abc.c);
+        abc2AB0(&T, 3);
+        abc2AB0_q(&Tq, 3);
+        c3_alpha.add(T.AB0.alpha, Tq.AB0.alpha);
+        c3_beta.add(T.AB0.beta, Tq.AB0.beta);
+        c3_zero.add(T.AB0.zero_AB, Tq.AB0.zero_AB);
+
+        Tq.AB0.alpha = rand_q(rng, -0.5f, 0.5f, T.AB0.alpha);
+        Tq.AB0.beta = rand_q(rng, -0.5f, 0.5f, T.AB0.beta);
+        Tq.AB0.zero_AB = rand_q(rng, -0.1f, 0.1f, T.AB0.zero_AB);
+        AB02abc(&T);
+        AB02abc_q(&Tq);
+        ic_a.add(T.abc.a, Tq.abc.a);
+        ic_b.add(T.abc.b, Tq.abc.b);
+        ic_c.add(T.abc.c, Tq.abc.c);
+
+        Tq.AB0.alpha = rand_q(rng, -0.7f, 0.7f, T.AB0.alpha);
+        Tq.AB0.beta = rand_q(rng, -0.7f, 0.7f, T.AB0.beta);
+        AB02dq0(&T, t * PI);
+        AB02dq0_q(&Tq, theta);
+        p_d.add(T.dq0.d, Tq.dq0.d);
+        p_q.add(T.dq0.q, Tq.dq0.q);
+
+        Tq.dq0.d = rand_q(rng, -0.7f, 0.7f, T.dq0.d);
+        Tq.dq0.q = rand_q(rng, -0.7f, 0.7f, T.dq0.q);
+        dq02AB0(&T, t * PI);
+        dq02AB0_q(&Tq, theta);
+        ip_alpha.add(T.AB0.alpha, Tq.AB0.alpha);
+        ip_beta.add(T.AB0.beta, Tq.AB0.beta);
+    }
+    report("abc2AB0_q/2/alpha", c2_alpha);
+    report("abc2AB0_q/2/beta", c2_beta);
+    report("abc2AB0_q/3/alpha", c3_alpha);
+    report("abc2AB0_q/3/beta", c3_beta);
+    report("abc2AB0_q/3/zero", c3_zero);
+    report("AB02abc_q/a", ic_a);
+    report("AB02abc_q/b", ic_b);
+    report("AB02abc_q/c", ic_c);
+    report("AB02dq0_q/d", p_d);
+    report("AB02dq0_q/q", p_q);
+    report("dq02AB0_q/alpha", ip_alpha);
+    report("dq02AB0_q/beta", ip_beta);
+}
+
+void check_lpf(long samples, bench::Rng& rng)
+{
+    Lpf1st_Obj_t  lpf;
+    Lpf1stq_Obj_t lpf_q;
+    Err           e;
+
+    lpf_1st_init(&lpf, 0, 0, 0.05f, 0.05f, 0.9f);
+    lpf_1st_init_q(&lpf_q, 0, 0, 0.05f, 0.05f, 0.9f);
+
+    for (long k = 0; k < samples; k++) {
+        float u;
+        q_t   u_q = rand_q(rng, -0.9f, 0.9f, u);
+
+        lpf_1st_update(&lpf, u);
+        lpf_1st_update_q(&lpf_q, u_q);
+        e.add(lpf.y, lpf_q.y);
+    }
+    report("lpf_1st_update_q", e);
+}
+
+void check_pid(long samples, bench::Rng& rng)
+{
+    PID_Obj_t  pid;
+    PIDq_Obj_t pid_q;
+    Err        e;
+
+    PID_Data_Init(&pid, 0, 0, 0, 0, 0);
+    PID_Data_Init_q(&pid_q, 0, 0, 0, 0, 0);
+    PID_Param_Init(&pid, 0.9f, -0.9f, 0.05f, 2.5f, 50e-6f, 1e-3f, 1, 1e-6f, 1, 0.2f);
+    PID_Param_Init_q(&pid_q, 0.9f, -0.9f, 0.05f, 2.5f, 50e-6f, 1e-3f, 1, 1e-6f, 1, 0.2f);
+
+    // the float controller gets the quantized gains so only the arithmetic differs
+    pid.Kp = std::ldexp(q_to_float(pid_q.Kp.m), pid_q.Kp.e);
+    pid.Ki = std::ldexp(q_to_float(pid_q.Ki.m), pid_q.Ki.e);
+    pid.Kd = std::ldexp(q_to_float(pid_q.Kd.m), pid_q.Kd.e);
+    pid.Kp_aw = std::ldexp(q_to_float(pid_q.Kp_aw.m), pid_q.Kp_aw.e);
+
+    for (long k = 0; k < samples; k++) {
+        float ref, fb;
+        q_t   ref_q = rand_q(rng, -0.2f, 0.2f, ref);
+        q_t   fb_q = rand_q(rng, -0.2f, 0.2f, fb);
+
+        PID_Update(&pid, ref, fb, 0);
+        PID_Update_q(&pid_q, ref_q, fb_q, 0);
+        e.add(pid.u, pid_q.u);
+    }
+    report("PID_Update_q/u", e);
+}
+
+// PI with a small discrete Ki = Kp*Ts/Ti, against the float PI with the unquantized
+// gains: the integral of a positive error over the samples that take it to ~0.5
+void check_pid_ki(float32_t Ki, bench::Rng& rng)
+{
+    const float32_t Kp = 0.5f, Ts = 50e-6f, Ti = Kp * Ts / Ki;
+    PID_Obj_t  pid;
+    PIDq_Obj_t pid_q;
+    Err        e;
+
+    PID_Data_Init(&pid, 0, 0, 0, 0, 0);
+    PID_Data_Init_q(&pid_q, 0, 0, 0, 0, 0);
+    PID_Param_Init(&pid, 0.9f, -0.9f, 0.05f, Kp, Ts, Ti, 1, 0, 0, 1.0f);
+    PID_Param_Init_q(&pid_q, 0.9f, -0.9f, 0.05f, Kp, Ts, Ti, 1, 0, 0, 1.0f);
+
+    const long samples = (long)(10.0f / Ki);
+    for (long k = 0; k < samples; k++) {
+        float ref, fb;
+        q_t   ref_q = rand_q(rng, 0.0f, 0.1f, ref);
+        q_t   fb_q = rand_q(rng, -0.01f, 0.01f, fb);
+
+        PID_Update(&pid, ref, fb, 0);
+        PID_Update_q(&pid_q, ref_q, fb_q, 0);
+        e.add(pid.ui, pid_q.ui);
+    }
+    char name[32];
+    std::snprintf(name, sizeof(name), "PID_Update_q/ui Ki=%.1e", (double)Ki);
+    report(name, e);
+}
+
+void check_svm(long samples, bench::Rng& rng, SVM_mode_t mode, const char* name, float range = 0.7f)
+{
+    SVM_t  svm = {};
+    SVMq_t svm_q;
+    Err    e;
+    long   sector_mismatch = 0;
+
+    for (long k = 0; k < samples; k++) {
+        float ua, ub;
+        q_t   ua_q = rand_q(rng, -range, range, ua);
+        q_t   ub_q = rand_q(rng, -range, range, ub);
+
+        modulator(&svm, ua, ub, mode);
+        modulator_q(&svm_q, ua_q, ub_q, mode);
+
+        // a sector flip right on a boundary is a legitimate rounding outcome, and
+        // DMPWM changes its clamped phase there, so those samples are counted apart
+        if (svm.sector != svm_q.sector) {
+            sector_mismatch++;
+            continue;
+        }
+        e.add(svm.m[0], svm_q.m[0]);
+        e.add(svm.m[1], svm_q.m[1]);
+        e.add(svm.m[2], svm_q.m[2]);
+    }
+    report(name, e);
+    std::printf("%-28s %ld of %ld\n", "  sector mismatches", sector_mismatch, samples);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    long       samples = argc > 1 ? std::atol(argv[1]) : 1000000L;
+    bench::Rng rng;
+
+    std::printf("Q%d, 1 LSB = %.3e, %ld samples per kernel\n\n", MC_Q_BITS, kLsb, samples);
+    std::printf("%-28s %12s %12s %10s %10s\n", "kernel/output", "max |err|", "rms err", "max LSB", "n");
+
+    check_trig(samples, rng);
+    check_transforms(samples, rng);
+    check_lpf(samples, rng);
+    check_pid(samples, rng);
+    for (float32_t Ki : {1e-6f, 1e-5f, 2.5e-4f, 1e-3f}) {
+        check_pid_ki(Ki, rng);
+    }
+    check_svm(samples, rng, SVPWM, "modulator_q/SVPWM");
+    check_svm(samples, rng, DMPWM3, "modulator_q/DMPWM3");
+    check_svm(samples, rng, DPWM1, "modulator_q/DPWM1");
+    // the overmodulation rules, with the corners of the range outside the hexagon
+    check_svm(samples, rng, SVM_MODE(SVPWM, SVM_OVM_MPE), "modulator_q/SVPWM+MPE", 0.8f);
+    check_svm(samples, rng, SVM_MODE(DPWM1, SVM_OVM_MME), "modulator_q/DPWM1+MME", 0.8f);
+
+    return 0;
+}
@@ -0,0 +1,324 @@
+/**
+ * @file       sched_emu.cpp
+ * @date       Oct 2026
+ *
+ * @brief      Host emulation of the multi-rate schedule of a FOC drive (task_sched.h)
+ *
+ *      The task table of a 20 kHz drive, each task calling the library kernels:
+ *        current    every tick   foc_current_step()
+ *        observer   every 2      pll_update() on the back-EMF angle
+ *        filters    every 4      biquad_update(), 8 channels x 2 stages
+ *        speed      every 10     lpf_1st_update() and PID_Update(), sets iq_ref
+ *        position   every 40     PID_Update(), sets the speed reference
+ *      The budget of a task is the 99th percentile of its own run time,
+ *      measured first. The table is then run twice through sched_tick(), once
+ *      with every phase 0 (all loops fire in the same PWM period) and once with
+ *      the phases of sched_spread(), and for each schedule it reports:
+ *        static     the summed budgets per tick over the hyperperiod (no
+ *                   counter, sched_tick() charges the budgets): peak and mean
+ *        measured   the timed ticks: mean, the median of the busiest tick of
+ *                   the hyperperiod, the worst single tick and where it fell
+ *                   (on a host mostly an interrupt, not the schedule)
+ *      --profile prints the median measured load of every tick of the
+ *      hyperperiod.
+ *      Counter ticks are those of bench_common.hpp (TSC on x86).
+ *
+ *      Usage: sched_emu [--ticks N] [--Ts s] [--profile]
+ *
+ *      Exit status: 0 when the spread schedule lowers the static peak, 1
+ *      otherwise, 2 on a usage or table error.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "bench_common.hpp"
+#include "ctrl_common.h"
+#include "filters.h"
+#include "foc.h"
+#include "pid.h"
+#include "pll.h"
+#include "task_sched.h"
+
+namespace {
+
+struct Options
+{
+    uint32_t    ticks   = 200000;
+    double      Ts      = 50e-6;
+    bool        profile = false;
+};
+
+// the drive: state shared by the tasks, signals from a slow synthetic motion
+struct Drive
+{
+    FOC_Obj_t       foc;
+    PLL_Obj_t       pll;
+    Biquad_Obj_t    bq;
+    Lpf1st_Obj_t    lpf_speed;
+    PID_Obj_t       pid_speed;
+    PID_Obj_t       pid_pos;
+    float32_t       Ts;
+    float32_t       theta_e = 0;
+    float32_t       omega = 200.0f;
+    float32_t       pos = 0;
+    float32_t       pos_ref = 10.0f;
+    float32_t       omega_ref = 0;
+    float32_t       iq_ref = 0;
+    float32_t       duty[3];
+    float32_t       meas[BIQUAD_MAX_CHANNELS];
+};
+
+void task_current(void* ctx)
+{
+    Drive* d = static_cast<Drive*>(ctx);
+    d->theta_e += d->omega * d->Ts;
+    if (d->theta_e >= TWO_PI) {
+        d->theta_e -= TWO_PI;
+    }
+    float32_t ia = std::cos(d->theta_e), ib = std::cos(d->theta_e - TWO_PI_THIRD);
+    foc_current_step(&d->foc, ia, ib, -ia - ib, d->theta_e, 0, d->iq_ref, d->duty);
+}
+
+void task_observer(void* ctx)
+{
+    Drive* d = static_cast<Drive*>(ctx);
+    pll_update(&d->pll, -std::sin(d->theta_e), std::cos(d->theta_e));
+}
+
+void task_filters(void* ctx)
+{
+    Drive* d = static_cast<Drive*>(ctx);
+    for (int k = 0; k < BIQUAD_MAX_CHANNELS; k++) {
+        d->meas[k] = d->duty[k % 3];
+    }
+    biquad_update(&d->bq, d->meas, d->meas);
+}
+
+void task_speed(void* ctx)
+{
+    Drive* d = static_cast<Drive*>(ctx);
+    lpf_1st_update(&d->lpf_speed, d->pll.omega_f);
+    PID_Update(&d->pid_speed, d->omega_ref, d->lpf_speed.y, 0);
+    d->iq_ref = d->pid_speed.u;
+}
+
+void task_position(void* ctx)
+{
+    Drive* d = static_cast<Drive*>(ctx);
+    d->pos += d->omega * d->Ts * 40;
+    PID_Update(&d->pid_pos, d->pos_ref, d->pos, 0);
+    d->omega_ref = d->pid_pos.u;
+}
+
+void drive_init(Drive& d, float32_t Ts)
+{
+    d.Ts = Ts;
+    foc_init(&d.foc, 2, SVPWM);
+    PID_Param_Init(&d.foc.pid_d, 1, -1, 1, 0.5f, Ts, 1e-3f, 1, 0, 0, 1);
+    PID_Param_Init(&d.foc.pid_q, 1, -1, 1, 0.5f, Ts, 1e-3f, 1, 0, 0, 1);
+    pll_init(&d.pll, 2 * Ts, 400.0f, 4e4f, 3000.0f, 500.0f);
+
+    Biquad_Coef_t c;
+    biquad_init(&d.bq, BIQUAD_MAX_CHANNELS, 2);
+    biquad_design_lpf(&c, 1000.0f, 0.7071f, 4 * Ts);
+    biquad_set_stage(&d.bq, 0, BIQUAD_ALL_CHANNELS, &c);
+    biquad_design_notch(&c, 800.0f, 4.0f, 4 * Ts);
+    biquad_set_stage(&d.bq, 1, BIQUAD_ALL_CHANNELS, &c);
+
+    lpf_1st_init(&d.lpf_speed, 0, 0, 0.1f, 0, 0.9f);
+    PID_Data_Init(&d.pid_speed, 0, 0, 0, 0, 0);
+    PID_Param_Init(&d.pid_speed, 10, -10, 10, 0.05f, 10 * Ts, 0.02f, 1, 0, 0, 1);
+    PID_Data_Init(&d.pid_pos, 0, 0, 0, 0, 0);
+    PID_Param_Init(&d.pid_pos, 300, -300, 300, 20.0f, 40 * Ts, 0, 0, 0, 0, 1);
+}
+
+uint32_t counter()
+{
+    return (uint32_t)bench::cycles();
+}
+
+// 99th percentile of the run time of one task, counter ticks
+uint32_t calibrate(const Sched_Task_t& t, size_t runs)
+{
+    std::vector<uint32_t> dt(runs);
+    for (size_t k = 0; k < runs; k++) {
+        uint32_t t0 = counter();
+        t.fn(t.ctx);
+        dt[k] = counter() - t0;
+    }
+    std::nth_element(dt.begin(), dt.begin() + runs * 99 / 100, dt.end());
+    return dt[runs * 99 / 100];
+}
+
+struct Report
+{
+    uint32_t            static_peak = 0;
+    double              static_mean = 0;
+    double              mean = 0;
+    double              phase_peak = 0;     // busiest tick of the hyperperiod, median
+    uint32_t            phase_peak_at = 0;
+    uint32_t            worst = 0;
+    uint32_t            worst_at = 0;
+    uint32_t            overruns = 0;
+    std::vector<double> profile;
+};
+
+bool run(const std::vector<Sched_Task_t>& tasks, const Options& opt, uint32_t tick_budget, Report& r)
+{
+    Sched_Obj_t s;
+    const uint16_t n = (uint16_t)tasks.size();
+
+    // static: budgets charged, no counter
+    if (sched_init(&s, tasks.data(), n, tick_budget, nullptr) != 0) {
+        return false;
+    }
+    for (uint32_t t = 0; t < s.hyper; t++) {
+        sched_tick(&s);
+    }
+    r.static_peak = s.tick_max;
+    r.static_mean = (double)s.tick_sum / s.hyper;
+
+    // measured
+    sched_init(&s, tasks.data(), n, tick_budget, counter);
+    for (uint32_t t = 0; t < 4 * s.hyper; t++) {    // warm up
+        sched_tick(&s);
+    }
+    sched_reset_stats(&s);
+    std::vector<std::vector<uint32_t>> load(s.hyper);
+    for (auto& l : load) {
+        l.reserve(opt.ticks / s.hyper + 1);
+    }
+    for (uint32_t k = 0; k < opt.ticks; k++) {
+        uint32_t ph = s.tick % s.hyper;
+        sched_tick(&s);
+        load[ph].push_back(s.tick_last);
+    }
+    r.mean = (double)s.tick_sum / opt.ticks;
+    r.worst = s.tick_max;
+    r.worst_at = s.tick_max_at % s.hyper;
+    r.overruns = s.tick_overruns;
+    r.profile.resize(s.hyper);
+    for (uint32_t ph = 0; ph < s.hyper; ph++) {
+        auto& l = load[ph];
+        if (!l.empty()) {
+            std::nth_element(l.begin(), l.begin() + l.size() / 2, l.end());
+            r.profile[ph] = l[l.size() / 2];
+        }
+        if (r.profile[ph] > r.phase_peak) {
+            r.phase_peak = r.profile[ph];
+            r.phase_peak_at = ph;
+        }
+    }
+    return true;
+}
+
+// names of the tasks due at a tick, comma separated
+std::string due(const std::vector<Sched_Task_t>& tasks, uint32_t tick)
+{
+    std::string s;
+    for (const auto& t : tasks) {
+        if (tick % t.divisor == t.phase) {
+            s += s.empty() ? "" : ",";
+            s += t.name;
+        }
+    }
+    return s;
+}
+
+Options parse_args(int argc, char** argv)
+{
+    Options opt;
+    bool ok = true;
+    for (int i = 1; i < argc; i++) {
+        bool more = i + 1 < argc;
+        if (std::strcmp(argv[i], "--ticks") == 0 && more) {
+            opt.ticks = (uint32_t)std::atol(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--Ts") == 0 && more) {
+            opt.Ts = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--profile") == 0) {
+            opt.profile = true;
+        }
+        else {
+            ok = false;
+        }
+    }
+    if (!ok || opt.ticks == 0 || opt.Ts <= 0) {
+        std::fprintf(stderr, "usage: %s [--ticks N] [--Ts s] [--profile]\n", argv[0]);
+        std::exit(2);
+    }
+    return opt;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opt = parse_args(argc, argv);
+    static Drive drive;
+    drive_init(drive, (float32_t)opt.Ts);
+
+    std::vector<Sched_Task_t> aligned = {
+        {"current", task_current, &drive, 1, 0, 0},
+        {"observer", task_observer, &drive, 2, 0, 0},
+        {"filters", task_filters, &drive, 4, 0, 0},
+        {"speed", task_speed, &drive, 10, 0, 0},
+        {"position", task_position, &drive, 40, 0, 0},
+    };
+    for (auto& t : aligned) {
+        for (int k = 0; k < 1000; k++) {     // warm up
+            t.fn(t.ctx);
+        }
+        t.budget = calibrate(t, 20000);
+    }
+    std::vector<Sched_Task_t> spread = aligned;
+    if (sched_spread(spread.data(), (uint16_t)spread.size()) == 0) {
+        std::fprintf(stderr, "invalid task table\n");
+        return 2;
+    }
+
+    const uint32_t tick_budget = (uint32_t)(opt.Ts * 1e9 * bench::ticks_per_ns());
+    std::printf("Ts %g s (%u counter ticks), hyperperiod %u ticks, %u ticks per schedule\n\n", opt.Ts,
+                tick_budget, sched_hyperperiod(aligned.data(), (uint16_t)aligned.size()), opt.ticks);
+    std::printf("%-10s %8s %8s %14s %14s\n", "task", "divisor", "budget", "aligned phase", "spread phase");
+    for (size_t k = 0; k < aligned.size(); k++) {
+        std::printf("%-10s %8u %8u %14u %14u\n", aligned[k].name, aligned[k].divisor, aligned[k].budget,
+                    aligned[k].phase, spread[k].phase);
+    }
+
+    Report ra, rs;
+    if (!run(aligned, opt, tick_budget, ra) || !run(spread, opt, tick_budget, rs)) {
+        std::fprintf(stderr, "invalid task table\n");
+        return 2;
+    }
+
+    std::printf("\n%-9s %12s %12s %12s %14s %12s %28s %9s\n", "schedule", "static peak", "static mean",
+                "mean tick", "busiest tick", "worst tick", "worst at (tick: tasks)", "overruns");
+    for (const auto* p : {&ra, &rs}) {
+        const auto& r = *p;
+        const auto& tasks = p == &ra ? aligned : spread;
+        std::string at = std::to_string(r.worst_at) + ": " + due(tasks, r.worst_at);
+        std::printf("%-9s %12u %12.1f %12.1f %9.1f @%-3u %12u %28s %9u\n", p == &ra ? "aligned" : "spread",
+                    r.static_peak, r.static_mean, r.mean, r.phase_peak, r.phase_peak_at, r.worst, at.c_str(),
+                    r.overruns);
+    }
+    std::printf("\nstatic peak %.2fx lower, busiest measured tick %.2fx lower with the spread phases\n",
+                (double)ra.static_peak / rs.static_peak, ra.phase_peak / rs.phase_peak);
+
+    if (opt.profile) {
+        std::printf("\n%6s %12s %12s  %s\n", "tick", "aligned", "spread", "spread tasks");
+        for (size_t ph = 0; ph < rs.profile.size(); ph++) {
+            std::printf("%6zu %12.1f %12.1f  %s\n", ph, ra.profile[ph], rs.profile[ph],
+                        due(spread, (uint32_t)ph).c_str());
+        }
+    }
+
+    return rs.static_peak < ra.static_peak ? 0 : 1;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file       trig_accuracy.cpp
+ *
+ * @brief      Worst-case error of each trig_sincos backend
+ *
+ *      Sweeps theta densely over [-range, range] and compares sin/cos against the
+ *      double-precision libm result. The figures quoted in trig.h come from here.
+ *
+ *      Usage: trig_accuracy [range_in_rad] [points]
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "ctrl_common.h"
+#include "trig.h"
+
+namespace {
+
+struct Backend
+{
+    const char* name;
+    void (*fn)(float32_t, SinCos_t*);
+};
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    double range  = argc > 1 ? std::atof(argv[1]) : 8.0 * 3.141592653589793;
+    long   points = argc > 2 ? std::atol(argv[2]) : 20000000L;
+
+    const Backend backends[] = {
+        {"libm",  trig_sincos_libm},
+        {"poly",  trig_sincos_poly},
+        {"table", trig_sincos_table},
+    };
+
+    std::printf("theta in [-%.4f, %.4f], %ld points\n", range, range, points);
+    std::printf("%-8s %14s %14s %14s\n", "backend", "max |err sin|", "max |err cos|", "worst theta");
+
+    for (const Backend& b : backends) {
+        double err_s = 0, err_c = 0, worst = 0;
+        for (long k = 0; k <= points; k++) {
+            float    theta = (float)(-range + 2.0 * range * (double)k / (double)points);
+            SinCos_t sc;
+            b.fn(theta, &sc);
+
+            double es = std::fabs((double)sc.sin - std::sin((double)theta));
+            double ec = std::fabs((double)sc.cos - std::cos((double)theta));
+            if (es > err_s) {
+                err_s = es;
+                worst = theta;
+            }
+            if (ec > err_c) {
+                err_c = ec;
+                if (ec > err_s) {
+                    worst = theta;
+                }
+            }
+        }
+        std::printf("%-8s %14.3e %14.3e %14.6f\n", b.name, err_s, err_c, worst);
+    }
+
+    return 0;
+}
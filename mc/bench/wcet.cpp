@@ -0,0 +1,543 @@
+/**
+ * @file       wcet.cpp
+ * @date       Oct 2026
+ *
+ * @brief      Tail latency of the control kernels: percentiles, histograms, regression check
+ *
+ *      Every call is timed on its own, so the branches of determine_sector_12N(),
+ *      calc_svm_duty() and SATURATE() show up as a spread instead of vanishing in a
+ *      mean. Each kernel is run on two input sets:
+ *        random       uniform over the working range, as bench_kernels
+ *        adversarial  the inputs the branches turn on: sector boundaries (k*30
+ *                     degrees, a few ulp either side), the hexagon edge and
+ *                     overmodulation, the zero vector; controller errors right
+ *                     at the integral rate and output limits; quadrant
+ *                     boundaries and wrap-around of the angle. Shuffled, so
+ *                     the predictors cannot learn the order
+ *      and in two cache states:
+ *        warm   back-to-back calls
+ *        cold   before each call the state, the input and the kernel's code are
+ *               evicted, and 4096 random branches retrain the branch predictors
+ *               (there is no user-level predictor flush)
+ *      Each input is timed in --repeats passes over the set, --samples inputs
+ *      warm and half of that cold. Every pass starts at a different input,
+ *      as passes of equal length would otherwise meet a periodic interrupt at
+ *      the same input each time. p50/p99/p99.9/max are over every timed call,
+ *      so the misses, mispredictions and interference of the host are in the
+ *      tail as they happened. The regression check needs figures that repeat
+ *      from one run to the next, and uses the fastest pass of each input
+ *      instead ("fastest" p99/p99.9): an interrupt lands on one pass at random,
+ *      an input-dependent slow path is slow in every pass. The timer overhead
+ *      (median of empty measurements) is subtracted.
+ *
+ *      Usage: wcet [--filter <substr>] [--samples N] [--repeats N] [--hist] [--csv]
+ *                  [--save file] [--baseline file] [--tolerance x] [--cold-tolerance x]
+ *
+ *      --save writes the percentiles as CSV; --baseline compares against such a
+ *      file and flags the rows whose fastest-pass p99 or p99.9 exceed the
+ *      baseline by more than the tolerance plus 32 counter ticks, 1.5x by
+ *      default for warm and cold rows. A row over the limit is measured twice
+ *      more and counts only if it is over every time. bench/wcet_baseline.csv
+ *      is the reference baseline, the wcet_check target runs against it. The
+ *      file also keeps the "reference" row, a fixed chain of dependent additions
+ *      timed the same way; the baseline is scaled by the ratio of the two
+ *      references, so that a slower clock of the whole machine is not taken
+ *      for a regression of the kernels.
+ *
+ *      Exit status: 0, or 1 when a row regressed against the baseline, 2 on a
+ *      usage or file error.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "bench_common.hpp"
+#include "ctrl_common.h"
+#include "foc.h"
+#include "pid.h"
+#include "svm.h"
+#include "transforms.h"
+#include "trig.h"
+
+namespace {
+
+#if defined(_MSC_VER)
+    #define WCET_NOINLINE           __declspec(noinline)
+#else
+    #define WCET_NOINLINE           __attribute__((noinline))
+#endif
+
+constexpr size_t   kInputs  = 16384;
+constexpr double   kSlack   = 32;       // counter ticks allowed on top of the tolerance
+constexpr int      kRetries = 2;        // measurements of a row that regressed before it counts
+constexpr uint32_t kSubBins = 4;        // histogram bins per octave
+
+struct Options
+{
+    const char*     filter    = nullptr;
+    size_t          samples   = 16384;      // inputs timed warm; cold half
+    uint32_t        repeats   = 7;          // passes over the inputs
+    bool            hist      = false;
+    bool            csv       = false;
+    std::string     save;
+    std::string     baseline;
+    double          tolerance = 1.5;        // warm rows
+    double          cold_tol  = 1.5;        // cold rows
+};
+
+// one drive of inputs; not every kernel uses every field
+struct In
+{
+    float a, b, c;      // alpha/beta or phase currents
+    float theta;
+    float ref_d, ref_q; // references, or (ref, fb) for the PI alone
+};
+
+struct Kernel
+{
+    const char*                         name;
+    std::function<void(const In&)>      fn;
+    std::function<void()>               evict;      // state and code, the input is evicted by the runner
+};
+
+struct Row
+{
+    std::string key;        // kernel/inputs/cache
+    double      p50, p99, p999, max;        // every timed call
+    double      fast99, fast999;            // fastest pass of each input, for the regression check
+    std::vector<uint64_t> ticks;
+    const Kernel* kernel = nullptr;         // to measure the row again
+    int           set    = 0;
+    bool          cold   = false;
+};
+
+//*****************************************************************************
+//
+// inputs
+//
+//*****************************************************************************
+std::vector<In> random_inputs(bench::Rng& rng)
+{
+    std::vector<In> v(kInputs);
+    for (auto& x : v) {
+        float r = rng.uniform(0.0f, 0.75f), phi = rng.uniform(-PI, PI);
+        x.a = r * std::cos(phi);
+        x.b = r * std::sin(phi);
+        x.c = -x.a - x.b;
+        x.theta = rng.uniform(-PI, PI);
+        x.ref_d = rng.uniform(-1.0f, 1.0f);
+        x.ref_q = rng.uniform(-1.0f, 1.0f);
+    }
+    return v;
+}
+
+std::vector<In> adversarial_inputs(bench::Rng& rng)
+{
+    // magnitudes: zero, inside, the inscribed circle and hexagon corner, overmodulated
+    static const float mags[] = {0.0f, 0.3f, 0.57735f, 0.5774f, 0.6667f, 0.75f, 1.2f};
+    static const float eps[] = {0.0f, 1e-7f, -1e-7f, 1e-6f, -1e-6f};
+    // (ref - fb) of the PI test: 0, around the integral rate limit 0.05 and
+    // the output limit 1 of the controller, far out
+    static const float errs[] = {0.0f, 0.1f, -0.1f, 0.0999f, 2.0f, -2.0f, 1.999f, -1.999f, 20.0f, -20.0f};
+
+    std::vector<In> v(kInputs);
+    for (size_t i = 0; i < kInputs; i++) {
+        In& x = v[i];
+        const float e = eps[i % 5];
+        const float m = mags[(i / 5) % 7];
+        const float boundary = (float)((i / 35) % 12) * (PI / 6) - PI;
+        x.a = m * std::cos(boundary + e);
+        x.b = m * std::sin(boundary + e);
+        x.c = -x.a - x.b;
+        // quadrant boundaries of the sine/cosine reduction and the wrap at +-PI, +-8 PI
+        const float q = (float)((int)((i / 7) % 17) - 8) * (PI / 4);
+        x.theta = (i % 11 == 0) ? ((i & 1) ? 8 * PI : -8 * PI) + e : q + e;
+        x.ref_d = errs[(i / 3) % 10];
+        x.ref_q = -errs[(i / 13) % 10];
+    }
+    std::shuffle(v.begin(), v.end(), std::mt19937((uint32_t)rng.uniform(0, 1e6)));
+    return v;
+}
+
+//*****************************************************************************
+//
+// predictors
+//
+//*****************************************************************************
+
+// 4096 data-dependent branches from 16 sites, taken at random
+WCET_NOINLINE uint32_t perturb_predictors()
+{
+    static uint32_t x = 0x12345678u;
+    uint32_t acc = 0;
+    for (int k = 0; k < 256; k++) {
+        x = x * 1664525u + 1013904223u;
+        uint32_t r = x >> 8;
+        if (r & 0x0001) acc += 1;
+        if (r & 0x0002) acc ^= 3;
+        if (r & 0x0004) acc += 5;
+        if (r & 0x0008) acc ^= 7;
+        if (r & 0x0010) acc += 11;
+        if (r & 0x0020) acc ^= 13;
+        if (r & 0x0040) acc += 17;
+        if (r & 0x0080) acc ^= 19;
+        if (r & 0x0100) acc += 23;
+        if (r & 0x0200) acc ^= 29;
+        if (r & 0x0400) acc += 31;
+        if (r & 0x0800) acc ^= 37;
+        if (r & 0x1000) acc += 41;
+        if (r & 0x2000) acc ^= 43;
+        if (r & 0x4000) acc += 47;
+        if (r & 0x8000) acc ^= 53;
+    }
+    return acc;
+}
+
+//*****************************************************************************
+//
+// measurement
+//
+//*****************************************************************************
+double overhead_ticks()
+{
+    std::vector<uint64_t> t(4096);
+    for (auto& x : t) {
+        uint64_t c0 = bench::cycles();
+        bench::clobber();
+        x = bench::cycles() - c0;
+    }
+    std::nth_element(t.begin(), t.begin() + t.size() / 2, t.end());
+    return (double)t[t.size() / 2];
+}
+
+// 256 dependent additions, the clock of the core in counter ticks
+WCET_NOINLINE float reference_chain(float x)
+{
+    for (int k = 0; k < 256; k++) {
+        x = x + 1.0f;
+        bench::keep(x);
+    }
+    return x;
+}
+
+double percentile(const std::vector<uint64_t>& sorted, double p)
+{
+    size_t k = (size_t)std::ceil(p * (double)sorted.size());
+    return (double)sorted[k == 0 ? 0 : k - 1];
+}
+
+Row measure(const Kernel& k, const std::vector<In>& in, bool cold, size_t samples, uint32_t repeats,
+            double overhead)
+{
+    Row r;
+    std::vector<uint64_t> fastest(samples, UINT64_MAX);
+    r.ticks.reserve(samples * repeats);
+
+    for (size_t i = 0; i < 1024; i++) {     // warm-up
+        k.fn(in[i % in.size()]);
+    }
+    for (uint32_t pass = 0; pass < repeats; pass++) {
+        const size_t start = (size_t)(pass * 2654435761u) % samples;
+        for (size_t n = 0; n < samples; n++) {
+            const size_t s = (start + n) % samples;
+            const In& x = in[s % in.size()];
+            if (cold) {
+                k.evict();
+                bench::flush(&x, sizeof(x));
+                bench::keep(perturb_predictors());
+            }
+            uint64_t c0 = bench::cycles();
+            k.fn(x);
+            bench::clobber();
+            uint64_t dt = bench::cycles() - c0;
+            dt = dt > overhead ? dt - (uint64_t)overhead : 0;
+            r.ticks.push_back(dt);
+            fastest[s] = std::min(fastest[s], dt);
+        }
+    }
+
+    std::sort(r.ticks.begin(), r.ticks.end());
+    r.p50 = percentile(r.ticks, 0.50);
+    r.p99 = percentile(r.ticks, 0.99);
+    r.p999 = percentile(r.ticks, 0.999);
+    r.max = (double)r.ticks.back();
+    std::sort(fastest.begin(), fastest.end());
+    r.fast99 = percentile(fastest, 0.99);
+    r.fast999 = percentile(fastest, 0.999);
+    return r;
+}
+
+const char* const kCsvHeader = "kernel,p50,p99,p999,max,fast_p99,fast_p999";
+
+void print_csv(FILE* f, const Row& r)
+{
+    std::fprintf(f, "%s,%.0f,%.0f,%.0f,%.0f,%.0f,%.0f\n", r.key.c_str(), r.p50, r.p99, r.p999, r.max, r.fast99,
+                 r.fast999);
+}
+
+// quarter-octave bins from the fastest sample up, with the share of samples
+void print_hist(const std::vector<uint64_t>& sorted)
+{
+    const double lo = std::max<double>(1.0, (double)sorted.front());
+    size_t i = 0;
+    for (uint32_t b = 0; i < sorted.size(); b++) {
+        const double hi = lo * std::pow(2.0, (double)(b + 1) / kSubBins);
+        size_t n = 0;
+        while (i < sorted.size() && (double)sorted[i] < hi) {
+            i++;
+            n++;
+        }
+        if (n == 0) {
+            continue;
+        }
+        const double share = (double)n / (double)sorted.size();
+        const int bar = (int)std::ceil(share * 50);
+        std::printf("    < %8.0f %9zu %7.3f%% %.*s\n", hi, n, 100 * share, bar,
+                    "##################################################");
+    }
+}
+
+std::map<std::string, Row> load(const std::string& path)
+{
+    std::map<std::string, Row> rows;
+    std::ifstream f(path);
+    if (!f) {
+        std::fprintf(stderr, "cannot read %s\n", path.c_str());
+        std::exit(2);
+    }
+    std::string line;
+    while (std::getline(f, line)) {
+        std::stringstream ss(line);
+        std::string key, field;
+        Row r;
+        if (!std::getline(ss, key, ',') || key == "kernel") {
+            continue;
+        }
+        double* out[] = {&r.p50, &r.p99, &r.p999, &r.max, &r.fast99, &r.fast999};
+        for (double* o : out) {
+            std::getline(ss, field, ',');
+            *o = std::atof(field.c_str());
+        }
+        r.key = key;
+        rows[key] = r;
+    }
+    return rows;
+}
+
+Options parse_args(int argc, char** argv)
+{
+    Options opt;
+    bool ok = true;
+    for (int i = 1; i < argc; i++) {
+        bool more = i + 1 < argc;
+        if (std::strcmp(argv[i], "--filter") == 0 && more) {
+            opt.filter = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--samples") == 0 && more) {
+            opt.samples = std::strtoull(argv[++i], nullptr, 0);
+        }
+        else if (std::strcmp(argv[i], "--repeats") == 0 && more) {
+            opt.repeats = (uint32_t)std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--hist") == 0) {
+            opt.hist = true;
+        }
+        else if (std::strcmp(argv[i], "--csv") == 0) {
+            opt.csv = true;
+        }
+        else if (std::strcmp(argv[i], "--save") == 0 && more) {
+            opt.save = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--baseline") == 0 && more) {
+            opt.baseline = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--tolerance") == 0 && more) {
+            opt.tolerance = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--cold-tolerance") == 0 && more) {
+            opt.cold_tol = std::atof(argv[++i]);
+        }
+        else {
+            ok = false;
+        }
+    }
+    if (!ok || opt.samples < 4000 || opt.repeats == 0 || opt.tolerance < 1.0 || opt.cold_tol < 1.0) {
+        std::fprintf(stderr,
+            "usage: %s [--filter <substr>] [--samples N>=4000] [--repeats N] [--hist] [--csv]\n"
+            "          [--save file] [--baseline file] [--tolerance x>=1] [--cold-tolerance x>=1]\n", argv[0]);
+        std::exit(2);
+    }
+    return opt;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opt = parse_args(argc, argv);
+    bench::Rng rng;
+    const std::vector<In> sets[2] = {random_inputs(rng), adversarial_inputs(rng)};
+    const char* set_names[2] = {"random", "adversarial"};
+
+    SVM_t svm = {};
+    PID_Obj_t pid;
+    Transform_Obj_t T = {};
+    SinCos_t sc;
+    FOC_Obj_t foc;
+
+    PID_Data_Init(&pid, 0, 0, 0, 0, 0);
+    PID_Param_Init(&pid, 1.0f, -1.0f, 0.05f, 0.5f, 50e-6f, 1e-3f, 1, 0.0f, 0, 0.2f);
+    foc_init(&foc, 3, SVM_MODE(SVPWM, SVM_OVM_MPE));
+    PID_Param_Init(&foc.pid_d, 0.6f, -0.6f, 0.05f, 0.5f, 50e-6f, 1e-3f, 1, 0.0f, 0, 0.2f);
+    PID_Param_Init(&foc.pid_q, 0.6f, -0.6f, 0.05f, 0.5f, 50e-6f, 1e-3f, 1, 0.0f, 0, 0.2f);
+
+    float chain = 0;
+    const std::vector<Kernel> kernels = {
+        {"reference",
+         [&](const In&) { chain = reference_chain(chain); },
+         [&] {}},
+        {"modulator/SVPWM",
+         [&](const In& x) { modulator(&svm, x.a, x.b, SVPWM); },
+         [&] { bench::flush(&svm, sizeof(svm)); bench::flush_code(&modulator, 2048); }},
+        {"modulator/DPWM1+MME",
+         [&](const In& x) { modulator(&svm, x.a, x.b, SVM_MODE(DPWM1, SVM_OVM_MME)); },
+         [&] { bench::flush(&svm, sizeof(svm)); bench::flush_code(&modulator, 2048); }},
+        {"modulator_lut/SVPWM",
+         [&](const In& x) { modulator_lut(&svm, x.a, x.b, SVPWM); },
+         [&] { bench::flush(&svm, sizeof(svm)); bench::flush_code(&modulator_lut, 2048); }},
+        {"PID_Update/PI",
+         [&](const In& x) { PID_Update(&pid, x.ref_d, 0.0f, 0.0f); },
+         [&] { bench::flush(&pid, sizeof(pid)); bench::flush_code(&PID_Update); }},
+        {"trig_sincos/poly",
+         [&](const In& x) { trig_sincos_poly(x.theta, &sc); },
+         [&] { bench::flush(&sc, sizeof(sc)); bench::flush_code(&trig_sincos_poly); }},
+        {"AB02dq0",
+         [&](const In& x) {
+             T.AB0.alpha = x.a;
+             T.AB0.beta = x.b;
+             AB02dq0(&T, x.theta);
+         },
+         [&] { bench::flush(&T, sizeof(T)); bench::flush_code(&AB02dq0); bench::flush_code(&trig_sincos); }},
+        {"foc_current_step",
+         [&](const In& x) {
+             float duty[3];
+             foc_current_step(&foc, x.a, x.b, x.c, x.theta, x.ref_d, x.ref_q, duty);
+             bench::keep(duty[0]);
+         },
+         [&] {
+             bench::flush(&foc, sizeof(foc));
+             bench::flush_code(&foc_current_step, 2048);
+             bench::flush_code(&modulator_lut, 2048);
+             bench::flush_code(&trig_sincos);
+             bench::flush_code(&trig_sincos_poly);
+         }},
+    };
+
+    const double overhead = overhead_ticks();
+    if (!opt.csv) {
+        std::printf("counter: %.3f ticks/ns, timer overhead %.0f ticks subtracted, %zu warm / %zu cold inputs, "
+                    "%u passes; fastest: p99/p99.9 of each input's fastest pass\n\n", bench::ticks_per_ns(), overhead,
+                    opt.samples, opt.samples / 2, opt.repeats);
+        std::printf("%-40s %9s %9s %9s %9s %9s %9s\n", "kernel/inputs/cache (ticks)", "p50", "p99", "p99.9", "max",
+                    "fast p99", "p99.9");
+    }
+    else {
+        std::printf("%s\n", kCsvHeader);
+    }
+
+    std::vector<Row> rows;
+    for (const Kernel& k : kernels) {
+        const bool ref = std::strcmp(k.name, "reference") == 0;
+        if (!ref && opt.filter != nullptr && std::strstr(k.name, opt.filter) == nullptr) {
+            continue;
+        }
+        for (int s = 0; s < (ref ? 1 : 2); s++) {
+            for (int cold = 0; cold < (ref ? 1 : 2); cold++) {
+                Row r = measure(k, sets[s], cold != 0, cold ? opt.samples / 2 : opt.samples, opt.repeats, overhead);
+                r.key = std::string(k.name) + "/" + set_names[s] + "/" + (cold ? "cold" : "warm");
+                r.kernel = &k;
+                r.set = s;
+                r.cold = cold != 0;
+                if (opt.csv) {
+                    print_csv(stdout, r);
+                }
+                else {
+                    std::printf("%-40s %9.0f %9.0f %9.0f %9.0f %9.0f %9.0f\n", r.key.c_str(), r.p50, r.p99, r.p999,
+                                r.max, r.fast99, r.fast999);
+                }
+                if (opt.hist) {
+                    print_hist(r.ticks);
+                }
+                r.ticks.clear();
+                rows.push_back(r);
+            }
+        }
+    }
+
+    if (!opt.save.empty()) {
+        FILE* f = std::fopen(opt.save.c_str(), "w");
+        if (f == nullptr) {
+            std::fprintf(stderr, "cannot write %s\n", opt.save.c_str());
+            return 2;
+        }
+        std::fprintf(f, "%s\n", kCsvHeader);
+        for (const Row& r : rows) {
+            print_csv(f, r);
+        }
+        std::fclose(f);
+    }
+
+    int regressions = 0;
+    if (!opt.baseline.empty()) {
+        const std::map<std::string, Row> base = load(opt.baseline);
+        double scale = 1;
+        auto ref_base = base.find("reference/random/warm");
+        if (ref_base != base.end() && rows.front().key == "reference/random/warm" && ref_base->second.p50 > 0) {
+            scale = rows.front().p50 / ref_base->second.p50;
+        }
+        std::printf("\nagainst %s scaled by %.3f (reference), fastest p99 and p99.9 within %.2fx (warm) / %.2fx (cold)"
+                    " + %.0f ticks\n", opt.baseline.c_str(), scale, opt.tolerance, opt.cold_tol, kSlack);
+        for (const Row& r : rows) {
+            auto it = base.find(r.key);
+            if (it == base.end()) {
+                std::printf("%-40s not in the baseline\n", r.key.c_str());
+                continue;
+            }
+            const Row& b = it->second;
+            const double tol = r.cold ? opt.cold_tol : opt.tolerance;
+            auto slower = [&](const Row& x) {
+                return x.fast99 > b.fast99 * scale * tol + kSlack || x.fast999 > b.fast999 * scale * tol + kSlack;
+            };
+            if (!slower(r)) {
+                continue;
+            }
+            // a slow path repeats, a burst of the host does not: measure again
+            bool again = true;
+            for (int retry = 0; again && retry < kRetries; retry++) {
+                const Row r2 = measure(*r.kernel, sets[r.set], r.cold, r.cold ? opt.samples / 2 : opt.samples,
+                                       opt.repeats, overhead);
+                again = slower(r2);
+            }
+            if (again) {
+                std::printf("%-40s REGRESSION fastest p99 %.0f (was %.0f), p99.9 %.0f (was %.0f)\n", r.key.c_str(),
+                            r.fast99, b.fast99, r.fast999, b.fast999);
+                regressions++;
+            }
+            else {
+                std::printf("%-40s slower, not on the next measurement\n", r.key.c_str());
+            }
+        }
+        std::printf("%d of %zu rows regressed\n", regressions, rows.size());
+    }
+
+    return regressions ? 1 : 0;
+}
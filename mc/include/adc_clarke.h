@@ -0,0 +1,136 @@
+/**
+ * @file        adc_clarke.h
+ * @date        Oct 2026
+ *
+ * @brief      header file for the fused ADC-count to Clarke (alpha, beta) front end
+ *
+ *      The phase currents i_x = gain_x (counts_x - offset_x) are never formed:
+ *      adc_clarke_init() / adc_clarke_set_cal() fold gain and offset into the
+ *      amplitude-invariant Clarke matrix of abc2AB0(), so that
+ *
+ *          alpha = sum k_alpha[x] counts_x + c_alpha
+ *          beta  = sum k_beta[x]  counts_x + c_beta
+ *
+ *      is one multiply-add per sensor and output. With 2 sensors (a, b, and
+ *      c = -a - b) that is 3 multiply-adds, with 3 sensors 6 plus the zero
+ *      sequence. The result equals abc2AB0() on the scaled currents up to float
+ *      rounding (a few ulp of the full-scale current).
+ *
+ *      Offset calibration: while the PWM is off, call adc_clarke_cal_sample()
+ *      (or adc_clarke_cal_batch() on a DMA block) every period after
+ *      adc_clarke_cal_start(). Once the requested number of samples is in, the
+ *      means become the new offsets and the coefficients are folded again,
+ *      unless a mean is further than tol counts from the nominal offset, in
+ *      which case the old offsets stay and the calibration reports failure.
+ */
+
+#ifndef ADC_CLARKE_H_
+    #define ADC_CLARKE_H_
+
+#include "commontypes.h"
+#include "transforms.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ADC_CLARKE_CAL_MAX          65535u  // samples per calibration, the int32 sums cannot overflow
+
+typedef enum
+{
+    ADC_CAL_IDLE = 0,
+    ADC_CAL_RUNNING,
+    ADC_CAL_DONE,
+    ADC_CAL_FAILED,         // a mean was out of tolerance, offsets unchanged
+} AdcCal_State_t;
+
+typedef struct
+{
+    // folded Clarke coefficients, per sensor a, b, c
+    float32_t       k_alpha[3];
+    float32_t       k_beta[3];
+    float32_t       k_zero[3];
+    float32_t       c_alpha;
+    float32_t       c_beta;
+    float32_t       c_zero;
+    int16_t         n_sensors;          // 2 (a, b) or 3 (a, b, c)
+    // calibration
+    float32_t       gain[3];            // A per count
+    float32_t       offset[3];          // counts at zero current
+    float32_t       offset_nom[3];
+    float32_t       cal_tol;            // counts
+    int32_t         cal_sum[3];
+    uint16_t        cal_n;
+    uint16_t        cal_target;
+    AdcCal_State_t  cal_state;
+} AdcClarke_Obj_t;
+
+/**
+ * @brief      Front end init
+ *
+ * @param      fe          The front-end instance
+ * @param[in]  n_sensors   2 (phases a, b) or 3 (phases a, b, c)
+ * @param[in]  gain        A per count, one per sensor
+ * @param[in]  offset      Nominal counts at zero current, one per sensor
+ * @param[in]  cal_tol     Largest accepted |calibrated - nominal offset|, counts
+ *
+ * @return     0, or -1 if n_sensors is neither 2 nor 3
+ */
+int16_t adc_clarke_init(AdcClarke_Obj_t* const fe, int16_t n_sensors, const float32_t* gain,
+                        const float32_t* offset, float32_t cal_tol);
+
+/**
+ * @brief      Sets gains and offsets and folds them into the coefficients
+ *
+ * @param[in]  gain    NULL keeps the gains
+ * @param[in]  offset  NULL keeps the offsets
+ */
+void adc_clarke_set_cal(AdcClarke_Obj_t* const fe, const float32_t* gain, const float32_t* offset);
+
+/**
+ * @brief      ADC counts to (alpha, beta, zero)
+ *
+ * @param      fe      The front-end instance
+ * @param[in]  counts  n_sensors raw samples, phase a first
+ * @param[out] AB0     alpha, beta and zero_AB (0 with 2 sensors)
+ */
+void adc_clarke(const AdcClarke_Obj_t* const fe, const int16_t* counts, AB0_t* AB0);
+
+/**
+ * @brief      Batch variant over a DMA block
+ *
+ * @param[in]  counts    n_frames frames of n_sensors samples, sensor-interleaved
+ * @param[out] alpha     n_frames values
+ * @param[out] beta      n_frames values
+ */
+void adc_clarke_batch(const AdcClarke_Obj_t* const fe, const int16_t* counts, uint32_t n_frames,
+                      float32_t* alpha, float32_t* beta);
+
+/**
+ * @brief      Starts an offset calibration over n samples (PWM off)
+ *
+ * @param[in]  n     Samples, 1..ADC_CLARKE_CAL_MAX
+ */
+void adc_clarke_cal_start(AdcClarke_Obj_t* const fe, uint16_t n);
+
+/**
+ * @brief      Adds one frame to the running calibration
+ *
+ * @return     The calibration state after the frame
+ */
+AdcCal_State_t adc_clarke_cal_sample(AdcClarke_Obj_t* const fe, const int16_t* counts);
+
+/**
+ * @brief      Adds a DMA block of frames to the running calibration
+ *
+ *      Frames beyond the requested number are ignored.
+ *
+ * @return     The calibration state after the block
+ */
+AdcCal_State_t adc_clarke_cal_batch(AdcClarke_Obj_t* const fe, const int16_t* counts, uint32_t n_frames);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //<- !defined ADC_CLARKE_H_
@@ -7,12 +7,27 @@
     #define COMMONTYPES_H
     typedef unsigned int    bool_t;
     typedef char            char_t;
-    typedef signed int      int8_t;
-    typedef int             int16_t;
+#if defined(__GNUC__) || defined(__clang__) || defined(__cplusplus) || \
+    (defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L) || (defined(_MSC_VER) && _MSC_VER >= 1600)
+    // the fixed-width names come from <stdint.h> wherever it exists (and is
+    // pulled in by most libc/C++ headers), so use those to avoid a clash.
+    #include <stdint.h>
+#else
+    // pre-C99 compilers: the narrowest type of each width, so that the
+    // objects keep the size and the wrap-around of the embedded target
+    #include <limits.h>
+    typedef signed char     int8_t;
+    typedef short           int16_t;
+    typedef unsigned char   uint8_t;
+    typedef unsigned short  uint16_t;
+    #if INT_MAX == 0x7FFFFFFF
     typedef int             int32_t;
-    typedef unsigned int    uint8_t;
-    typedef unsigned int    uint16_t;
     typedef unsigned int    uint32_t;
+    #else
+    typedef long            int32_t;
+    typedef unsigned long   uint32_t;
+    #endif
+#endif
     typedef float           float32_t;
     typedef double          float64_t;
 #endif
\ No newline at end of file
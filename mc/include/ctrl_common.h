@@ -86,6 +86,42 @@
 #endif
 
 
+/**
+ * @brief      Inline function qualifier for kernels shared through headers
+ *
+ *      MSVC only accepts `inline` in C++ (or C11 and later), `__inline` works in both.
+ */
+#ifndef MC_INLINE
+    #if defined(_MSC_VER) && !defined(__cplusplus)
+        #define MC_INLINE               static __inline
+    #else
+        #define MC_INLINE               static inline
+    #endif
+#endif
+
+
+/**
+ * @brief      Alignment of the per-drive control objects
+ *
+ *      MC_ALIGNED(n) goes between `struct` and the member list. The objects a
+ *      drive instantiates once (FOC_Obj_t, SMO_Obj_t) start on a cache line so
+ *      that their hot state spans the fewest lines; targets without a data
+ *      cache define MC_CACHE_LINE as 4 to drop the padding.
+ */
+#ifndef MC_CACHE_LINE
+    #define MC_CACHE_LINE               64
+#endif
+#ifndef MC_ALIGNED
+    #if defined(_MSC_VER)
+        #define MC_ALIGNED(n)           __declspec(align(n))
+    #elif defined(__GNUC__) || defined(__clang__)
+        #define MC_ALIGNED(n)           __attribute__((aligned(n)))
+    #else
+        #define MC_ALIGNED(n)
+    #endif
+#endif
+
+
 /**
  * @brief      Two side limitation
  *
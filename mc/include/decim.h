@@ -0,0 +1,98 @@
+/**
+ * @file        decim.h
+ * @date        Oct 2026
+ *
+ * @brief      header file for the CIC decimator of oversampled ADC channels
+ *
+ *      Decim_Cic_Obj_t takes the raw ADC counts of up to DECIM_MAX_CHANNELS
+ *      channels, sampled R times per control period, and emits one filtered value
+ *      per channel and period. It is an order-N cascaded integrator-comb filter
+ *      (differential delay 1):
+ *        - per raw sample      N integer additions per channel, nothing else
+ *        - per output          N subtractions, one multiply-add to scale to
+ *                              float units, and the optional compensator
+ *      The integrators wrap modulo 2^32, which is exact for a CIC as long as
+ *      16 + N log2(R) <= 32 bits; decim_cic_init() refuses anything larger.
+ *
+ *      The CIC gain droops towards the output Nyquist frequency. With comp set,
+ *      a 2-tap compensator y = (1 + a) c(k) - a c(k-1) restores the magnitude to
+ *      second order in frequency. It adds no delay (a symmetric FIR compensator
+ *      would cost a whole control period of latency in the current loop), but
+ *      it adds some phase lead.
+ *
+ *      decim_cic_process() consumes a whole DMA buffer of channel-interleaved
+ *      frames in one call. The buffer may hold any number of frames; the
+ *      decimation phase carries over between calls.
+ */
+
+#ifndef DECIM_H_
+    #define DECIM_H_
+
+#include "commontypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DECIM_MAX_CHANNELS          8
+#define DECIM_MAX_ORDER             4
+
+typedef struct
+{
+    // CIC data
+    uint32_t    integ[DECIM_MAX_ORDER][DECIM_MAX_CHANNELS];     // integrators, wrap modulo 2^32
+    uint32_t    comb[DECIM_MAX_ORDER][DECIM_MAX_CHANNELS];      // comb delay lines
+    float32_t   c_k1[DECIM_MAX_CHANNELS];                       // previous CIC output, compensator
+    uint16_t    phase;                                          // raw samples into the current period
+    // CIC param
+    uint16_t    n_ch;
+    uint16_t    R;          // decimation ratio
+    uint16_t    order;      // N
+    int16_t     comp;       // compensator on
+    float32_t   comp_a;
+    float32_t   k[DECIM_MAX_CHANNELS];      // scale / R^N
+    float32_t   c[DECIM_MAX_CHANNELS];      // scale * offset
+} Decim_Cic_Obj_t;
+
+/**
+ * @brief      CIC decimator init, scale 1 and offset 0 on every channel
+ *
+ * @param      cic      The CIC instance
+ * @param[in]  n_ch     Channels per frame, 1..DECIM_MAX_CHANNELS
+ * @param[in]  R        Raw samples per output, >= 1
+ * @param[in]  order    N, 1..DECIM_MAX_ORDER
+ * @param[in]  comp     Non-zero to enable the droop compensator
+ *
+ * @return     0, or -1 if a parameter is out of range or the integrators
+ *             would need more than 32 bits
+ */
+int16_t decim_cic_init(Decim_Cic_Obj_t* const cic, uint16_t n_ch, uint16_t R, uint16_t order, int16_t comp);
+
+/**
+ * @brief      Output units of a channel: y = scale * (counts - offset)
+ */
+void decim_cic_set_scale(Decim_Cic_Obj_t* const cic, uint16_t ch, float32_t scale, float32_t offset);
+
+/**
+ * @brief      Clears the filter state and the decimation phase
+ */
+void decim_cic_reset(Decim_Cic_Obj_t* const cic);
+
+/**
+ * @brief      Filters a block of raw frames
+ *
+ * @param      cic       The CIC instance
+ * @param[in]  buf       n_frames frames of n_ch ADC counts, channel-interleaved
+ * @param[in]  n_frames  Frames in buf
+ * @param[out] out       Filtered values, n_ch per output, channel-interleaved;
+ *                       room for (n_frames + R - 1) / R outputs
+ *
+ * @return     Number of outputs written; R frames from phase 0 give exactly one
+ */
+uint32_t decim_cic_process(Decim_Cic_Obj_t* const cic, const uint16_t* buf, uint32_t n_frames, float32_t* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //<- !defined DECIM_H_
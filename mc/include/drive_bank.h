@@ -0,0 +1,169 @@
+/**
+ * @file        drive_bank.h
+ * @date        Oct 2026
+ *
+ * @brief      header file for the multi-motor drive bank
+ *
+ *      The current loops of up to DRIVE_BANK_MAX drives in one object, stored as
+ *      structure-of-arrays: one array per signal, indexed by the drive (lane).
+ *      drive_bank_step() runs Clarke -> Park -> d/q PI -> inverse Park -> SVM for
+ *      every lane, several lanes per instruction:
+ *        - AVX-512 (16 lanes) or AVX2 (8 lanes) for the transforms and the PI
+ *          controllers, picked once at run time from the CPU features; the scalar
+ *          path covers other targets and the tail lanes
+ *        - modulator_batch() for the modulation, with its own dispatch
+ *      The PI limits are applied per lane with min/max; the lanes whose output
+ *      was limited are reported in sat[].
+ *
+ *      Each lane computes the same result as foc_current_step() with TRIG_POLY
+ *      (the bank always uses the polynomial sine/cosine), operation for
+ *      operation: the vector and the scalar paths are bit-identical to each
+ *      other and to a FOC_Obj_t running the same drive.
+ *
+ *      Banks are independent, and so are disjoint lane ranges of one bank:
+ *      drive_bank_step_range() lets several cores share the drives, one range
+ *      each. drive_bank_init() picks the kernels, the steps only read the
+ *      choice. The bank starts on a cache line, so ranges starting at multiples
+ *      of DRIVE_BANK_PART lanes share no cache line of any array.
+ */
+
+#ifndef DRIVE_BANK_H_
+    #define DRIVE_BANK_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "commontypes.h"
+#include "ctrl_common.h"
+#include "pid.h"
+#include "svm.h"
+
+#define DRIVE_BANK_MAX              256
+#define DRIVE_BANK_PART             64      // lanes, cache-line-disjoint partition unit
+
+#define DRIVE_BANK_SAT_D            0x01    // sat[]: the d-axis output was limited
+#define DRIVE_BANK_SAT_Q            0x02    // sat[]: the q-axis output was limited
+
+// one PI controller per lane, the fields of PID_Obj_t
+typedef struct
+{
+    // data
+    float32_t     err[DRIVE_BANK_MAX];
+    float32_t     ui[DRIVE_BANK_MAX];
+    float32_t     u[DRIVE_BANK_MAX];
+    float32_t     err_aw[DRIVE_BANK_MAX];
+    // params
+    float32_t     OutHiLim[DRIVE_BANK_MAX];
+    float32_t     OutLoLim[DRIVE_BANK_MAX];
+    float32_t     IntRateLim[DRIVE_BANK_MAX];
+    float32_t     Kp[DRIVE_BANK_MAX];
+    float32_t     Ki[DRIVE_BANK_MAX];
+    float32_t     Kd[DRIVE_BANK_MAX];
+    float32_t     Kp_aw[DRIVE_BANK_MAX];
+} DriveBank_PI_t;
+
+typedef struct MC_ALIGNED(MC_CACHE_LINE)
+{
+    // inputs, written by the caller before each step
+    float32_t       ia[DRIVE_BANK_MAX];
+    float32_t       ib[DRIVE_BANK_MAX];
+    float32_t       ic[DRIVE_BANK_MAX];         // ignored with 2 sensors
+    float32_t       theta_e[DRIVE_BANK_MAX];
+    float32_t       id_ref[DRIVE_BANK_MAX];
+    float32_t       iq_ref[DRIVE_BANK_MAX];
+    float32_t       vd_ff[DRIVE_BANK_MAX];      // PI feedforward, 0 after init
+    float32_t       vq_ff[DRIVE_BANK_MAX];
+    // controllers
+    DriveBank_PI_t  pi_d;                       // output vd
+    DriveBank_PI_t  pi_q;                       // output vq
+    // outputs
+    float32_t       id[DRIVE_BANK_MAX];
+    float32_t       iq[DRIVE_BANK_MAX];
+    float32_t       Ualpha[DRIVE_BANK_MAX];
+    float32_t       Ubeta[DRIVE_BANK_MAX];
+    float32_t       ma[DRIVE_BANK_MAX];         // duty cycles of phase a, b, c
+    float32_t       mb[DRIVE_BANK_MAX];
+    float32_t       mc[DRIVE_BANK_MAX];
+    int16_t         sector[DRIVE_BANK_MAX];
+    uint8_t         sat[DRIVE_BANK_MAX];        // DRIVE_BANK_SAT_D | DRIVE_BANK_SAT_Q
+    // config
+    uint16_t        n;                          // lanes in use
+    int16_t         numSensors;                 // 2(phase a,b) or 3(phase a,b,c)
+    SVM_mode_t      mode;
+} DriveBank_Obj_t;
+
+/**
+ * @brief      Drive bank initialization
+ *
+ *      Clears every array, the PI gains and limits included (a lane outputs 0
+ *      until drive_bank_set_pi()). The first call picks the kernels of
+ *      drive_bank_step() and modulator_batch() from the CPU features; finish
+ *      it before steps run on other threads.
+ *
+ * @param      bank        The drive bank
+ * @param[in]  n           The number of drives, 1..DRIVE_BANK_MAX
+ * @param[in]  numSensors  The number of current sensors, 2(phase a,b) or 3(phase a,b,c)
+ * @param[in]  mode        The SVM mode of all drives; DPWM_ADAPTIVE modulates as DPWM1,
+ *                         without the load-angle rule of foc_current_step()
+ *
+ * @return     0, or -1 if n or numSensors is out of range
+ */
+int16_t drive_bank_init(DriveBank_Obj_t* const bank, uint16_t n, int16_t numSensors, SVM_mode_t mode);
+
+/**
+ * @brief      Loads the gains, limits and states of a PID_Obj_t pair into a lane
+ *
+ * @param      bank    The drive bank
+ * @param[in]  lane    The drive, < bank->n
+ * @param[in]  pid_d   The d-axis controller, set up with PID_Param_Init()
+ * @param[in]  pid_q   The q-axis controller
+ */
+void drive_bank_set_pi(DriveBank_Obj_t* const bank, uint16_t lane, const PID_Obj_t* pid_d, const PID_Obj_t* pid_q);
+
+/**
+ * @brief      Copies the controllers of a lane back into a PID_Obj_t pair
+ */
+void drive_bank_get_pi(const DriveBank_Obj_t* bank, uint16_t lane, PID_Obj_t* pid_d, PID_Obj_t* pid_q);
+
+/**
+ * @brief      One current-loop tick of every drive
+ */
+void drive_bank_step(DriveBank_Obj_t* const bank);
+
+/**
+ * @brief      One current-loop tick of the drives first .. first+count-1
+ *
+ *      The range is clipped to bank->n. Calls on disjoint ranges do not
+ *      interfere and may run concurrently.
+ */
+void drive_bank_step_range(DriveBank_Obj_t* const bank, uint16_t first, uint16_t count);
+
+/**
+ * @brief      drive_bank_step_range() without vector instructions, the reference
+ */
+void drive_bank_step_range_scalar(DriveBank_Obj_t* const bank, uint16_t first, uint16_t count);
+
+/**
+ * @brief      Instruction set of the drive_bank_step() kernels: "avx512", "avx2" or "scalar"
+ */
+const char* drive_bank_isa(void);
+
+/**
+ * @brief      Limits the instruction set drive_bank_step() may use, for comparisons
+ *
+ *      "scalar" also modulates with modulator_batch_scalar(); the vector
+ *      kernels modulate with modulator_batch() and its own choice. Not while
+ *      a step runs.
+ *
+ * @param[in]  isa   "avx512", "avx2" or "scalar"
+ *
+ * @return     0, or -1 if the CPU does not have it (the selection is unchanged)
+ */
+int16_t drive_bank_set_isa(const char* isa);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //<- !defined DRIVE_BANK_H_
@@ -4,6 +4,15 @@
  * @brief      header file for filters
  * 
  *      This header file implements vairious filters
+ *
+ *      Biquad_Obj_t is a cascade of second-order sections (transposed Direct
+ *      Form II) over up to BIQUAD_MAX_CHANNELS channels, e.g. the phase currents
+ *      and speeds of a dual-motor drive. The coefficients and states are stored
+ *      stage by stage with one lane per channel (structure of arrays), so
+ *      biquad_update() filters every channel of a stage with one vector
+ *      operation per coefficient: with AVX2 the 8 lanes are one register and six
+ *      channels cost the same as one. The coefficients come from the
+ *      biquad_design_*() helpers, evaluated once at init.
  */
 #ifndef FILTERS_H_
     #define FILTERS_H_
@@ -50,6 +59,115 @@ void lpf_1st_init(Lpf1st_Obj_t* const lpf_1st_inst, float32_t y, float32_t u,
  */
 void lpf_1st_update(Lpf1st_Obj_t* const lpf_1st_inst, float32_t u);
 
+#define BIQUAD_MAX_CHANNELS         8       // lanes of one object, one AVX2 register
+#define BIQUAD_MAX_STAGES           4
+#define BIQUAD_ALL_CHANNELS         0xFFFFu
+#define BIQUAD_VECTOR_MIN_CH        2       // fewer channels run biquad_update_scalar()
+
+// one second-order section, normalized to a0 = 1
+//   y(k) = b0 x(k) + b1 x(k-1) + b2 x(k-2) - a1 y(k-1) - a2 y(k-2)
+typedef struct
+{
+    float32_t   b0;
+    float32_t   b1;
+    float32_t   b2;
+    float32_t   a1;
+    float32_t   a2;
+} Biquad_Coef_t;
+
+typedef struct Biquad_Obj_s Biquad_Obj_t;
+typedef void (*Biquad_fn_t)(Biquad_Obj_t* const bq, const float32_t* x, float32_t* y);
+
+// [stage][channel]; lanes at and above n_ch stay zero
+struct Biquad_Obj_s
+{
+    // biquad params
+    float32_t   b0[BIQUAD_MAX_STAGES][BIQUAD_MAX_CHANNELS];
+    float32_t   b1[BIQUAD_MAX_STAGES][BIQUAD_MAX_CHANNELS];
+    float32_t   b2[BIQUAD_MAX_STAGES][BIQUAD_MAX_CHANNELS];
+    float32_t   a1[BIQUAD_MAX_STAGES][BIQUAD_MAX_CHANNELS];
+    float32_t   a2[BIQUAD_MAX_STAGES][BIQUAD_MAX_CHANNELS];
+    // biquad data, transposed DF-II states
+    float32_t   s1[BIQUAD_MAX_STAGES][BIQUAD_MAX_CHANNELS];
+    float32_t   s2[BIQUAD_MAX_STAGES][BIQUAD_MAX_CHANNELS];
+    Biquad_fn_t update;     // kernel of biquad_update(), set by biquad_init()
+    uint16_t    n_ch;
+    uint16_t    n_stages;
+};
+
+/**
+ * @brief      Second-order low pass, bilinear transform with the corner prewarped
+ *
+ * @param[out] c     The section
+ * @param[in]  fc    Corner frequency, Hz, below 1/(2 Ts)
+ * @param[in]  Q     Quality factor, 0.7071 for Butterworth
+ * @param[in]  Ts    Sample time, s
+ */
+void biquad_design_lpf(Biquad_Coef_t* c, float32_t fc, float32_t Q, float32_t Ts);
+
+/**
+ * @brief      Notch, unity gain away from fc, zero at fc; bandwidth fc/Q
+ */
+void biquad_design_notch(Biquad_Coef_t* c, float32_t fc, float32_t Q, float32_t Ts);
+
+/**
+ * @brief      Band pass, unity gain at fc; bandwidth fc/Q
+ */
+void biquad_design_bpf(Biquad_Coef_t* c, float32_t fc, float32_t Q, float32_t Ts);
+
+/**
+ * @brief      Biquad cascade init: every stage of every channel a pass-through
+ *
+ *      Also picks the kernel of biquad_update(); the first call reads the CPU
+ *      features, make it before the update runs on several threads.
+ *
+ * @param      bq        The Biquad instance
+ * @param[in]  n_ch      Channels, 1..BIQUAD_MAX_CHANNELS
+ * @param[in]  n_stages  Sections in series, 1..BIQUAD_MAX_STAGES
+ *
+ * @return     0, or -1 if n_ch or n_stages is out of range
+ */
+int16_t biquad_init(Biquad_Obj_t* const bq, uint16_t n_ch, uint16_t n_stages);
+
+/**
+ * @brief      Sets one stage of one channel, or of all channels with BIQUAD_ALL_CHANNELS
+ */
+void biquad_set_stage(Biquad_Obj_t* const bq, uint16_t stage, uint16_t ch, const Biquad_Coef_t* c);
+
+/**
+ * @brief      Sets the states to the steady state of a constant input
+ *
+ * @param[in]  x0    n_ch inputs, NULL for zero
+ */
+void biquad_reset(Biquad_Obj_t* const bq, const float32_t* x0);
+
+/**
+ * @brief      Biquad cascade update, all channels
+ *
+ * @param      bq    The Biquad instance
+ * @param[in]  x     n_ch inputs
+ * @param[out] y     n_ch outputs, may be x
+ *
+ *      AVX2 (all 8 lanes at once) or SSE (4 lanes) when the CPU has it,
+ *      biquad_update_scalar() otherwise and for objects of fewer than
+ *      BIQUAD_VECTOR_MIN_CH channels (one channel gains nothing from the lanes
+ *      and pays for the masks). biquad_init() makes the choice and stores it in
+ *      the object, the update is one indirect call. The lanes do the
+ *      same operations in the same order as biquad_update_scalar(), so the
+ *      results are bit-identical as long as the compiler does not contract to FMA.
+ */
+void biquad_update(Biquad_Obj_t* const bq, const float32_t* x, float32_t* y);
+
+/**
+ * @brief      Biquad cascade update, one channel after the other
+ */
+void biquad_update_scalar(Biquad_Obj_t* const bq, const float32_t* x, float32_t* y);
+
+/**
+ * @brief      Instruction set biquad_update() runs on: "avx2", "sse" or "scalar"
+ */
+const char* biquad_isa(void);
+
 #ifdef __cplusplus
 }
 #endif
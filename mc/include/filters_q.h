@@ -0,0 +1,54 @@
+/**
+ * @file       filters_q.h
+ *
+ * @brief      header file for the fixed-point filters
+ *
+ *      Q15/Q31 counterpart of filters.h, see fixedpoint.h.
+ */
+#ifndef FILTERS_Q_H_
+    #define FILTERS_Q_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "commontypes.h"
+#include "fixedpoint.h"
+
+// y(k) = b_1 y(k-1) + a_0 x(k) + a_1 x(k-1)
+//
+typedef struct
+{
+    // filter-1st data
+    q_t         y;
+    q_t         u;
+    // filter-1st param, |coefficient| < 1
+    q_t         a0;
+    q_t         a1;
+    q_t         b1;
+} Lpf1stq_Obj_t;
+
+
+/**
+ * @brief      first order lowpass filter init
+ *
+ *      Same arguments as lpf_1st_init(), the coefficients are converted to q_t.
+ */
+void lpf_1st_init_q(Lpf1stq_Obj_t* const lpf_1st_inst, q_t y, q_t u,
+                float32_t a0, float32_t a1, float32_t b1);
+
+/**
+ * @brief      first order lowpass filter update
+ *
+ * @param      lpf_1st_inst The LPF_1ST instance
+ *
+ *     The three products are summed in the wide type and rounded once; each is
+ *     pre-shifted by 2 bits so the sum cannot overflow for any coefficients.
+ */
+void lpf_1st_update_q(Lpf1stq_Obj_t* const lpf_1st_inst, q_t u);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // <-- !defined FILTERS_Q_H_
@@ -0,0 +1,177 @@
+/**
+ * @file       fixedpoint.h
+ * @date       Oct 2026
+ *
+ * @brief      header file for the fixed-point (Q15/Q31) arithmetic
+ *
+ *      Common types and saturating operations for the *_q kernels, which run the
+ *      control code on cores without an FPU. All signals are per-unit values in
+ *      [-1, 1); the format is fixed at compile time with MC_Q_BITS:
+ *        - 15: q_t is int16_t (Q15), products are formed in int32_t
+ *        - 31: q_t is int32_t (Q31), products are formed in int64_t
+ *
+ *      Every operation saturates to [Q_MIN, Q_MAX] instead of wrapping, and the
+ *      products are rounded to nearest. Gains are q_gain_t, a Q mantissa with a
+ *      power-of-two exponent, so gains above 1 and gains far below 1 keep their
+ *      significant bits. Accumulators that integrate such small gains use the
+ *      wide format, Q_WIDE_SHIFT more fractional bits in a q_acc_t.
+ *
+ *      Angles are q_t in units of PI: -1 is -PI, Q_MAX is just below +PI, so an
+ *      angle accumulator wraps around the circle by itself.
+ */
+#ifndef FIXEDPOINT_H_
+    #define FIXEDPOINT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "commontypes.h"
+#include "ctrl_common.h"
+
+#ifndef MC_Q_BITS
+    #define MC_Q_BITS               15
+#endif
+
+#if MC_Q_BITS == 15
+    typedef int16_t     q_t;
+    typedef int32_t     q_acc_t;
+    #define Q_MAX                   ((q_t)0x7FFF)
+    #define Q_MIN                   ((q_t)-0x8000)
+    #define Q_SCALE                 (32768.0)
+#elif MC_Q_BITS == 31
+    typedef int32_t     q_t;
+    typedef int64_t     q_acc_t;
+    #define Q_MAX                   ((q_t)0x7FFFFFFF)
+    #define Q_MIN                   ((q_t)(-0x7FFFFFFF - 1))
+    #define Q_SCALE                 (2147483648.0)
+#else
+    #error ERROR - MC_Q_BITS must be 15 or 31
+#endif
+
+/**
+ * @brief      Q constant from a literal, evaluated by the compiler
+ *
+ *      Rounds to nearest, 1.0 and above saturate to Q_MAX.
+ */
+#define Q_WIDE_SHIFT                (MC_Q_BITS - 1)     // wide format: q_t << Q_WIDE_SHIFT in q_acc_t
+
+#define Q_CONST(x)  ((q_t)((x) >= 1.0 ? Q_MAX : ((x) < -1.0 ? Q_MIN : \
+                        (x) * Q_SCALE + ((x) >= 0 ? 0.5 : -0.5))))
+
+// gain = m * 2^e, |m| < 1, -MC_Q_BITS < e < MC_Q_BITS
+//
+typedef struct
+{
+    q_t         m;
+    int16_t     e;
+} q_gain_t;
+
+typedef struct
+{
+    q_t         sin;
+    q_t         cos;
+} SinCos_q_t;
+
+/**
+ * @brief      Limit a wide intermediate to the q_t range
+ */
+MC_INLINE q_t q_sat(q_acc_t x)
+{
+    x = (x > Q_MAX) ? Q_MAX : x;
+    x = (x < Q_MIN) ? Q_MIN : x;
+    return (q_t)x;
+}
+
+MC_INLINE q_t q_add(q_t a, q_t b)
+{
+    return q_sat((q_acc_t)a + b);
+}
+
+MC_INLINE q_t q_sub(q_t a, q_t b)
+{
+    return q_sat((q_acc_t)a - b);
+}
+
+MC_INLINE q_t q_neg(q_t a)
+{
+    return q_sat(-(q_acc_t)a);
+}
+
+/**
+ * @brief      a * b, rounded; only -1 * -1 saturates
+ */
+MC_INLINE q_t q_mul(q_t a, q_t b)
+{
+    return q_sat(((q_acc_t)a * b + ((q_acc_t)1 << (MC_Q_BITS - 1))) >> MC_Q_BITS);
+}
+
+/**
+ * @brief      x * g for a gain g with exponent, rounded and saturated
+ */
+MC_INLINE q_t q_mul_gain(q_t x, q_gain_t g)
+{
+    int16_t shift = MC_Q_BITS - g.e;
+    return q_sat(((q_acc_t)x * g.m + ((q_acc_t)1 << (shift - 1))) >> shift);
+}
+
+/**
+ * @brief      x * g in the wide format, rounded
+ *
+ *      Keeps the Q_WIDE_SHIFT bits below the q_t LSB that q_mul_gain() rounds
+ *      away, e.g. for an integrator gain of 1e-5. Gains of 1 and above
+ *      (e > 0) have no such bits and go through q_mul_gain(), saturated.
+ */
+MC_INLINE q_acc_t q_mul_gain_wide(q_t x, q_gain_t g)
+{
+    int16_t shift = MC_Q_BITS - Q_WIDE_SHIFT - g.e;
+    if (shift > 0)
+    {
+        return ((q_acc_t)x * g.m + ((q_acc_t)1 << (shift - 1))) >> shift;
+    }
+    return (q_acc_t)q_mul_gain(x, g) * ((q_acc_t)1 << Q_WIDE_SHIFT);
+}
+
+/**
+ * @brief      Wide-format value to q_t, rounded and saturated
+ */
+MC_INLINE q_t q_from_wide(q_acc_t x)
+{
+    return q_sat((x + ((q_acc_t)1 << (Q_WIDE_SHIFT - 1))) >> Q_WIDE_SHIFT);
+}
+
+/**
+ * @brief      Float to q_t, rounded and saturated; for initialization and host code
+ */
+q_t q_from_float(float32_t x);
+
+/**
+ * @brief      q_t to float; for host code
+ */
+float32_t q_to_float(q_t x);
+
+/**
+ * @brief      Float to q_gain_t with the mantissa normalized to [0.5, 1)
+ *
+ *      Gains of 2^(MC_Q_BITS - 1) and above saturate; below 1 the exponent goes
+ *      negative, down to 1 - MC_Q_BITS, so a gain of 1e-5 keeps a full-width
+ *      mantissa instead of rounding to 0.
+ */
+q_gain_t q_gain_from_float(float32_t g);
+
+/**
+ * @brief      sine and cosine of a per-unit angle
+ *
+ * @param[in]  theta  The angle in units of PI, see the file comment
+ * @param[out] sc     sin(theta*PI) and cos(theta*PI)
+ *
+ *      257-entry quarter-wave Q31 table with linear interpolation: within 1 LSB in
+ *      Q15, worst-case error 4.7e-6 in Q31 (bench/q_accuracy).
+ */
+void q_sincos(q_t theta, SinCos_q_t *sc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // <-- !defined FIXEDPOINT_H_
@@ -0,0 +1,82 @@
+/**
+ * @file        foc.h
+ * @date        Oct 2026
+ *
+ * @brief      header file for the fused FOC current loop
+ *
+ *      One current-loop tick in a single call: Clarke -> Park -> d/q PI ->
+ *      inverse Park -> SVM. It computes the same result as chaining abc2AB0(),
+ *      AB02dq0(), PID_Update() twice, dq02AB0() and modulator(), but the angle's
+ *      sin/cos is evaluated once and the intermediate alpha/beta/d/q values stay
+ *      in locals instead of going through Transform_Obj_t. In DPWM_ADAPTIVE the
+ *      rule follows the angle between the d/q voltage and current of the tick,
+ *      see svm_set_load_vectors().
+ */
+
+#ifndef FOC_H_
+    #define FOC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "commontypes.h"
+#include "ctrl_common.h"
+#include "pid.h"
+#include "svm.h"
+
+// everything foc_current_step() touches, in two cache lines with MC_PID_LEGACY=0
+// (three with the legacy PI fields): the PI gains and limits are read every tick,
+// the PI design values (PID_Cfg_t) are not here
+typedef struct MC_ALIGNED(MC_CACHE_LINE)
+{
+    PID_Obj_t     pid_d;      // d-axis current controller, output vd
+    PID_Obj_t     pid_q;      // q-axis current controller, output vq
+    SVM_t         svm;
+    // last measured currents, kept for observation only
+    float32_t     id;
+    float32_t     iq;
+    SVM_mode_t    mode;
+    int16_t       numSensors; // 2(phase a,b) or 3(phase a,b,c)
+} FOC_Obj_t;
+
+/**
+ * @brief      FOC current loop initialization
+ *
+ *      Clears the controller states. The PI gains and limits are set afterwards with
+ *      PID_Param_Init() on foc_inst->pid_d and foc_inst->pid_q.
+ *
+ * @param      foc_inst    The FOC instance
+ * @param[in]  numSensors  The number of current sensors, 2(phase a,b) or 3(phase a,b,c)
+ * @param[in]  mode        The SVM mode
+ *
+ * @return     0, or -1 if numSensors is neither 2 nor 3
+ */
+int16_t foc_init(FOC_Obj_t* const foc_inst, int16_t numSensors, SVM_mode_t mode);
+
+/**
+ * @brief      One FOC current-loop tick
+ *
+ * @param      foc_inst  The FOC instance
+ * @param[in]  ia        Phase a current
+ * @param[in]  ib        Phase b current
+ * @param[in]  ic        Phase c current, ignored with 2 sensors
+ * @param[in]  theta_e   The electrical angle
+ * @param[in]  id_ref    The d-axis current reference
+ * @param[in]  iq_ref    The q-axis current reference
+ * @param[out] duty      Duty cycles of phase a, b, c
+ */
+void foc_current_step(FOC_Obj_t* const foc_inst,
+    float32_t ia,
+    float32_t ib,
+    float32_t ic,
+    float32_t theta_e,
+    float32_t id_ref,
+    float32_t iq_ref,
+    float32_t duty[3]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //<- !defined FOC_H_
@@ -0,0 +1,186 @@
+/**
+ * @file        instrument.h
+ * @date        Oct 2026
+ *
+ * @brief      header file for the compile-time cycle instrumentation of the kernels
+ *
+ *      With MC_INSTRUMENT=1 every call of modulator(), PID_Update(), the Clarke/Park
+ *      transforms, lpf_1st_update(), biquad_update(), decim_cic_process(), the
+ *      adc_clarke() front end and the fused foc_current_step() and
+ *      drive_bank_step() reads the cycle counter on entry and exit and adds
+ *      the difference to the kernel's MC_Instr_Stat_t: count, min, max, sum and a
+ *      log2 histogram. With MC_INSTRUMENT=0 (default) MC_INSTR_BEGIN/END expand to
+ *      nothing and the kernels compile exactly as before.
+ *
+ *      The counter is MC_CYCLE_COUNTER(), a 32-bit free-running count:
+ *        - x86 hosts         __rdtsc(), reference cycles
+ *        - AArch64 hosts     CNTVCT_EL0, the generic timer
+ *        - anything else     define MC_CYCLE_COUNTER() for the target, e.g.
+ *                            -D"MC_CYCLE_COUNTER()=(DWT->CYCCNT)" on Cortex-M,
+ *                            or set a function with mc_instr_set_counter()
+ *      A recording costs two counter reads plus ~10 instructions; what a full
+ *      empty BEGIN/END record adds to a measurement around it is returned by
+ *      mc_instr_overhead() and is not subtracted from the statistics. The
+ *      kernels do not nest records, so no call is counted twice.
+ *
+ *      The statistics are global and not thread-safe: one control context.
+ */
+
+#ifndef INSTRUMENT_H_
+    #define INSTRUMENT_H_
+
+#include "commontypes.h"
+#include "ctrl_common.h"
+
+#ifndef MC_INSTRUMENT
+    #define MC_INSTRUMENT           0
+#endif
+
+#if MC_INSTRUMENT && !defined(MC_CYCLE_COUNTER)
+    #if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+        #include <x86intrin.h>
+    #elif defined(_M_X64) || defined(_M_IX86)
+        #include <intrin.h>
+    #endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum
+{
+    MC_INSTR_MODULATOR = 0,
+    MC_INSTR_PID_UPDATE,
+    MC_INSTR_ABC2AB0,
+    MC_INSTR_AB02ABC,
+    MC_INSTR_AB02DQ0,
+    MC_INSTR_AB02DQ0_SINCOS,
+    MC_INSTR_DQ02AB0,
+    MC_INSTR_DQ02AB0_SINCOS,
+    MC_INSTR_LPF_1ST_UPDATE,
+    MC_INSTR_BIQUAD_UPDATE,
+    MC_INSTR_DECIM_CIC_PROCESS,
+    MC_INSTR_ADC_CLARKE,
+    MC_INSTR_ADC_CLARKE_BATCH,
+    MC_INSTR_DRIVE_BANK_STEP,
+    MC_INSTR_FOC_CURRENT_STEP,
+    MC_INSTR_NUM,
+} MC_Instr_Id_t;
+
+#define MC_INSTR_HIST_BINS          16  // bin k: 2^k <= cycles < 2^(k+1), the last bin open-ended
+
+typedef struct
+{
+    uint32_t            count;
+    uint32_t            min;
+    uint32_t            max;
+    unsigned long long  sum;
+    uint32_t            hist[MC_INSTR_HIST_BINS];
+} MC_Instr_Stat_t;
+
+/**
+ * @brief      Clears the statistics of all kernels
+ */
+void mc_instr_reset(void);
+
+/**
+ * @brief      Statistics of one kernel
+ *
+ * @param[in]  id    The kernel
+ */
+const MC_Instr_Stat_t* mc_instr_get(MC_Instr_Id_t id);
+
+/**
+ * @brief      Kernel name, as used by mc_instr_report()
+ *
+ * @param[in]  id    The kernel
+ */
+const char* mc_instr_name(MC_Instr_Id_t id);
+
+/**
+ * @brief      Counter ticks an empty MC_INSTR_BEGIN/END record adds to a measurement
+ *             around it, minimum of 64 runs
+ *
+ *      Both counter reads and the statistics update, less the cost of the
+ *      measurement around it. 0 when the instrumentation is compiled out.
+ */
+uint32_t mc_instr_overhead(void);
+
+/**
+ * @brief      Prints count, min/mean/max and the non-empty histogram bins of
+ *             every kernel that ran
+ *
+ * @param[in]  print  printf-like output, e.g. printf or Qspice's Display
+ */
+void mc_instr_report(int (*print)(const char *format, ...));
+
+/**
+ * @brief      Counter function for targets without a built-in counter and
+ *             without MC_CYCLE_COUNTER(); NULL reads 0
+ */
+void mc_instr_set_counter(uint32_t (*counter)(void));
+
+#if MC_INSTRUMENT
+
+    #if defined(MC_CYCLE_COUNTER)
+        // target provided
+    #elif (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+        #define MC_CYCLE_COUNTER()      ((uint32_t)__rdtsc())
+    #elif defined(_M_X64) || defined(_M_IX86)
+        #define MC_CYCLE_COUNTER()      ((uint32_t)__rdtsc())
+    #elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+        MC_INLINE uint32_t mc_cntvct(void)
+        {
+            unsigned long long t;
+            __asm__ volatile("mrs %0, cntvct_el0" : "=r"(t));
+            return (uint32_t)t;
+        }
+        #define MC_CYCLE_COUNTER()      mc_cntvct()
+    #else
+        extern uint32_t (*mc_instr_counter)(void);
+        #define MC_CYCLE_COUNTER()      (mc_instr_counter())
+    #endif
+
+    extern MC_Instr_Stat_t mc_instr_stats[MC_INSTR_NUM];
+
+    MC_INLINE uint32_t mc_instr_bin(uint32_t cycles)
+    {
+        uint32_t bin;
+    #if defined(__GNUC__) || defined(__clang__)
+        bin = 31u - (uint32_t)__builtin_clz(cycles | 1u);
+    #else
+        bin = 0;
+        while ((cycles >>= 1) != 0) {
+            bin++;
+        }
+    #endif
+        return bin < MC_INSTR_HIST_BINS ? bin : MC_INSTR_HIST_BINS - 1;
+    }
+
+    MC_INLINE void mc_instr_record(MC_Instr_Id_t id, uint32_t cycles)
+    {
+        MC_Instr_Stat_t* s = &mc_instr_stats[id];
+
+        s->count++;
+        s->sum += cycles;
+        s->min = cycles < s->min ? cycles : s->min;
+        s->max = cycles > s->max ? cycles : s->max;
+        s->hist[mc_instr_bin(cycles)]++;
+    }
+
+    #define MC_INSTR_BEGIN(id)      const uint32_t mc_instr_t0_##id = MC_CYCLE_COUNTER()
+    #define MC_INSTR_END(id)        mc_instr_record((id), MC_CYCLE_COUNTER() - mc_instr_t0_##id)
+
+#else
+
+    #define MC_INSTR_BEGIN(id)
+    #define MC_INSTR_END(id)
+
+#endif // MC_INSTRUMENT
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //<- !defined INSTRUMENT_H_
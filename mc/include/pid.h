@@ -21,42 +21,80 @@ extern "C" {
 #include "ctrl_common.h"
 #include "commontypes.h"
 
+// MC_PID_LEGACY=1 (default) keeps the fields PID_Obj_t had before the hot/cold
+// split (Ts, Ti, Td, err_k1, uff), after the hot ones, so wrappers that read them
+// still build; MC_PID_LEGACY=0 drops them when the owner keeps a PID_Cfg_t
+#ifndef MC_PID_LEGACY
+    #define MC_PID_LEGACY           1
+#endif
+
 //*****************************************************************************
 //
 //! \brief Defines the PID controller object
+//!
+//! What PID_Update() reads or writes every call comes first: 44 bytes, within
+//! one cache line when the owner is MC_CACHE_LINE aligned. The design values
+//! the gains come from (Ts, Ti, Td) are cold and live in PID_Cfg_t; with
+//! MC_PID_LEGACY (the default) they are also kept here, behind the hot fields,
+//! and MC_PID_LEGACY=0 leaves the 44 bytes alone.
 //
 //*****************************************************************************
 typedef struct
 {
 	// PID datas
-	float32_t	  err;        // error
-    float32_t     err_k1;     // error(k-1)
+	float32_t	  err;        // error, err(k-1) of the next update
     float32_t     ui;         // integral output
 	float32_t     u;          // output 
-    float32_t     uff;        // feedforward
     float32_t     err_aw;     // anti-windup error
 	// PID params
 	float32_t     OutHiLim;
 	float32_t     OutLoLim;
 	float32_t     IntRateLim;
 	float32_t     Kp;
-	float32_t     Ts;
-    float32_t     Ti;
     float32_t     Ki;     // discrete Ki=Kp*Ts/Ti
-    float32_t     Td;
     float32_t     Kd;     // discrete Kd=Kp*Td/Ts
     float32_t     Kp_aw;  // anti-windup gain
+#if MC_PID_LEGACY
+	// legacy fields, written by PID_Data_Init()/PID_Param_Init()/PID_Cfg_Apply(), never read
+	float32_t     Ts;
+    float32_t     Ti;
+    float32_t     Td;
+    float32_t     err_k1; // never written, as before
+    float32_t     uff;    // the uff of PID_Data_Init()
+#endif
 } PID_Obj_t;
 
+//*****************************************************************************
+//
+//! \brief Defines the PID controller design parameters
+//!
+//! The arguments of PID_Param_Init(), for owners that keep them to report or
+//! re-tune the controller; PID_Update() never reads them.
+//
+//*****************************************************************************
+typedef struct
+{
+	float32_t     OutHiLim;
+	float32_t     OutLoLim;
+	float32_t     IntRateLim;
+	float32_t     Kp;
+	float32_t     Ts;
+    float32_t     Ti;
+    float32_t     Td;
+    float32_t     Kp_aw;
+    uint8_t       Ki_enable;
+    uint8_t       Kd_enable;
+} PID_Cfg_t;
+
 /**
  * @brief      PID controller data initialization
  * 
  * @param[in]  PID_inst     The PID instance
  * @param[in]  err          The error
- * @param[in]  err_k1       The error(k-1)
  * @param[in]  ui           The integral
  * @param[in]  u            The output
- * @param[in]  uff          The feedforward, add to output before anti-windup
+ * @param[in]  uff          Not used, the feedforward is an argument of PID_Update();
+ *                          kept in PID_inst->uff with MC_PID_LEGACY
  * @param[in]  err_aw       The anti-windup error
  */
 void PID_Data_Init(PID_Obj_t* const PID_inst,
@@ -93,6 +131,16 @@ void PID_Param_Init(PID_Obj_t* const PID_inst,
     int16_t   Kd_enable,
     float32_t Kp_aw);
 
+/**
+ * @brief      PID controller parameters initialization from a kept configuration
+ *
+ *      Same as PID_Param_Init() with the fields of cfg as arguments.
+ *
+ * @param      PID_inst     The PID instance
+ * @param[in]  cfg          The design parameters
+ */
+void PID_Cfg_Apply(PID_Obj_t* const PID_inst, const PID_Cfg_t* cfg);
+
 
 /**
  * @brief      PID controller update
@@ -105,6 +153,83 @@ void PID_Param_Init(PID_Obj_t* const PID_inst,
  */
 void PID_Update(PID_Obj_t* const PID_inst,  float32_t ref, float32_t fb, float32_t uff);
 
+/**
+ * @brief      PID controller update specialized at compile time, see pid.hpp
+ *
+ *      Same arguments as PID_Update(); the terms outside the policy are left out:
+ *        - PID_Update_P()    proportional only, Ki/Kd/Kp_aw/IntRateLim/uff unused
+ *        - PID_Update_PI()   PI with anti-windup and integral rate limit, Kd/uff unused
+ *        - PID_Update_PID()  every term, the same as PID_Update()
+ */
+void PID_Update_P(PID_Obj_t* const PID_inst, float32_t ref, float32_t fb, float32_t uff);
+void PID_Update_PI(PID_Obj_t* const PID_inst, float32_t ref, float32_t fb, float32_t uff);
+void PID_Update_PID(PID_Obj_t* const PID_inst, float32_t ref, float32_t fb, float32_t uff);
+
+/**
+ * @brief      PID controller update, inline version
+ *
+ * @param      PID_inst The PID instance
+ * @param[in]  ref      The reference
+ * @param[in]  fb       The feedback
+ * @param[in]  uff      The feedforward
+ *
+ * @return     The limited control output, also stored in PID_inst->u
+ *
+ *      Same computation as PID_Update(), for fused kernels that want to keep the
+ *      output in a register instead of reading it back from the instance.
+ */
+MC_INLINE float32_t PID_Update_Inline(PID_Obj_t* const PID_inst, float32_t ref, float32_t fb, float32_t uff)
+{
+    float32_t err = ref - fb;
+    float32_t err_k1 = PID_inst->err;
+    float32_t err_aw = PID_inst->err_aw;
+    float32_t ui = PID_inst->ui;
+    float32_t u;
+    float32_t u_sat;
+
+    // compute the incremental proportional output
+    // 
+    float32_t up = PID_inst->Kp * err;
+
+    // compute the incremental integral output with anti-windup calculation applied
+    // 
+    float32_t delta_ui = (PID_inst->Ki * (err+err_k1)/2) + (PID_inst->Kp_aw * err_aw);
+
+    // integral change rate limitation
+    // 
+    SATURATE(delta_ui, PID_inst->IntRateLim, -PID_inst->IntRateLim);
+
+    ui += delta_ui;
+
+    SATURATE(ui, PID_inst->OutHiLim, PID_inst->OutLoLim);
+
+    PID_inst->ui = ui;
+
+    // comput the incremental derivative output
+    // 
+    float32_t ud = PID_inst->Kd*(err - err_k1);
+
+    // compute the control output
+    // 
+    u = up + ui + ud + uff;
+
+    // control output limitation
+    // 
+    u_sat = u;
+    SATURATE(u_sat, PID_inst->OutHiLim, PID_inst->OutLoLim);
+    PID_inst->u = u_sat;
+
+    // update anti-windup error for next iteration
+    // 
+    PID_inst->err_aw = u_sat - u;
+
+    // update the error history
+    //
+    PID_inst->err = err;
+
+    return u_sat;
+} //<- end of PID_Update_Inline()
+
 #ifdef __cplusplus
 }
 #endif
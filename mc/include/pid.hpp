@@ -0,0 +1,117 @@
+/**
+ * @file       pid.hpp
+ * @date       Oct 2026
+ *
+ * @brief      header-only PID controller specialized at compile time
+ *
+ *      Pid<Policy> runs the PID_Update() control law on the same PID_Obj_t, but the
+ *      terms the policy leaves out are not compiled in: no multiply by a zero Ki/Kd,
+ *      no clamp that cannot trigger, no error history nobody reads. Policies:
+ *        - integral      Ki term and the integrator clamp to the output limits
+ *        - derivative    Kd term
+ *        - anti_windup   Kp_aw back-calculation into the integral
+ *        - rate_limit    IntRateLim clamp on the integral increment
+ *        - feedforward   uff added to the output
+ *
+ *      With the disabled gains set to zero (Ki, Kd, Kp_aw) and ui starting at zero,
+ *      the output equals PID_Update() bit for bit. Pid<Policy> adds no members to
+ *      PID_Obj_t, so the C API (PID_Data_Init(), PID_Param_Init()) works on it as is,
+ *      and the C wrappers PID_Update_P/PI/PID() in pid.h expose the common policies.
+ */
+#ifndef PID_HPP_
+    #define PID_HPP_
+
+#include <type_traits>
+
+#include "pid.h"
+
+namespace mc {
+
+template <bool Integral, bool Derivative, bool AntiWindup, bool RateLimit, bool FeedForward>
+struct PidPolicy
+{
+    static constexpr bool integral    = Integral;
+    static constexpr bool derivative  = Derivative;
+    static constexpr bool anti_windup = AntiWindup;
+    static constexpr bool rate_limit  = RateLimit;
+    static constexpr bool feedforward = FeedForward;
+
+    static_assert(Integral || (!AntiWindup && !RateLimit),
+                  "anti-windup and the rate limit act on the integral");
+};
+
+//                        I      D      AW     RL     FF
+using PidP   = PidPolicy<false, false, false, false, false>;
+using PidPI  = PidPolicy<true,  false, true,  true,  false>;    // current loop
+using PidPID = PidPolicy<true,  true,  true,  true,  true>;     // all of PID_Update()
+
+template <class Policy>
+struct Pid : PID_Obj_t
+{
+    /**
+     * @brief      PID controller update
+     *
+     * @param      s     The PID instance
+     * @param[in]  ref   The reference
+     * @param[in]  fb    The feedback
+     * @param[in]  uff   The feedforward, ignored unless Policy::feedforward
+     *
+     * @return     The limited control output, also stored in s.u
+     */
+    static float32_t update(PID_Obj_t& s, float32_t ref, float32_t fb, float32_t uff = 0.0f)
+    {
+        float32_t err = ref - fb;
+        float32_t u = s.Kp * err;
+
+        if constexpr (Policy::integral) {
+            float32_t err_k1 = s.err;
+            float32_t delta_ui = s.Ki * (err + err_k1) / 2;
+
+            if constexpr (Policy::anti_windup) {
+                delta_ui = delta_ui + (s.Kp_aw * s.err_aw);
+            }
+            if constexpr (Policy::rate_limit) {
+                SATURATE(delta_ui, s.IntRateLim, -s.IntRateLim);
+            }
+
+            float32_t ui = s.ui + delta_ui;
+            SATURATE(ui, s.OutHiLim, s.OutLoLim);
+            s.ui = ui;
+
+            u = u + ui;
+        }
+
+        if constexpr (Policy::derivative) {
+            u = u + s.Kd * (err - s.err);
+        }
+
+        if constexpr (Policy::feedforward) {
+            u = u + uff;
+        }
+
+        float32_t u_sat = u;
+        SATURATE(u_sat, s.OutHiLim, s.OutLoLim);
+        s.u = u_sat;
+
+        if constexpr (Policy::anti_windup) {
+            s.err_aw = u_sat - u;
+        }
+        if constexpr (Policy::integral || Policy::derivative) {
+            s.err = err;
+        }
+
+        return u_sat;
+    }
+
+    float32_t update(float32_t ref, float32_t fb, float32_t uff = 0.0f)
+    {
+        return update(*this, ref, fb, uff);
+    }
+};
+
+static_assert(sizeof(Pid<PidPID>) == sizeof(PID_Obj_t) && std::is_standard_layout<Pid<PidPID>>::value,
+              "Pid<> must stay layout-compatible with PID_Obj_t");
+
+} // namespace mc
+
+#endif // <-- !defined PID_HPP_
@@ -0,0 +1,96 @@
+/**
+ * @file        pid_q.h
+ * @date        Oct 2026
+ *
+ * @brief      header file for the fixed-point PID Controller
+ *
+ *      Q15/Q31 counterpart of pid.h, see fixedpoint.h. The control law, the
+ *      integral rate limit, the output limits and the anti-windup are the same as
+ *      PID_Update(); signals are per-unit q_t and the gains are q_gain_t. The
+ *      integral is kept in the wide format of fixedpoint.h, so discrete Ki far
+ *      below 1 LSB per unit of error (Kp*Ts/Ti of 1e-6..1e-3) still integrates.
+ */
+
+#ifndef PID_Q_H_
+    #define PID_Q_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "commontypes.h"
+#include "fixedpoint.h"
+
+//*****************************************************************************
+//
+//! \brief Defines the fixed-point PID controller object
+//
+//*****************************************************************************
+typedef struct
+{
+    // PID datas
+    q_acc_t       ui_w;       // integral, wide format
+    q_t           err;        // error
+    q_t           ui;         // integral output, ui_w rounded
+    q_t           u;          // output
+    q_t           err_aw;     // anti-windup error
+    // PID params
+    q_t           OutHiLim;
+    q_t           OutLoLim;
+    q_t           IntRateLim;
+    q_gain_t      Kp;
+    q_gain_t      Ki;         // discrete Ki=Kp*Ts/Ti
+    q_gain_t      Kd;         // discrete Kd=Kp*Td/Ts
+    q_gain_t      Kp_aw;      // anti-windup gain
+} PIDq_Obj_t;
+
+/**
+ * @brief      PID controller data initialization
+ *
+ * @param[in]  PID_inst     The PID instance
+ * @param[in]  err          The error
+ * @param[in]  ui           The integral
+ * @param[in]  u            The output
+ * @param[in]  uff          Not kept, the feedforward is an argument of PID_Update_q()
+ * @param[in]  err_aw       The anti-windup error
+ */
+void PID_Data_Init_q(PIDq_Obj_t* const PID_inst,
+    q_t err,
+    q_t ui,
+    q_t u,
+    q_t uff,
+    q_t err_aw);
+
+/**
+ * @brief      PID controller parameters initialization
+ *
+ *      Same arguments as PID_Param_Init(), in per-unit float; the discrete gains are
+ *      computed once here and converted to q_gain_t.
+ */
+void PID_Param_Init_q(PIDq_Obj_t* const PID_inst,
+    float32_t OutHiLim,
+    float32_t OutLoLim,
+    float32_t IntRateLim,
+    float32_t Kp,
+    float32_t Ts,
+    float32_t Ti,
+    int16_t   Ki_enable,
+    float32_t Td,
+    int16_t   Kd_enable,
+    float32_t Kp_aw);
+
+/**
+ * @brief      PID controller update
+ *
+ * @param      PID_inst The PID instance
+ * @param[in]  ref      The reference
+ * @param[in]  fb       The feedback
+ * @param[in]  uff      The feedforward
+ */
+void PID_Update_q(PIDq_Obj_t* const PID_inst, q_t ref, q_t fb, q_t uff);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //<- !defined PID_Q_H_
@@ -0,0 +1,83 @@
+/**
+ * @file        pll.h
+ * @date        Oct 2026
+ *
+ * @brief      header file for the quadrature PLL angle/speed tracker
+ *
+ *      Tracks the angle of a quadrature pair x_sin = A sin(theta), x_cos = A cos(theta)
+ *      without atan2: the phase error
+ *
+ *          eps = x_sin * cos(theta_e) - x_cos * sin(theta_e) = A sin(theta - theta_e)
+ *
+ *      goes through a PI loop filter (PID_Obj_t, PID_Update()) to the speed, which is
+ *      integrated into theta_e. One sin/cos of theta_e per update, kept in pll->sc,
+ *      serves both the next phase error and the caller's Park transforms:
+ *
+ *          AB02dq0_sincos(&T, &pll.sc);    // same as AB02dq0(&T, pll.theta_e)
+ *
+ *      Typical inputs:
+ *        - sin/cos encoder or resolver:    pll_update(&pll, sin_signal, cos_signal)
+ *        - back-EMF e = w*psi*(-sin, cos): pll_update(&pll, -e_alpha, e_beta)
+ *      The loop gain is proportional to A, so the gains hold for one amplitude.
+ */
+
+#ifndef PLL_H_
+    #define PLL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "commontypes.h"
+#include "filters.h"
+#include "pid.h"
+#include "trig.h"
+
+typedef struct
+{
+    PID_Obj_t       pid;        // loop filter, phase error -> speed
+    Lpf1st_Obj_t    lpf_omega;  // speed output filter
+    float32_t       Ts;
+    float32_t       err;        // last phase error
+    float32_t       omega;      // loop filter output, rad/s
+    float32_t       omega_f;    // filtered speed, rad/s
+    float32_t       theta_e;    // tracked angle, [0, 2*PI)
+    SinCos_t        sc;         // sin/cos of theta_e
+} PLL_Obj_t;
+
+/**
+ * @brief      PLL tracker initialization
+ *
+ * @param      pll_inst   The PLL instance
+ * @param[in]  Ts         Update period, s
+ * @param[in]  Kp         Loop filter proportional gain, rad/s per unit of A
+ * @param[in]  Ki         Loop filter integral gain, rad/s^2 per unit of A, 0 for P only
+ * @param[in]  omega_max  Speed limit, rad/s; omega_max*Ts must stay below PI
+ * @param[in]  wc         Cutoff of the speed output filter, rad/s
+ */
+void pll_init(PLL_Obj_t* const pll_inst,
+    float32_t Ts,
+    float32_t Kp,
+    float32_t Ki,
+    float32_t omega_max,
+    float32_t wc);
+
+/**
+ * @brief      Restart the tracker at a known angle and speed
+ */
+void pll_reset(PLL_Obj_t* const pll_inst, float32_t theta_e, float32_t omega);
+
+/**
+ * @brief      PLL tracker update
+ *
+ * @param      pll_inst  The PLL instance
+ * @param[in]  x_sin     A sin(theta)
+ * @param[in]  x_cos     A cos(theta)
+ */
+void pll_update(PLL_Obj_t* const pll_inst, float32_t x_sin, float32_t x_cos);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //<- !defined PLL_H_
@@ -1,11 +1,106 @@
 #pragma once
 
+/**
+ * @file        smo.h
+ * @date        Oct 2026
+ *
+ * @brief      header file for the sliding-mode back-EMF observer
+ *
+ *      Sensorless rotor angle and speed of a PMSM/BLDC from the alpha/beta voltages
+ *      and currents. A current observer of the stator model
+ *
+ *          L di/dt = v - R i - e
+ *
+ *      is driven by z = k_slide * H(i_est - i), which at the sliding surface equals
+ *      the back-EMF e. H is a smooth switching function with a boundary layer phi
+ *      (SMO_SWITCH selects saturation or a cubic sigmoid), z is low-pass filtered
+ *      into e_est with Lpf1st_Obj_t, and the PLL tracker of pll.h locks onto e_est
+ *      for the speed and angle. The output angle adds the filter lag atan(omega/wc)
+ *      back (polynomial, |omega| <= wc).
+ *
+ *      smo_update() has no division and no libm call; the reciprocals are taken
+ *      once in smo_init(). k_slide must exceed the largest back-EMF amplitude.
+ */
+
+#include "commontypes.h"
+#include "ctrl_common.h"
+#include "filters.h"
+#include "pll.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#define SMO_SWITCH_SAT              0   // H(x) = x/phi limited to [-1, 1]
+#define SMO_SWITCH_SIGMOID          1   // same, then y*(3 - y^2)/2: C1 at the layer edge
+
+#ifndef SMO_SWITCH
+    #define SMO_SWITCH              SMO_SWITCH_SAT
+#endif
+
+// one update reads and writes all of it: three cache lines
+typedef struct MC_ALIGNED(MC_CACHE_LINE)
+{
+    // current observer
+    float32_t       F;          // 1 - R*Ts/L
+    float32_t       G;          // Ts/L
+    float32_t       k_slide;    // switching gain
+    float32_t       phi_rec;    // 1/boundary layer
+    float32_t       i_est[2];   // estimated i_alpha, i_beta
+    float32_t       z[2];       // switching term
+    // back-EMF filter
+    Lpf1st_Obj_t    lpf_e[2];
+    float32_t       wc_rec;     // 1/filter cutoff, for the lag compensation
+    // angle tracker, locked onto the filtered back-EMF
+    PLL_Obj_t       pll;
+    // outputs
+    float32_t       e[2];       // estimated e_alpha, e_beta
+    float32_t       omega;      // electrical speed, filtered, rad/s
+    float32_t       theta;      // electrical angle incl. filter lag, [0, 2*PI)
+} SMO_Obj_t;
+
+/**
+ * @brief      sliding-mode observer initialization
+ *
+ * @param      smo_inst  The SMO instance
+ * @param[in]  Rs        Stator resistance, ohm
+ * @param[in]  Ls        Stator inductance, H
+ * @param[in]  Ts        Sample time, s
+ * @param[in]  k_slide   Switching gain, V, above the largest back-EMF
+ * @param[in]  phi       Boundary layer of the switching function, A
+ * @param[in]  wc        Back-EMF filter cutoff, rad/s
+ * @param[in]  Kp        Angle tracker proportional gain, rad/s per V
+ * @param[in]  Ki        Angle tracker integral gain, rad/s^2 per V
+ * @param[in]  omega_max Electrical speed limit of the tracker, rad/s
+ *
+ *      The tracker's speed output filter uses the back-EMF cutoff wc as well.
+ */
+void smo_init(SMO_Obj_t* const smo_inst,
+    float32_t Rs,
+    float32_t Ls,
+    float32_t Ts,
+    float32_t k_slide,
+    float32_t phi,
+    float32_t wc,
+    float32_t Kp,
+    float32_t Ki,
+    float32_t omega_max);
+
+/**
+ * @brief      sliding-mode observer update, once per current-loop period
+ *
+ * @param      smo_inst  The SMO instance
+ * @param[in]  v_alpha   Applied alpha voltage of the last period
+ * @param[in]  v_beta    Applied beta voltage of the last period
+ * @param[in]  i_alpha   Measured alpha current
+ * @param[in]  i_beta    Measured beta current
+ */
+void smo_update(SMO_Obj_t* const smo_inst,
+    float32_t v_alpha,
+    float32_t v_beta,
+    float32_t i_alpha,
+    float32_t i_beta);
 
 #ifdef __cplusplus
 }
-#endif // __cplusplus
\ No newline at end of file
+#endif // __cplusplus
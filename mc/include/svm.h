@@ -6,21 +6,156 @@
 extern "C" {
 #endif
 
+	/*!
+	*
+	* @brief		SVM mode: a zero-sequence rule, optionally or'ed with an overmodulation rule
+	*
+	*				The zero-sequence rules pick, per 30 degree sector, the centred (SVPWM)
+	*				zero sequence or one that clamps a phase to the negative (V0min) or
+	*				positive (V0max) rail, from a table row: changing the mode changes the
+	*				row, not the code that runs.
+	*				  SVPWM				centred, continuous
+	*				  DMPWM3			clamps each phase 30 to 60 degrees either side of its peaks
+	*				  DPWMMIN			always clamps to the negative rail (120 degrees per phase)
+	*				  DPWMMAX			always clamps to the positive rail
+	*				  DPWM0				60 degree clamp windows 30 degrees ahead of each phase peak
+	*				  DPWM1				60 degree clamp windows centred on each phase peak
+	*				  DPWM2				60 degree clamp windows 30 degrees behind each phase peak
+	*				  DPWM_ADAPTIVE		DPWM0, DPWM1 or DPWM2, whichever centres the clamp window
+	*									on the current peak, see svm_set_load_angle()
+	*
+	*				The overmodulation rules apply only to references outside the hexagon
+	*				(d1 + d2 > 1), where there is no zero vector left to choose:
+	*				  SVM_OVM_CLAMP		the duties are limited to [0, 1] per phase (default)
+	*				  SVM_OVM_MPE		minimum phase error: the reference is scaled onto the
+	*									hexagon, the angle is kept
+	*				  SVM_OVM_MME		minimum magnitude error: the reference is projected
+	*									orthogonally onto the nearest hexagon side, ending on
+	*									a vertex (six-step) for large references
+	*/
 	typedef enum
 	{
 		SVPWM = 0,
         DMPWM3 = 1,
+		DPWMMIN = 2,
+		DPWMMAX = 3,
+		DPWM0 = 4,
+		DPWM1 = 5,
+		DPWM2 = 6,
+		DPWM_ADAPTIVE = 7,
+        SVM_MODE_NUM,
+		SVM_OVM_CLAMP = 0x00,
+		SVM_OVM_MPE = 0x10,
+		SVM_OVM_MME = 0x20,
 	} SVM_mode_t;
-	
+
+	#define SVM_ZS_MASK				0x0F	// zero-sequence rule bits of SVM_mode_t
+	#define SVM_OVM_MASK			0x30	// overmodulation rule bits of SVM_mode_t
+	#define SVM_MODE(zs, ovm)		((SVM_mode_t)((zs) | (ovm)))
+	#define SVM_ADAPT_HYST			(0.0872665F)	// rad, 5 degrees, see svm_set_load_angle()
+
 	typedef struct
 	{
 		float32_t		UAB[2];
-		int16_t			sector;
 		float32_t		m[3];
-	} SVM_t;
+		int16_t			sector;
+		int16_t			zs_shift;	// DPWM_ADAPTIVE: -1 DPWM0, 0 DPWM1, +1 DPWM2
+	} SVM_t;						// the 16-bit fields last: 24 bytes, no padding
 
 	void modulator(SVM_t* svm, const float32_t Ualpha, const float32_t Ubeta, SVM_mode_t mode);
 
+	/*!
+	*
+	* @brief		modulator() with the mode fixed at compile time, see svm.hpp
+	*
+	*				Same arguments and results as modulator(svm, Ualpha, Ubeta, SVPWM)
+	*				and modulator(svm, Ualpha, Ubeta, DMPWM3), without the mode checks.
+	*/
+	void modulator_SVPWM(SVM_t* svm, const float32_t Ualpha, const float32_t Ubeta);
+	void modulator_DMPWM3(SVM_t* svm, const float32_t Ualpha, const float32_t Ubeta);
+
+	/*!
+	*
+	* @brief		Sets the rule DPWM_ADAPTIVE modulates with from the load angle
+	* @param[in]	svm: SVM_t structure, zs_shift is 0 (DPWM1) when zero-initialised
+	* @param[in]	phi: angle by which the phase current lags the phase voltage, rad
+	*
+	*				DPWM0 below -15 degrees, DPWM2 above +15 degrees, DPWM1 in between,
+	*				with SVM_ADAPT_HYST of hysteresis around the thresholds. Call it at the
+	*				speed-loop rate with a filtered angle, the modulators only read the
+	*				stored choice.
+	*/
+	void svm_set_load_angle(SVM_t* svm, float32_t phi);
+
+	/*!
+	*
+	* @brief		svm_set_load_angle() from the voltage and current vectors
+	* @param[in]	svm: SVM_t structure
+	* @param[in]	vx, vy: voltage vector, d/q or alpha/beta
+	* @param[in]	ix, iy: current vector, same frame
+	*
+	*				The same choice as svm_set_load_angle(svm, atan2(v x i, v . i)),
+	*				decided on the cross and dot products against tan() of the
+	*				thresholds, without the atan2. No current keeps DPWM1.
+	*				foc_current_step() calls it every period in DPWM_ADAPTIVE.
+	*/
+	void svm_set_load_vectors(SVM_t* svm, float32_t vx, float32_t vy, float32_t ix, float32_t iy);
+
+	/*!
+	*
+	* @brief		Table-driven SVM modulation, branch-free alternative to modulator()
+	*
+	*				Same inputs/outputs as modulator(). The 12N sector, the active vectors
+	*				(d1, d2), the phase ordering and the per-mode zero-sequence choice are
+	*				all looked up from the sign/compare results instead of the if/else tree
+	*				and switch statements, and the clamps are min/max selects, so the
+	*				execution time does not depend on the input. The overmodulation rules
+	*				are computed for every sample and selected. The arithmetic is the same
+	*				as modulator(), the outputs match it bit-for-bit for every finite input.
+	*/
+	void modulator_lut(SVM_t* svm, const float32_t Ualpha, const float32_t Ubeta, SVM_mode_t mode);
+
+	/*!
+	*
+	* @brief		Batched SVM modulation over structure-of-arrays input
+	* @param[in]	Ualpha, Ubeta: count samples of alpha, beta
+	* @param[in]	count: number of samples
+	* @param[in]	mode: SVM mode, common to the batch
+	* @param[out]	ma, mb, mc: duty cycle of phase A, B, C per sample
+	* @param[out]	sector: 12N sector per sample
+	*
+	*				Results are bit-identical to calling modulator() per sample, with
+	*				DPWM_ADAPTIVE modulating as DPWM1 (there is no SVM_t). Uses AVX-512
+	*				(16 samples per instruction), AVX2 (8) or SSE4.1 (4) when the CPU has it,
+	*				chosen once on first use, and modulator_batch_scalar() otherwise.
+	*				Input and output arrays need no particular alignment.
+	*/
+	void modulator_batch(const float32_t* Ualpha, const float32_t* Ubeta, uint32_t count, SVM_mode_t mode,
+						 float32_t* ma, float32_t* mb, float32_t* mc, int16_t* sector);
+
+	/*!
+	*
+	* @brief		Makes the choice modulator_batch() otherwise makes on first use
+	*
+	*				Call it once before modulator_batch() runs on several threads, the
+	*				first-use choice is an unsynchronized write; later calls do nothing.
+	*				drive_bank_init() calls it.
+	*/
+	void modulator_batch_init(void);
+
+	/*!
+	*
+	* @brief		Batched SVM modulation, one modulator_lut() call per sample
+	*/
+	void modulator_batch_scalar(const float32_t* Ualpha, const float32_t* Ubeta, uint32_t count, SVM_mode_t mode,
+								float32_t* ma, float32_t* mb, float32_t* mc, int16_t* sector);
+
+	/*!
+	*
+	* @brief		Instruction set modulator_batch() runs on: "avx512", "avx2", "sse4.1" or "scalar"
+	*/
+	const char* modulator_batch_isa(void);
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
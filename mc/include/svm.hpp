@@ -0,0 +1,55 @@
+/**
+ * @file       svm.hpp
+ * @date       Oct 2026
+ *
+ * @brief      SVM modulator specialized at compile time
+ *
+ *      mc::modulator<Mode>() is modulator() for a mode fixed per product: the
+ *      overmodulation rule and the zero-sequence rule are picked when the
+ *      template is instantiated, so no mode is tested per call, and SVPWM,
+ *      DPWMMIN and DPWMMAX do not read the zero-sequence table at all. The
+ *      results equal modulator() with the same mode bit for bit.
+ *
+ *          mc::modulator<SVPWM>(svm, Ualpha, Ubeta);
+ *          mc::modulator<SVM_MODE(DPWM1, SVM_OVM_MME)>(svm, Ualpha, Ubeta);
+ *
+ *      Every zero-sequence rule with every overmodulation rule is instantiated
+ *      in src/svm_spec.cpp, next to the tables it reads; C code calls
+ *      modulator_SVPWM() and modulator_DMPWM3() of svm.h. The Qspice blocks,
+ *      whose mode is a parameter, keep the run-time modulator().
+ */
+#ifndef SVM_HPP_
+    #define SVM_HPP_
+
+#include "svm.h"
+
+namespace mc {
+
+namespace detail {
+
+template <SVM_mode_t Mode>
+void modulator_spec(SVM_t* svm, float32_t Ualpha, float32_t Ubeta);
+
+} // namespace detail
+
+/**
+ * @brief      SVM modulation with a compile-time mode
+ *
+ * @param      svm      The SVM instance, UAB, sector and m are written
+ * @param[in]  Ualpha   alpha
+ * @param[in]  Ubeta    beta
+ */
+template <SVM_mode_t Mode>
+inline void modulator(SVM_t& svm, float32_t Ualpha, float32_t Ubeta)
+{
+    static_assert(((unsigned)Mode & SVM_ZS_MASK) < SVM_MODE_NUM &&
+                      ((unsigned)Mode & SVM_OVM_MASK) != SVM_OVM_MASK &&
+                      ((unsigned)Mode & ~(unsigned)(SVM_ZS_MASK | SVM_OVM_MASK)) == 0,
+                  "a zero-sequence rule, optionally or'ed with SVM_OVM_MPE or SVM_OVM_MME");
+
+    detail::modulator_spec<Mode>(&svm, Ualpha, Ubeta);
+}
+
+} // namespace mc
+
+#endif // <-- !defined SVM_HPP_
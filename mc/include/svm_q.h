@@ -0,0 +1,37 @@
+#pragma once
+
+#include "commontypes.h"
+#include "fixedpoint.h"
+#include "svm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+	typedef struct
+	{
+		q_t				UAB[2];
+		q_t				m[3];
+		int16_t			sector;
+	} SVMq_t;						// sector last, as in SVM_t: no hole in Q31
+
+	/*!
+	*
+	* @brief		Fixed-point SVM modulation, Q15/Q31 counterpart of modulator()
+	* @param[in]	svm: SVMq_t structure
+	* @param[in]	Ualpha: alpha, per unit as for modulator()
+	* @param[in]	Ubeta: beta
+	* @param[in]	mode: SVM mode
+	* @param[out]	svm->sector: sector
+	* @param[out]	svm->m: array of duty cycle for phase A, B, C, in [0, Q_MAX]
+	*
+	*				Same sector logic and tables as modulator_lut(); the divisions by 3
+	*				and 6 are multiplications by Q constants and every sum saturates.
+	*				A duty of 1 reads as Q_MAX. The overmodulation rules take Q_MAX as the
+	*				hexagon side, DPWM_ADAPTIVE modulates as DPWM1 (there is no SVM_t).
+	*/
+	void modulator_q(SVMq_t* svm, const q_t Ualpha, const q_t Ubeta, SVM_mode_t mode);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
@@ -0,0 +1,137 @@
+/**
+ * @file        task_sched.h
+ * @date        Oct 2026
+ *
+ * @brief      header file for the static multi-rate task scheduler
+ *
+ *      One sched_tick() per PWM period (from the PWM or ADC interrupt) runs the
+ *      due tasks of a constant table in table order, so the current loop, the
+ *      speed and position loops and the filter updates share one deterministic
+ *      timeline instead of each checking its own clock:
+ *        - divisor   the task runs every divisor-th tick
+ *        - phase     on the ticks where tick % divisor == phase, so that slow
+ *                    tasks can be spread over different PWM periods
+ *        - budget    counter ticks one run may take; a longer run is counted
+ *                    as an overrun of the task (the task is not stopped)
+ *      The pattern repeats every hyperperiod, the least common multiple of the
+ *      divisors. sched_spread() picks the phases of the slow tasks so that the
+ *      summed budgets of the busiest tick are as low as it can find.
+ *
+ *      A due task costs one decrement and one compare per tick, an idle one the
+ *      same. With a counter (sched_init()) every run and every tick are timed:
+ *      per-task last/max and overruns, per-tick last/max, the tick of the
+ *      maximum and the ticks over the tick budget. Without a counter each run is
+ *      charged its budget instead, which emulates the schedule's load profile
+ *      on the host without timing anything.
+ *
+ *      Not reentrant: one scheduler per interrupt context.
+ */
+
+#ifndef TASK_SCHED_H_
+    #define TASK_SCHED_H_
+
+#include "commontypes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SCHED_MAX_TASKS             16
+#define SCHED_MAX_HYPER             10000u  // ticks, largest accepted hyperperiod
+
+typedef void (*Sched_Fn_t)(void* ctx);
+
+typedef struct
+{
+    const char*     name;
+    Sched_Fn_t      fn;
+    void*           ctx;
+    uint16_t        divisor;    // >= 1, 1 runs every tick
+    uint16_t        phase;      // < divisor
+    uint32_t        budget;     // counter ticks per run, 0: not budgeted
+} Sched_Task_t;
+
+typedef struct
+{
+    uint32_t            runs;
+    uint32_t            overruns;   // runs longer than the budget
+    uint32_t            last;       // counter ticks of the last run
+    uint32_t            max;
+    unsigned long long  sum;
+} Sched_Stat_t;
+
+typedef struct
+{
+    // task table
+    const Sched_Task_t* tasks;
+    uint16_t            n_tasks;
+    uint16_t            countdown[SCHED_MAX_TASKS];     // ticks until the next run
+    uint32_t            hyper;                          // hyperperiod, ticks
+    uint32_t            tick_budget;                    // counter ticks per tick, 0: none
+    uint32_t            (*counter)(void);               // NULL: runs charged their budget
+    // statistics
+    uint32_t            tick;                           // ticks since init
+    Sched_Stat_t        stat[SCHED_MAX_TASKS];
+    uint32_t            tick_last;                      // load of the last tick
+    uint32_t            tick_max;                       // load of the worst tick
+    uint32_t            tick_max_at;                    // its tick number
+    uint32_t            tick_overruns;                  // ticks over tick_budget
+    unsigned long long  tick_sum;
+} Sched_Obj_t;
+
+/**
+ * @brief      Scheduler init
+ *
+ * @param      s            The scheduler instance
+ * @param[in]  tasks        The task table, kept by reference
+ * @param[in]  n_tasks      Tasks in the table, 1..SCHED_MAX_TASKS
+ * @param[in]  tick_budget  Counter ticks available per tick (the PWM period), 0: none
+ * @param[in]  counter      Free-running 32-bit counter, e.g. the DWT cycle counter;
+ *                          NULL to charge every run its budget
+ *
+ * @return     0, or -1 if a task has no function, a divisor of 0, a phase not
+ *             below its divisor, or the hyperperiod exceeds SCHED_MAX_HYPER
+ */
+int16_t sched_init(Sched_Obj_t* const s, const Sched_Task_t* tasks, uint16_t n_tasks, uint32_t tick_budget,
+                   uint32_t (*counter)(void));
+
+/**
+ * @brief      Runs the tasks due in this tick and advances the schedule
+ */
+void sched_tick(Sched_Obj_t* const s);
+
+/**
+ * @brief      Clears the statistics, the schedule keeps its position
+ */
+void sched_reset_stats(Sched_Obj_t* const s);
+
+/**
+ * @brief      Hyperperiod of a task table, the least common multiple of the divisors
+ *
+ * @return     Ticks, or 0 if it exceeds SCHED_MAX_HYPER or a divisor is 0
+ */
+uint32_t sched_hyperperiod(const Sched_Task_t* tasks, uint16_t n_tasks);
+
+/**
+ * @brief      Summed budgets of the tasks due at a tick
+ */
+uint32_t sched_static_load(const Sched_Task_t* tasks, uint16_t n_tasks, uint32_t tick);
+
+/**
+ * @brief      Sets the phases of the tasks with divisor > 1 to flatten the load
+ *
+ *      Greedy: the tasks are placed by decreasing budget, each on the phase
+ *      whose busiest tick (counting the tasks placed so far) is the least
+ *      loaded, the lowest such phase on ties. Tasks with divisor 1 and
+ *      unbudgeted tasks keep their phase. Runs once at init, not in the loop.
+ *
+ * @return     Summed budgets of the busiest tick of the hyperperiod, or 0 if the
+ *             table is invalid as for sched_init()
+ */
+uint32_t sched_spread(Sched_Task_t* tasks, uint16_t n_tasks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //<- !defined TASK_SCHED_H_
@@ -0,0 +1,168 @@
+/**
+ * @file        telemetry.h
+ * @date        Oct 2026
+ *
+ * @brief      header file for the lock-free SPSC telemetry ring
+ *
+ *      The control loop (single producer) pushes one fixed-size Telem_Record_t per
+ *      tick, a background context (single consumer) drains the ring to disk or a
+ *      socket. telem_push() is wait-free: one load of the consumer index (only when
+ *      the cached copy says the ring is full), one record copy and one release
+ *      store. A full ring drops the record and counts it in ring->dropped; the
+ *      producer never waits.
+ *
+ *      The capacity is a power of two and the indices are free-running 32-bit
+ *      counters, so full/empty need no extra slot. Producer and consumer indices
+ *      sit on separate cache lines. Ordering:
+ *        - GCC/Clang     __atomic acquire/release
+ *        - MSVC x86/x64  volatile plus compiler barrier (the hardware is TSO)
+ *        - others        volatile plus compiler barrier, enough for an ISR and a
+ *                        background loop on one core; a multi-core target needs
+ *                        its own barrier in MC_TELEM_LOAD_ACQ/MC_TELEM_STORE_REL
+ *
+ *      telem_record_fill() picks the usual signals out of PID_Obj_t,
+ *      Transform_Obj_t and SVM_t; any of them may be NULL.
+ */
+
+#ifndef TELEMETRY_H_
+    #define TELEMETRY_H_
+
+#include "commontypes.h"
+#include "ctrl_common.h"
+#include "pid.h"
+#include "svm.h"
+#include "transforms.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define MC_TELEM_LOAD_ACQ(p)        __atomic_load_n((p), __ATOMIC_ACQUIRE)
+    #define MC_TELEM_STORE_REL(p, v)    __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#elif defined(_MSC_VER)
+    #include <intrin.h>
+    #pragma intrinsic(_ReadWriteBarrier)
+    #define MC_TELEM_LOAD_ACQ(p)        mc_telem_load_acq(p)
+    #define MC_TELEM_STORE_REL(p, v)    do { _ReadWriteBarrier(); *(p) = (v); } while (0)
+    MC_INLINE uint32_t mc_telem_load_acq(const volatile uint32_t* p) { uint32_t v = *p; _ReadWriteBarrier(); return v; }
+#elif !defined(MC_TELEM_LOAD_ACQ)
+    #define MC_TELEM_LOAD_ACQ(p)        (*(p))
+    #define MC_TELEM_STORE_REL(p, v)    (*(p) = (v))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TELEM_MAGIC                 0x4D4C4554u     // "TELM", little endian
+#define TELEM_VERSION               1
+
+// one control tick, 64 bytes
+typedef struct
+{
+    uint32_t    tick;
+    int16_t     sector;         // SVM_t.sector
+    int16_t     flags;          // free for the application
+    // PID_Obj_t
+    float32_t   pid_err;
+    float32_t   pid_ui;
+    float32_t   pid_u;
+    // Transform_Obj_t
+    float32_t   a;
+    float32_t   b;
+    float32_t   alpha;
+    float32_t   beta;
+    float32_t   d;
+    float32_t   q;
+    // SVM_t
+    float32_t   m[3];
+    float32_t   user[2];        // free for the application
+} Telem_Record_t;
+
+// stream header written once before the records
+typedef struct
+{
+    uint32_t    magic;          // TELEM_MAGIC
+    uint16_t    version;        // TELEM_VERSION
+    uint16_t    record_size;    // sizeof(Telem_Record_t)
+    float32_t   Ts;             // tick period, s
+    uint32_t    reserved;
+} Telem_Header_t;
+
+typedef struct
+{
+    // producer side
+    volatile uint32_t   head;       // next slot to write
+    uint32_t            tail_cache; // last seen consumer index
+    uint32_t            dropped;    // records lost to a full ring
+    uint32_t            pad_p[13];
+    // consumer side
+    volatile uint32_t   tail;       // next slot to read
+    uint32_t            pad_c[15];
+    // shared, read-only after init
+    Telem_Record_t*     buf;
+    uint32_t            mask;       // capacity - 1
+} Telem_Ring_t;
+
+/**
+ * @brief      Ring initialization
+ *
+ * @param      ring      The ring
+ * @param      buf       Storage for capacity records
+ * @param[in]  capacity  Number of records, a power of two
+ *
+ * @return     0, or -1 if capacity is not a power of two
+ */
+int16_t telem_ring_init(Telem_Ring_t* const ring, Telem_Record_t* buf, uint32_t capacity);
+
+/**
+ * @brief      Fills a record from the controller objects
+ *
+ * @param[out] rec   The record
+ * @param[in]  tick  Tick counter
+ * @param[in]  pid   err, ui, u; NULL leaves them 0
+ * @param[in]  T     abc.a, abc.b, alpha, beta, d, q; NULL leaves them 0
+ * @param[in]  svm   m[], sector; NULL leaves them 0
+ */
+void telem_record_fill(Telem_Record_t* rec, uint32_t tick, const PID_Obj_t* pid, const Transform_Obj_t* T,
+                       const SVM_t* svm);
+
+/**
+ * @brief      Consumer: takes up to max records off the ring
+ *
+ * @return     Number of records copied to out
+ */
+uint32_t telem_pop(Telem_Ring_t* const ring, Telem_Record_t* out, uint32_t max);
+
+/**
+ * @brief      Records waiting in the ring, as seen by the consumer
+ */
+uint32_t telem_pending(const Telem_Ring_t* const ring);
+
+/**
+ * @brief      Producer: appends one record, wait-free
+ *
+ * @param      ring  The ring
+ * @param[in]  rec   The record
+ *
+ * @return     1 if stored, 0 if the ring was full (ring->dropped counts it)
+ */
+MC_INLINE int16_t telem_push(Telem_Ring_t* const ring, const Telem_Record_t* rec)
+{
+    uint32_t head = ring->head;     // only the producer writes head
+
+    if (head - ring->tail_cache > ring->mask) {
+        ring->tail_cache = MC_TELEM_LOAD_ACQ(&ring->tail);
+        if (head - ring->tail_cache > ring->mask) {
+            ring->dropped++;
+            return 0;
+        }
+    }
+
+    ring->buf[head & ring->mask] = *rec;
+    MC_TELEM_STORE_REL(&ring->head, head + 1);
+    return 1;
+} //<- end of telem_push()
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //<- !defined TELEMETRY_H_
@@ -17,6 +17,8 @@ extern "C" {
 #endif
 
 #include "commontypes.h"
+#include "ctrl_common.h"
+#include "trig.h"
 
 typedef struct
 {
@@ -39,6 +41,9 @@ typedef struct
     float32_t     zero_dq;
 } DQ0_t;
 
+// all three frames, for the blocks that chain the transforms; each kernel
+// touches two adjacent ones (AB0 is shared). Callers that only need a pair
+// keep the triples and use the *_Inline kernels below.
 typedef struct
 {
     ABC_t       abc;
@@ -71,6 +76,14 @@ void AB02abc(Transform_Obj_t *T_inst);
  */
 void AB02dq0(Transform_Obj_t *T_inst, float32_t theta_e);
 
+/**
+ * @brief      Park transformation with precomputed sin/cos of the electrical angle
+ *
+ * @param      T_inst  The instance of the transformation object
+ * @param      sc      sin(theta_e) and cos(theta_e), see trig_sincos()
+ */
+void AB02dq0_sincos(Transform_Obj_t *T_inst, const SinCos_t *sc);
+
 
 /**
  * @brief      Inverse Park transformation
@@ -80,6 +93,99 @@ void AB02dq0(Transform_Obj_t *T_inst, float32_t theta_e);
  */
 void dq02AB0(Transform_Obj_t *T_inst, float32_t theta_e);
 
+/**
+ * @brief      Inverse Park transformation with precomputed sin/cos of the electrical angle
+ *
+ * @param      T_inst  The instance of the transformation object
+ * @param      sc      sin(theta_e) and cos(theta_e), see trig_sincos()
+ */
+void dq02AB0_sincos(Transform_Obj_t *T_inst, const SinCos_t *sc);
+
+/**
+ * @brief      Clarke transformation with phase a&b sensing, inline version
+ *
+ *      abc2AB0() with numSensors == 2 on the two frames it touches; assumes
+ *      a+b+c = 0 and writes abc->c too. See clarke<2> in transforms.hpp.
+ */
+MC_INLINE void abc2AB0_2s_Inline(ABC_t *abc, AB0_t *AB0)
+{
+    abc->c = -abc->a - abc->b;
+
+    AB0->alpha = abc->a;
+    AB0->beta = SQRT3REC*(abc->a + 2*abc->b);
+    AB0->zero_AB = 0;
+} //<- end of abc2AB0_2s_Inline()
+
+/**
+ * @brief      Clarke transformation with 3-phase sensing, inline version
+ *
+ *      abc2AB0() with numSensors == 3 on the two frames it touches. See
+ *      clarke<3> in transforms.hpp.
+ */
+MC_INLINE void abc2AB0_3s_Inline(const ABC_t *abc, AB0_t *AB0)
+{
+    AB0->alpha = TWO_THIRD*abc->a-ONE_THIRD*(abc->b+abc->c);
+    AB0->beta = SQRT3REC*(abc->b-abc->c);
+    AB0->zero_AB = ONE_THIRD*(abc->a+abc->b+abc->c);
+} //<- end of abc2AB0_3s_Inline()
+
+/**
+ * @brief      Clarke transformation on the two frames it touches, inline version
+ *
+ *      Same computation as abc2AB0(); with 2 sensors abc->c is written too.
+ *
+ * @param      abc         The phase values
+ * @param[out] AB0         The alpha/beta/zero values
+ * @param      numSensors  The number of sensors, 2(phase a,b) or 3(phase a,b,c)
+ */
+MC_INLINE void abc2AB0_Inline(ABC_t *abc, AB0_t *AB0, int16_t numSensors)
+{
+    if (numSensors == 2)
+    {
+        abc2AB0_2s_Inline(abc, AB0);
+    }
+    else if (numSensors == 3)
+    {
+        abc2AB0_3s_Inline(abc, AB0);
+    }
+} //<- end of abc2AB0_Inline()
+
+/**
+ * @brief      Inverse Clarke transformation, inline version of AB02abc()
+ */
+MC_INLINE void AB02abc_Inline(const AB0_t *AB0, ABC_t *abc)
+{
+    abc->a = AB0->alpha + AB0->zero_AB;
+    abc->b = -AB0->alpha/2 + SQRT3/2*AB0->beta + AB0->zero_AB;
+    abc->c = -AB0->alpha/2 - SQRT3/2*AB0->beta + AB0->zero_AB;
+} //<- end of AB02abc_Inline()
+
+/**
+ * @brief      Park transformation, inline version of AB02dq0_sincos()
+ */
+MC_INLINE void AB02dq0_Inline(const AB0_t *AB0, const SinCos_t *sc, DQ0_t *dq0)
+{
+    float32_t alpha = AB0->alpha;
+    float32_t beta = AB0->beta;
+
+    dq0->d = alpha * sc->cos + beta * sc->sin;
+    dq0->q = - alpha * sc->sin + beta * sc->cos;
+    dq0->zero_dq = AB0->zero_AB;
+} //<- end of AB02dq0_Inline()
+
+/**
+ * @brief      Inverse Park transformation, inline version of dq02AB0_sincos()
+ */
+MC_INLINE void dq02AB0_Inline(const DQ0_t *dq0, const SinCos_t *sc, AB0_t *AB0)
+{
+    float32_t d = dq0->d;
+    float32_t q = dq0->q;
+
+    AB0->alpha = d * sc->cos - q * sc->sin;
+    AB0->beta = d * sc->sin + q * sc->cos;
+    AB0->zero_AB = dq0->zero_dq;
+} //<- end of dq02AB0_Inline()
+
 
 
 #ifdef __cplusplus
@@ -0,0 +1,51 @@
+/**
+ * @file       transforms.hpp
+ * @date       Oct 2026
+ *
+ * @brief      header-only Clarke transformation specialized at compile time
+ *
+ *      mc::clarke<2> and mc::clarke<3> are abc2AB0() for a board hardwired to
+ *      phase a&b or to 3-phase current sensing: the sensor count is a template
+ *      argument, so the branch on numSensors is not compiled in. The results
+ *      equal abc2AB0() with the same count bit for bit.
+ *
+ *          mc::clarke<2>(T);               // abc2AB0(&T, 2)
+ *          mc::clarke<3>(T.abc, T.AB0);    // abc2AB0(&T, 3), only the two frames
+ *
+ *      The Qspice blocks, whose sensor count is a parameter, keep abc2AB0().
+ */
+#ifndef TRANSFORMS_HPP_
+    #define TRANSFORMS_HPP_
+
+#include "transforms.h"
+
+namespace mc {
+
+/**
+ * @brief      Clarke transformation - amplitude invariant, compile-time sensor count
+ *
+ * @param      abc   The phase values, with 2 sensors abc.c is written (a+b+c = 0)
+ * @param[out] AB0   The alpha/beta/zero values
+ */
+template <int NumSensors>
+inline void clarke(ABC_t& abc, AB0_t& AB0)
+{
+    static_assert(NumSensors == 2 || NumSensors == 3, "2(phase a,b) or 3(phase a,b,c) sensors");
+
+    if constexpr (NumSensors == 2) {
+        abc2AB0_2s_Inline(&abc, &AB0);
+    }
+    else {
+        abc2AB0_3s_Inline(&abc, &AB0);
+    }
+}
+
+template <int NumSensors>
+inline void clarke(Transform_Obj_t& T)
+{
+    clarke<NumSensors>(T.abc, T.AB0);
+}
+
+} // namespace mc
+
+#endif // <-- !defined TRANSFORMS_HPP_
@@ -0,0 +1,85 @@
+/**
+ * @file        transforms_q.h
+ * @date        Oct 2026
+ *
+ * @brief      header file for the fixed-point Clarke and Park transformation
+ *
+ *      Q15/Q31 counterpart of transforms.h, see fixedpoint.h. Constants above 1
+ *      (SQRT3, 2/SQRT3) are split into in-range terms, every sum saturates.
+ */
+
+#ifndef TRANSFORMS_Q_H_
+    #define TRANSFORMS_Q_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "commontypes.h"
+#include "fixedpoint.h"
+
+typedef struct
+{
+    q_t         a;
+    q_t         b;
+    q_t         c;
+} ABCq_t;
+
+typedef struct
+{
+    q_t         alpha;
+    q_t         beta;
+    q_t         zero_AB;
+} AB0q_t;
+
+typedef struct
+{
+    q_t         d;
+    q_t         q;
+    q_t         zero_dq;
+} DQ0q_t;
+
+typedef struct
+{
+    ABCq_t      abc;
+    AB0q_t      AB0;
+    DQ0q_t      dq0;
+} Transformq_Obj_t;
+
+
+/**
+ * @brief      Clarke transformation - amplitude invariant
+ *
+ * @param      T_inst  The instance of the transformation object
+ * @param      numSensors  The number of sensors, 2(phase a,b) or 3(phase a,b,c)
+ */
+void abc2AB0_q(Transformq_Obj_t *T_inst, int16_t numSensors);
+
+/**
+ * @brief      Inverse Clarke transformation - amplitude invariant
+ *
+ * @param      T_inst  The instance of the transformation object
+ */
+void AB02abc_q(Transformq_Obj_t *T_inst);
+
+/**
+ * @brief      Park transformation
+ *
+ * @param      T_inst  The instance of the transformation object
+ * @param      theta_e  The electrical angle in units of PI
+ */
+void AB02dq0_q(Transformq_Obj_t *T_inst, q_t theta_e);
+
+/**
+ * @brief      Inverse Park transformation
+ *
+ * @param      T_inst  The instance of the transformation object
+ * @param      theta_e  The electrical angle in units of PI
+ */
+void dq02AB0_q(Transformq_Obj_t *T_inst, q_t theta_e);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //<- !defined TRANSFORMS_Q_H_
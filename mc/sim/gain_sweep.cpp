@@ -0,0 +1,174 @@
+/**
+ * @file       gain_sweep.cpp
+ * @date       Oct 2026
+ *
+ * @brief      Parallel PID gain sweep / autotune against the native PMSM plant
+ *
+ *      Evaluates a grid of PID_Param_Init() parameter sets around the nominal
+ *      gains (see SweepSpace::around_nominal()) on all cores, prints the Pareto
+ *      front over overshoot, settling time, ITAE and saturation time, and
+ *      optionally the speedup of the same sweep over 1, 2, 4, ... threads.
+ *
+ *      Usage: gain_sweep [--target speed|current] [--grid N] [--refine L]
+ *                        [--prune F] [--threads N] [--top N] [--scaling]
+ *                        [--csv file]
+ *
+ *        --grid N     points per Kp/Ti axis of the (coarse) grid, default 9
+ *        --refine L   coarse-to-fine levels around the front, 0 = plain sweep
+ *        --prune F    ITAE budget of the refined runs, F x best so far
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "autotune.hpp"
+
+using namespace mc::sim;
+
+namespace {
+
+struct Options
+{
+    TuneTarget  target  = TuneTarget::speed;
+    uint32_t    grid    = 9;
+    unsigned    refine  = 0;
+    float32_t   prune   = 4.0f;
+    unsigned    threads = 0;
+    size_t      top     = 20;
+    bool        scaling = false;
+    const char* csv     = nullptr;
+};
+
+Options parse_args(int argc, char** argv)
+{
+    Options opt;
+    for (int i = 1; i < argc; i++) {
+        bool more = i + 1 < argc;
+        if (std::strcmp(argv[i], "--target") == 0 && more) {
+            opt.target = std::strcmp(argv[++i], "current") == 0 ? TuneTarget::current : TuneTarget::speed;
+        }
+        else if (std::strcmp(argv[i], "--grid") == 0 && more) {
+            opt.grid = (uint32_t)std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--refine") == 0 && more) {
+            opt.refine = (unsigned)std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--prune") == 0 && more) {
+            opt.prune = (float32_t)std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--threads") == 0 && more) {
+            opt.threads = (unsigned)std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--top") == 0 && more) {
+            opt.top = (size_t)std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--csv") == 0 && more) {
+            opt.csv = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--scaling") == 0) {
+            opt.scaling = true;
+        }
+        else {
+            std::fprintf(stderr,
+                         "usage: %s [--target speed|current] [--grid N] [--refine L] [--prune F] [--threads N]"
+                         " [--top N] [--scaling] [--csv file]\n",
+                         argv[0]);
+            std::exit(2);
+        }
+    }
+    if (opt.grid < 2) {
+        opt.grid = 2;
+    }
+    return opt;
+}
+
+TuneScenario scenario(TuneTarget target)
+{
+    TuneScenario sc;
+    sc.target = target;
+    if (target == TuneTarget::current) {
+        sc.step    = 5.0f;      // A
+        sc.horizon = 5e-3f;
+    }
+    return sc;
+}
+
+double seconds_since(std::chrono::steady_clock::time_point t0)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+void write_csv(const char* path, const TuneResult& r)
+{
+    std::FILE* f = std::fopen(path, "w");
+    if (f == nullptr) {
+        std::fprintf(stderr, "cannot write %s\n", path);
+        return;
+    }
+    std::vector<bool> on_front(r.sets.size(), false);
+    for (size_t i : r.front) {
+        on_front[i] = true;
+    }
+    std::fprintf(f, "Kp,Ti,Td,Kp_aw,IntRateLim,status,overshoot_pct,settling_s,itae,sat_s,front\n");
+    for (size_t i = 0; i < r.sets.size(); i++) {
+        const PidSet&   p = r.sets[i];
+        const PidScore& s = r.scores[i];
+        const char* st = s.status == RunStatus::ok ? "ok" : (s.status == RunStatus::unstable ? "unstable" : "pruned");
+        std::fprintf(f, "%g,%g,%g,%g,%g,%s,%g,%g,%g,%g,%d\n", p.Kp, p.Ti, p.Td, p.Kp_aw, p.IntRateLim, st,
+                     s.overshoot, s.settling, s.itae, s.sat_time, on_front[i] ? 1 : 0);
+    }
+    std::fclose(f);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options      opt   = parse_args(argc, argv);
+    TuneScenario sc    = scenario(opt.target);
+    SweepSpace   space = SweepSpace::around_nominal(sc, opt.grid);
+
+    if (opt.scaling) {
+        unsigned max_threads = opt.threads ? opt.threads : std::max(1u, std::thread::hardware_concurrency());
+        double t1 = 0;
+        std::printf("%8s %10s %10s %10s\n", "threads", "wall s", "speedup", "runs/s");
+        for (unsigned n = 1; n <= max_threads; n = (n * 2 > max_threads && n != max_threads) ? max_threads : n * 2) {
+            WorkPool pool(n);
+            auto t0 = std::chrono::steady_clock::now();
+            TuneResult r = sweep(pool, sc, space);
+            double t = seconds_since(t0);
+            if (n == 1) {
+                t1 = t;
+            }
+            std::printf("%8u %10.3f %10.2f %10.0f\n", n, t, t1 / t, (double)r.sets.size() / t);
+        }
+        std::printf("\n");
+    }
+
+    WorkPool pool(opt.threads);
+    auto t0 = std::chrono::steady_clock::now();
+    TuneResult r = opt.refine ? autotune(pool, sc, space, opt.refine, opt.prune) : sweep(pool, sc, space);
+    double t = seconds_since(t0);
+
+    std::printf("%s loop: %zu runs (%zu coarse) on %u threads in %.3f s, %zu unstable, %zu pruned, front %zu\n",
+                opt.target == TuneTarget::speed ? "speed" : "current", r.sets.size(), space.size(), pool.size(), t,
+                r.unstable, r.pruned, r.front.size());
+    std::printf("\n%10s %10s %10s %8s %10s | %8s %10s %10s %10s\n", "Kp", "Ti", "Td", "Kp_aw", "IntRateLim",
+                "OS %", "settle s", "ITAE", "sat s");
+    for (size_t k = 0; k < r.front.size() && k < opt.top; k++) {
+        const PidSet&   p = r.sets[r.front[k]];
+        const PidScore& s = r.scores[r.front[k]];
+        std::printf("%10.4g %10.4g %10.4g %8.3g %10.4g | %8.2f %10.4g %10.4g %10.4g\n", p.Kp, p.Ti, p.Td, p.Kp_aw,
+                    p.IntRateLim, s.overshoot, s.settling, s.itae, s.sat_time);
+    }
+    if (r.front.size() > opt.top) {
+        std::printf("... %zu more, --top N or --csv for all\n", r.front.size() - opt.top);
+    }
+
+    if (opt.csv != nullptr) {
+        write_csv(opt.csv, r);
+    }
+    return 0;
+}
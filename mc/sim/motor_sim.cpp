@@ -0,0 +1,299 @@
+/**
+ * @file       motor_sim.cpp
+ * @date       Oct 2026
+ *
+ * @brief      Closed-loop PMSM regression run on the host
+ *
+ *      Runs the speed + current FOC of closed_loop.hpp against PmsmPlant for one
+ *      second of motor time per inverter model:
+ *        0    s   speed reference 200 rad/s from standstill
+ *        0.3  s   load torque step to 0.5 Nm
+ *        0.6  s   speed reversal to -150 rad/s, load kept
+ *      and checks at the end of each segment that the speed settled within 1% of
+ *      the reference, iq carries the load torque within 3%, and id stays at zero.
+ *      Reports the control steps per second of wall time. The exit status is
+ *      non-zero when a check fails. --seconds stretches the profile and skips the
+ *      checks (throughput runs); --trace writes every N-th step as CSV.
+ *      --telemetry pushes a Telem_Record_t every step into an SPSC ring that a
+ *      TelemetryWriter thread drains to a file or socket, and reports drops and
+ *      the longest push; --realtime paces the steps at Ts of wall time, as on
+ *      the target. --capture writes every step of the current loop in the
+ *      columnar trace format for trace_replay (current_loop_trace.hpp).
+ *
+ *      Usage: motor_sim [--inverter averaged|switched|both] [--seconds S]
+ *                       [--trace file.csv] [--decimate N]
+ *                       [--telemetry file|tcp:host:port] [--realtime]
+ *                       [--capture file.mct]
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "closed_loop.hpp"
+#include "current_loop_trace.hpp"
+#include "telemetry.h"
+#include "telemetry_writer.hpp"
+
+using mc::sim::ClosedLoop;
+using mc::sim::CurrentLoopCapture;
+using mc::sim::Inverter;
+using mc::sim::LoopParams;
+using mc::sim::PmsmParams;
+using mc::sim::TelemetryWriter;
+
+namespace {
+
+struct Options
+{
+    bool        averaged = true;
+    bool        switched = true;
+    double      seconds  = 1.0;
+    const char* trace    = nullptr;
+    uint32_t    decimate = 20;
+    const char* telemetry = nullptr;
+    bool        realtime = false;
+    const char* capture  = nullptr;
+};
+
+constexpr uint32_t kRingRecords = 1u << 14;     // 0.8 s at 20 kHz, 1 MiB
+
+struct Segment
+{
+    double      t_end;          // end of the segment, fraction of the run
+    float32_t   omega_ref;      // rad/s
+    float32_t   TL;             // Nm
+};
+
+const Segment kProfile[] = {
+    {0.3, 200.0f, 0.0f},
+    {0.6, 200.0f, 0.5f},
+    {1.0, -150.0f, 0.5f},
+};
+
+struct Check
+{
+    float32_t   omega;
+    float32_t   id;
+    float32_t   iq;
+};
+
+Options parse_args(int argc, char** argv)
+{
+    Options opt;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--inverter") == 0 && i + 1 < argc) {
+            const char* v = argv[++i];
+            opt.averaged = std::strcmp(v, "switched") != 0;
+            opt.switched = std::strcmp(v, "averaged") != 0;
+        }
+        else if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            opt.seconds = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            opt.trace = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--decimate") == 0 && i + 1 < argc) {
+            opt.decimate = (uint32_t)std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--telemetry") == 0 && i + 1 < argc) {
+            opt.telemetry = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--realtime") == 0) {
+            opt.realtime = true;
+        }
+        else if (std::strcmp(argv[i], "--capture") == 0 && i + 1 < argc) {
+            opt.capture = argv[++i];
+        }
+        else {
+            std::fprintf(stderr,
+                         "usage: %s [--inverter averaged|switched|both] [--seconds S] [--trace file.csv] [--decimate N]"
+                         " [--telemetry file|tcp:host:port] [--realtime] [--capture file.mct]\n",
+                         argv[0]);
+            std::exit(2);
+        }
+    }
+    if (opt.decimate == 0) {
+        opt.decimate = 1;
+    }
+    return opt;
+}
+
+// one output per inverter model when both run
+std::string output_path(const Options& opt, const char* base, const char* name)
+{
+    std::string p(base);
+    if (opt.averaged && opt.switched && std::strncmp(base, "tcp:", 4) != 0) {
+        p += ".";
+        p += name;
+    }
+    return p;
+}
+
+bool within(float32_t x, float32_t target, float32_t rel, float32_t abs_tol)
+{
+    return std::fabs(x - target) <= rel * std::fabs(target) + abs_tol;
+}
+
+// returns false when a check failed
+bool run(const Options& opt, Inverter inv, const char* name)
+{
+    PmsmParams prm;
+    LoopParams lp;
+    lp.inverter = inv;
+
+    ClosedLoop loop(prm, lp);
+
+    const size_t nseg = sizeof(kProfile) / sizeof(kProfile[0]);
+    const uint64_t total = (uint64_t)(opt.seconds / lp.Ts + 0.5);
+    Check  at_end[nseg];
+
+    std::FILE* trace = nullptr;
+    if (opt.trace != nullptr) {
+        trace = std::fopen(output_path(opt, opt.trace, name).c_str(), "w");
+        if (trace != nullptr) {
+            std::fprintf(trace, "t,omega_ref,omega_m,id,iq,Te,theta_e,da,db,dc\n");
+        }
+    }
+
+    // every tick into the ring, drained by the writer thread
+    std::vector<Telem_Record_t> ring_buf;
+    Telem_Ring_t ring;
+    Telem_Ring_t* tm = nullptr;
+    TelemetryWriter writer(ring, lp.Ts);
+    double push_max_ns = 0;
+    double push_sum_ns = 0;
+    if (opt.telemetry != nullptr) {
+        ring_buf.resize(kRingRecords);
+        telem_ring_init(&ring, ring_buf.data(), kRingRecords);
+        if (writer.start(output_path(opt, opt.telemetry, name).c_str())) {
+            tm = &ring;
+        }
+        else {
+            std::fprintf(stderr, "cannot open telemetry destination %s\n", opt.telemetry);
+        }
+    }
+
+    // the current loop of every step, for trace_replay
+    CurrentLoopCapture capture(loop);
+    CurrentLoopCapture* cap = nullptr;
+    if (opt.capture != nullptr) {
+        if (capture.open(output_path(opt, opt.capture, name).c_str())) {
+            cap = &capture;
+        }
+        else {
+            std::fprintf(stderr, "cannot write capture %s\n", opt.capture);
+        }
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    uint64_t k = 0;
+    for (size_t s = 0; s < nseg; s++) {
+        loop.omega_ref = kProfile[s].omega_ref;
+        loop.plant.TL  = kProfile[s].TL;
+        const uint64_t k_end = (uint64_t)(kProfile[s].t_end * (double)total);
+
+        if (trace == nullptr && tm == nullptr && cap == nullptr && !opt.realtime) {
+            for (; k < k_end; k++) {
+                loop.step();
+            }
+        }
+        else {
+            for (; k < k_end; k++) {
+                if (opt.realtime) {
+                    auto due = t0 + std::chrono::nanoseconds((int64_t)((double)k * lp.Ts * 1e9));
+                    while (std::chrono::steady_clock::now() < due) {
+                    }
+                }
+                if (cap != nullptr) {
+                    cap->before_step();
+                }
+                loop.step();
+                if (cap != nullptr) {
+                    cap->after_step();
+                }
+                if (tm != nullptr) {
+                    auto p0 = std::chrono::steady_clock::now();
+                    Telem_Record_t rec;
+                    telem_record_fill(&rec, (uint32_t)k, &loop.pid_q, &loop.T, &loop.svm);
+                    rec.user[0] = loop.plant.omega_m;
+                    rec.user[1] = loop.plant.Te;
+                    telem_push(tm, &rec);
+                    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - p0).count();
+                    push_max_ns = ns > push_max_ns ? ns : push_max_ns;
+                    push_sum_ns += ns;
+                }
+                if (trace != nullptr && k % opt.decimate == 0) {
+                    std::fprintf(trace, "%.6f,%g,%g,%g,%g,%g,%g,%g,%g,%g\n", (double)(k + 1) * lp.Ts,
+                                 loop.omega_ref, loop.plant.omega_m, loop.plant.id, loop.plant.iq, loop.plant.Te,
+                                 loop.plant.theta_e, loop.duty[0], loop.duty[1], loop.duty[2]);
+                }
+            }
+        }
+        at_end[s] = {loop.plant.omega_m, loop.plant.id, loop.plant.iq};
+    }
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    if (trace != nullptr) {
+        std::fclose(trace);
+    }
+
+    std::printf("%-9s %10llu steps %9.2f ms %8.2f Msteps/s\n", name, (unsigned long long)total, wall * 1e3,
+                (double)total / wall * 1e-6);
+
+    if (tm != nullptr) {
+        writer.stop();
+        std::printf("          telemetry: %llu records written, %u dropped, push mean %.0f max %.0f ns%s\n",
+                    (unsigned long long)writer.written(), ring.dropped, push_sum_ns / (double)total, push_max_ns,
+                    writer.failed() ? ", WRITE FAILED" : "");
+    }
+
+    if (cap != nullptr) {
+        bool written = cap->close();
+        std::printf("          capture: %llu samples, %.1f MiB%s\n", (unsigned long long)cap->samples(),
+                    (double)cap->bytes() / (1 << 20), written ? "" : ", WRITE FAILED");
+    }
+
+    if (opt.seconds != 1.0) {     // the settling checks assume the one-second profile
+        std::printf("          checks skipped (profile scaled to %.3g s)\n", opt.seconds);
+        return true;
+    }
+
+    bool ok = true;
+    const float32_t kt = 1.5f * prm.p * prm.psi;
+    for (size_t s = 0; s < nseg; s++) {
+        const Segment& g = kProfile[s];
+        const Check&   c = at_end[s];
+        float32_t iq_exp = (g.TL + prm.B * c.omega) / kt;
+
+        bool pass = within(c.omega, g.omega_ref, 0.01f, 0.0f)
+                 && within(c.iq, iq_exp, 0.03f, 0.05f)
+                 && std::fabs(c.id) < 0.1f;
+        ok = ok && pass;
+
+        std::printf("  t=%.1fs  omega %8.2f (ref %7.1f)  iq %6.3f (exp %6.3f)  id %+6.3f  %s\n", g.t_end, c.omega,
+                    g.omega_ref, c.iq, iq_exp, c.id, pass ? "ok" : "FAIL");
+    }
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opt = parse_args(argc, argv);
+    bool ok = true;
+
+    if (opt.averaged) {
+        ok = run(opt, Inverter::averaged, "averaged") && ok;
+    }
+    if (opt.switched) {
+        ok = run(opt, Inverter::switched, "switched") && ok;
+    }
+
+    return ok ? 0 : 1;
+}
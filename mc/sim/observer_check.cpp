@@ -0,0 +1,246 @@
+/**
+ * @file       observer_check.cpp
+ * @date       Oct 2026
+ *
+ * @brief      Convergence of the sensorless observer and the PLL tracker on the simulated motor
+ *
+ *      Runs the sensored speed + current FOC of closed_loop.hpp against PmsmPlant
+ *      with the motor_sim profile (start-up to 200 rad/s, 0.5 Nm load step,
+ *      reversal to -150 rad/s) per inverter model and, beside it, the
+ *      sliding-mode observer of smo.h on the applied alpha/beta voltages and the
+ *      measured currents, and the PLL of pll.h on the sin/cos of the rotor angle
+ *      the way an encoder or resolver delivers it, started half a turn off. Per
+ *      segment, against the plant's electrical angle and speed:
+ *        lock      time from the segment start until the angle error stays
+ *                  within 0.1 rad for the rest of the segment
+ *        angle     mean and largest |angle error| over the last 20% of the
+ *                  segment
+ *        speed     mean |speed error| over the same part
+ *      and fails when a lock takes longer than the segment's limit or a steady
+ *      error is past its limit. The observer sees the rotor through the
+ *      back-EMF only: it locks once the start-up gives it some, and loses the
+ *      angle when the reversal passes through zero speed, the slowest lock of
+ *      the three. The PLL has its input at any speed and only lags while the
+ *      rotor accelerates.
+ *
+ *      Usage: observer_check [--inverter averaged|switched|both] [--trace file.csv]
+ *
+ *      Exit status: 0 every check passes, 1 otherwise, 2 on a usage error.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "pll.h"
+#include "smo.h"
+
+#include "closed_loop.hpp"
+
+using mc::sim::ClosedLoop;
+using mc::sim::Inverter;
+using mc::sim::LoopParams;
+using mc::sim::PmsmParams;
+
+namespace {
+
+struct Options
+{
+    bool        averaged = true;
+    bool        switched = true;
+    const char* trace    = nullptr;
+};
+
+constexpr float32_t kLockTol = 0.1f;    // rad
+
+struct Segment
+{
+    double      t_end;          // s
+    float32_t   omega_ref;      // mechanical, rad/s
+    float32_t   TL;             // Nm
+    double      smo_lock;       // s
+    double      pll_lock;       // s
+};
+
+const Segment kProfile[] = {
+    {0.3, 200.0f, 0.0f, 0.15, 0.03},
+    {0.6, 200.0f, 0.5f, 0.05, 0.01},
+    {1.0, -150.0f, 0.5f, 0.3, 0.03},
+};
+
+struct Limits
+{
+    float32_t   angle_mean;     // rad
+    float32_t   angle_max;      // rad
+    float32_t   speed;          // mean, electrical rad/s
+};
+
+const Limits kSmoLimits = {0.08f, 0.15f, 15.0f};
+const Limits kPllLimits = {0.005f, 0.01f, 1.0f};
+
+Options parse_args(int argc, char** argv)
+{
+    Options opt;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--inverter") == 0 && i + 1 < argc) {
+            const char* v = argv[++i];
+            opt.averaged = std::strcmp(v, "switched") != 0;
+            opt.switched = std::strcmp(v, "averaged") != 0;
+        }
+        else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            opt.trace = argv[++i];
+        }
+        else {
+            std::fprintf(stderr, "usage: %s [--inverter averaged|switched|both] [--trace file.csv]\n", argv[0]);
+            std::exit(2);
+        }
+    }
+    return opt;
+}
+
+// wrapped to [-PI, PI)
+float32_t angle_diff(float32_t a, float32_t b)
+{
+    float32_t d = a - b;
+    while (d >= PI) {
+        d -= TWO_PI;
+    }
+    while (d < -PI) {
+        d += TWO_PI;
+    }
+    return d;
+}
+
+// per-segment statistics of one estimate
+struct Track
+{
+    uint64_t    last_bad = 0;   // last step of the segment outside kLockTol
+    double      err_sum = 0;
+    float32_t   err_max = 0;
+    double      speed_sum = 0;
+    uint64_t    n_tail = 0;
+
+    void add(uint64_t k, bool tail, float32_t err, float32_t speed_err)
+    {
+        const float32_t a = std::fabs(err);
+        if (a > kLockTol) {
+            last_bad = k;
+        }
+        if (tail) {
+            err_sum += a;
+            err_max = a > err_max ? a : err_max;
+            speed_sum += std::fabs(speed_err);
+            n_tail++;
+        }
+    }
+};
+
+bool report(const char* name, const Segment& g, double t0, double lock_max, double Ts, uint64_t k0, const Track& t,
+            const Limits& lim)
+{
+    const double n = (double)(t.n_tail ? t.n_tail : 1);
+    const double lock = t.last_bad < k0 ? 0.0 : (double)(t.last_bad + 1 - k0) * Ts;
+    const float32_t mean = (float32_t)(t.err_sum / n);
+    const float32_t speed = (float32_t)(t.speed_sum / n);
+    const bool pass = lock <= lock_max && mean <= lim.angle_mean && t.err_max <= lim.angle_max && speed <= lim.speed;
+    std::printf("  %-4s %.1f-%.1fs  lock %6.1f ms (max %3.0f)  angle mean %.4f max %.4f rad  speed %6.2f rad/s  %s\n",
+                name, t0, g.t_end, lock * 1e3, lock_max * 1e3, mean, t.err_max, speed, pass ? "ok" : "FAIL");
+    return pass;
+}
+
+// returns false when a check failed
+bool run(const Options& opt, Inverter inv, const char* name)
+{
+    PmsmParams prm;
+    LoopParams lp;
+    lp.inverter = inv;
+    ClosedLoop loop(prm, lp);
+
+    // back-EMF up to p*omega*psi = 16 V at 200 rad/s; tracker about 200 rad/s wide
+    // at that amplitude, the back-EMF filter well above the electrical speed
+    SMO_Obj_t smo;
+    const float32_t Ls = 0.5f * (prm.Ld + prm.Lq);
+    smo_init(&smo, prm.Rs, Ls, lp.Ts, 24.0f, 0.1f, 3000.0f, 25.0f, 2500.0f, 3000.0f);
+
+    // unit amplitude, loop filter at about 150 Hz, critically damped
+    PLL_Obj_t pll;
+    pll_init(&pll, lp.Ts, 1900.0f, 9.0e5f, 3000.0f, 2000.0f);
+    pll_reset(&pll, PI, 0.0f);
+
+    std::FILE* trace = nullptr;
+    if (opt.trace != nullptr) {
+        std::string p(opt.trace);
+        if (opt.averaged && opt.switched) {
+            p += std::string(".") + name;
+        }
+        trace = std::fopen(p.c_str(), "w");
+        if (trace != nullptr) {
+            std::fprintf(trace, "t,theta_e,omega_e,smo_theta,smo_omega,pll_theta,pll_omega\n");
+        }
+    }
+
+    std::printf("%s\n", name);
+    float32_t v_alpha = 0, v_beta = 0;     // applied over the last period
+    bool      ok = true;
+    uint64_t  k = 0;
+    double    t0 = 0;
+    for (const Segment& g : kProfile) {
+        loop.omega_ref = g.omega_ref;
+        loop.plant.TL = g.TL;
+        const uint64_t k0 = k;
+        const uint64_t k_end = (uint64_t)(g.t_end / lp.Ts + 0.5);
+        const uint64_t k_tail = k_end - (k_end - k0) / 5;
+        Track smo_t, pll_t;
+
+        for (; k < k_end; k++) {
+            float32_t ia, ib, ic;
+            loop.plant.phase_currents(ia, ib, ic);
+            smo_update(&smo, v_alpha, v_beta, ia, SQRT3REC * (ia + 2 * ib));
+
+            const float32_t theta = loop.plant.theta_e;
+            const float32_t omega_e = prm.p * loop.plant.omega_m;
+            pll_update(&pll, std::sin(theta), std::cos(theta));
+
+            smo_t.add(k, k >= k_tail, angle_diff(smo.theta, theta), smo.omega - omega_e);
+            if (trace != nullptr && k % 20 == 0) {
+                std::fprintf(trace, "%.6f,%g,%g,%g,%g,%g,%g\n", (double)k * lp.Ts, theta, omega_e, smo.theta, smo.omega,
+                             pll.theta_e, pll.omega_f);
+            }
+
+            loop.step();
+            v_alpha = loop.T.AB0.alpha;
+            v_beta = loop.T.AB0.beta;
+
+            // the PLL angle is the one for the next period
+            pll_t.add(k, k >= k_tail, angle_diff(pll.theta_e, loop.plant.theta_e), pll.omega_f - omega_e);
+        }
+        ok = report("smo", g, t0, g.smo_lock, lp.Ts, k0, smo_t, kSmoLimits) && ok;
+        ok = report("pll", g, t0, g.pll_lock, lp.Ts, k0, pll_t, kPllLimits) && ok;
+        t0 = g.t_end;
+    }
+
+    if (trace != nullptr) {
+        std::fclose(trace);
+    }
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opt = parse_args(argc, argv);
+    bool ok = true;
+
+    if (opt.averaged) {
+        ok = run(opt, Inverter::averaged, "averaged") && ok;
+    }
+    if (opt.switched) {
+        ok = run(opt, Inverter::switched, "switched") && ok;
+    }
+
+    std::printf("observer convergence: %s\n", ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
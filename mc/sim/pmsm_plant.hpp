@@ -0,0 +1,248 @@
+/**
+ * @file       pmsm_plant.hpp
+ * @date       Oct 2026
+ *
+ * @brief      native PMSM + inverter plant model for closed-loop runs on the host
+ *
+ *      Rotor-frame (dq) electrical model of a salient-pole PMSM
+ *
+ *          Ld did/dt = vd - Rs id + we Lq iq
+ *          Lq diq/dt = vq - Rs iq - we (Ld id + psi)
+ *          Te = 3/2 p (psi iq + (Ld - Lq) id iq)
+ *          J dwm/dt = Te - B wm - TL,   dtheta_e/dt = p wm
+ *
+ *      fed by a two-level inverter from the three phase duties of modulator().
+ *      step() advances one PWM period:
+ *        - Inverter::averaged    the period-average phase voltages, one exact
+ *                                (exponential) R-L step in dq
+ *        - Inverter::switched    center-aligned PWM, the period split at the six
+ *                                switching edges and each of the seven intervals
+ *                                integrated with its own voltage vector, so the
+ *                                current ripple is there
+ *      Voltages are phase-to-neutral, star point floating. The sin/cos of the
+ *      electrical angle at the start of the period is kept in sc, an ideal
+ *      position sensor can hand it to the controller as is. It is rotated by the
+ *      angle increment each period and re-evaluated with trig_sincos() every
+ *      kResync periods, which keeps trig_sincos() off the per-step path.
+ */
+#ifndef PMSM_PLANT_HPP_
+    #define PMSM_PLANT_HPP_
+
+#include <cmath>
+
+#include "ctrl_common.h"
+#include "trig.h"
+
+namespace mc {
+namespace sim {
+
+struct PmsmParams
+{
+    float32_t Rs   = 0.5f;      // stator resistance, ohm
+    float32_t Ld   = 1.2e-3f;   // d inductance, H
+    float32_t Lq   = 1.5e-3f;   // q inductance, H
+    float32_t psi  = 0.02f;     // PM flux linkage, Wb
+    float32_t p    = 4.0f;      // pole pairs
+    float32_t J    = 5e-5f;     // rotor + load inertia, kg m^2
+    float32_t B    = 1e-5f;     // viscous friction, Nm s/rad
+    float32_t Vdc  = 48.0f;     // DC link, V
+};
+
+enum class Inverter
+{
+    averaged,
+    switched,
+};
+
+class PmsmPlant
+{
+public:
+    // state, read by the sensor model
+    float32_t id      = 0;      // A
+    float32_t iq      = 0;      // A
+    float32_t omega_m = 0;      // mechanical speed, rad/s
+    float32_t theta_e = 0;      // electrical angle, [0, 2*PI)
+    float32_t Te      = 0;      // electromagnetic torque of the last period, Nm
+    float32_t TL      = 0;      // load torque, Nm, set by the caller
+    SinCos_t  sc      = {0.0f, 1.0f};
+
+    PmsmPlant(const PmsmParams& prm, float32_t Ts, Inverter inv)
+        : prm_(prm), Ts_(Ts), inv_(inv)
+    {
+        ad_ = std::exp(-prm.Rs * Ts / prm.Ld);
+        aq_ = std::exp(-prm.Rs * Ts / prm.Lq);
+        bd_ = (1.0f - ad_) / prm.Rs;
+        bq_ = (1.0f - aq_) / prm.Rs;
+        Ld_rec_ = 1.0f / prm.Ld;
+        Lq_rec_ = 1.0f / prm.Lq;
+        kv_alpha_ = prm.Vdc * TWO_THIRD;
+        kv_beta_ = prm.Vdc * SQRT3REC;
+        kt_psi_ = 1.5f * prm.p * prm.psi;
+        kt_rel_ = 1.5f * prm.p * (prm.Ld - prm.Lq);
+        kw_ = Ts / prm.J;
+        kth_ = Ts * prm.p;
+        trig_sincos(theta_e, &sc);
+    }
+
+    const PmsmParams& params() const { return prm_; }
+    float32_t Ts() const { return Ts_; }
+
+    /**
+     * @brief      Sets the rotor angle and speed, currents to zero
+     */
+    void reset(float32_t theta, float32_t omega)
+    {
+        id = iq = Te = 0;
+        omega_m = omega;
+        theta_e = theta;
+        trig_sincos(theta_e, &sc);
+    }
+
+    /**
+     * @brief      Phase currents as a current sensor sees them, a+b+c = 0
+     */
+    void phase_currents(float32_t& ia, float32_t& ib, float32_t& ic) const
+    {
+        float32_t i_alpha = id * sc.cos - iq * sc.sin;
+        float32_t i_beta  = id * sc.sin + iq * sc.cos;
+        ia = i_alpha;
+        ib = -0.5f * i_alpha + SIN60 * i_beta;
+        ic = -ia - ib;
+    }
+
+    /**
+     * @brief      Advances one PWM period
+     *
+     * @param[in]  duty  duty cycles of phase a, b, c in [0, 1]
+     */
+    void step(const float32_t duty[3])
+    {
+        float32_t we = prm_.p * omega_m;
+
+        if (inv_ == Inverter::averaged) {
+            float32_t vd, vq;
+            to_dq(duty[0], duty[1], duty[2], vd, vq);
+            float32_t id1 = ad_ * id + bd_ * (vd + we * prm_.Lq * iq);
+            float32_t iq1 = aq_ * iq + bq_ * (vq - we * (prm_.Ld * id + prm_.psi));
+            id = id1;
+            iq = iq1;
+        }
+        else {
+            step_switched(duty, we);
+        }
+
+        Te = iq * (kt_psi_ + kt_rel_ * id);
+        omega_m += kw_ * (Te - prm_.B * omega_m - TL);
+
+        float32_t dtheta = kth_ * omega_m;
+        theta_e += dtheta;
+        if (theta_e >= TWO_PI) {
+            theta_e -= TWO_PI;
+        }
+        else if (theta_e < 0.0f) {
+            theta_e += TWO_PI;
+        }
+
+        if (++resync_ >= kResync) {
+            resync_ = 0;
+            trig_sincos(theta_e, &sc);
+        }
+        else {
+            rotate(dtheta);
+        }
+    }
+
+private:
+    static constexpr uint32_t kResync = 256;    // steps between exact sin/cos evaluations
+
+    // sc advanced by a small angle, Taylor terms up to dtheta^4: below 1e-7 per step
+    // for |dtheta| < 0.1 rad; the float rounding that builds up in between is reset
+    // by the next trig_sincos()
+    void rotate(float32_t dtheta)
+    {
+        float32_t d2 = dtheta * dtheta;
+        float32_t c  = 1.0f - d2 * (0.5f - d2 * (1.0f / 24.0f));
+        float32_t s  = dtheta * (1.0f - d2 * ONE_SIXTH);
+        float32_t s1 = sc.sin * c + sc.cos * s;
+        float32_t c1 = sc.cos * c - sc.sin * s;
+        sc.sin = s1;
+        sc.cos = c1;
+    }
+
+    // phase-to-neutral voltages of the pole states (duties or 0/1 switch states) to dq
+    void to_dq(float32_t a, float32_t b, float32_t c, float32_t& vd, float32_t& vq) const
+    {
+        float32_t v_alpha = kv_alpha_ * (a - 0.5f * (b + c));
+        float32_t v_beta  = kv_beta_ * (b - c);
+        vd = v_alpha * sc.cos + v_beta * sc.sin;
+        vq = v_beta * sc.cos - v_alpha * sc.sin;
+    }
+
+    void step_switched(const float32_t duty[3], float32_t we)
+    {
+        // phase x is on for |t - Ts/2| < duty_x*Ts/2: order the phases by duty,
+        // the edges are at (1 -+ duty)/2 * Ts
+        float32_t d[3];
+        for (int k = 0; k < 3; k++) {
+            d[k] = duty[k];
+            SATURATE(d[k], 1.0f, 0.0f);
+        }
+
+        int hi = 0, mid = 1, lo = 2;
+        if (d[hi] < d[mid]) { int t = hi; hi = mid; mid = t; }
+        if (d[mid] < d[lo]) { int t = mid; mid = lo; lo = t; }
+        if (d[hi] < d[mid]) { int t = hi; hi = mid; mid = t; }
+
+        const float32_t t_edge[4] = {0.0f, 0.5f * (1.0f - d[hi]), 0.5f * (1.0f - d[mid]), 0.5f * (1.0f - d[lo])};
+        float32_t s[3] = {0.0f, 0.0f, 0.0f};
+        const int on_order[3] = {hi, mid, lo};
+
+        // first half: 000 -> hi -> hi+mid -> all on, second half mirrored
+        for (int half = 0; half < 2; half++) {
+            for (int k = 0; k < 4; k++) {
+                float32_t dt;
+                if (half == 0) {
+                    dt = (k < 3 ? t_edge[k + 1] : 0.5f) - t_edge[k];
+                    if (k > 0) {
+                        s[on_order[k - 1]] = 1.0f;
+                    }
+                }
+                else {
+                    int j = 3 - k;      // mirrored: all on -> hi+mid -> hi -> 000
+                    dt = (j < 3 ? t_edge[j + 1] : 0.5f) - t_edge[j];
+                    if (k > 0) {
+                        s[on_order[3 - k]] = 0.0f;
+                    }
+                }
+                if (dt > 0.0f) {
+                    euler_dq(s, we, dt * Ts_);
+                }
+            }
+        }
+    }
+
+    void euler_dq(const float32_t s[3], float32_t we, float32_t dt)
+    {
+        float32_t vd, vq;
+        to_dq(s[0], s[1], s[2], vd, vq);
+        float32_t did = Ld_rec_ * (vd - prm_.Rs * id + we * prm_.Lq * iq);
+        float32_t diq = Lq_rec_ * (vq - prm_.Rs * iq - we * (prm_.Ld * id + prm_.psi));
+        id += dt * did;
+        iq += dt * diq;
+    }
+
+    PmsmParams prm_;
+    float32_t  Ts_;
+    uint32_t   resync_ = 0;
+    Inverter   inv_;
+    float32_t  ad_, aq_, bd_, bq_;      // exact R-L step over Ts
+    float32_t  Ld_rec_, Lq_rec_;         // switched: Euler steps
+    float32_t  kv_alpha_, kv_beta_;     // pole states to alpha/beta volts
+    float32_t  kt_psi_, kt_rel_;        // torque, PM and reluctance part
+    float32_t  kw_, kth_;               // Ts/J, Ts*p
+};
+
+} // namespace sim
+} // namespace mc
+
+#endif // <-- !defined PMSM_PLANT_HPP_
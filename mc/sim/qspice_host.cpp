@@ -0,0 +1,350 @@
+/**
+ * @file       qspice_host.cpp
+ * @date       Oct 2026
+ *
+ * @brief      Host stand-in for Qspice that drives the block modules of src/apps
+ *
+ *      Loads <block>.so (MC_BUILD_QSPICE_BLOCKS) and calls it the way Qspice
+ *      calls the DLL: the entry point once per accepted step with the port
+ *      array, MaxExtStepSize() before each step, Trunc() on each tentative step
+ *      (a shortened step is tried again), Destroy() at the end. The clock port
+ *      is a 50% square wave of period Ts with an odd phase, the other inputs
+ *      slow sines; the parameters of the blocks are fixed.
+ *
+ *      The clock has no breakpoints (as one from logic or another block), so the
+ *      simulator only sees it at its steps. Every block is run over --periods
+ *      clock periods:
+ *        fine      no step hints, global step limit Ts/100, the fallback
+ *        coarse    no step hints, global step limit 0.4 Ts, the longest that
+ *                  still sees every pulse
+ *        hints     MaxExtStepSize() and Trunc(), global step limit 0.4 Ts
+ *        no-trunc  MaxExtStepSize() only, global step limit 0.4 Ts
+ *        open      MaxExtStepSize() and Trunc(), global step limit 10 Ts; only
+ *                  blocks with a Ts parameter, the others cannot find the clock
+ *      and for each it reports the accepted steps, the Trunc() retries, the
+ *      clock edges the block missed (stepped over) and the delay from each edge
+ *      to the step that updates the block.
+ *
+ *      Usage: qspice_host [block ...] [--Ts s] [--periods N] [--dir path]
+ *
+ *      Exit status: 0 when the hints and open runs missed no edge and updated
+ *      within 2 ns of each edge, and the open runs took at most 3 steps per
+ *      period; 1 otherwise, 2 on a load or usage error.
+ */
+
+#include <dlfcn.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifndef MC_QSPICE_DIR
+    #define MC_QSPICE_DIR "."
+#endif
+
+namespace {
+
+// as Qspice passes it, same layout as in qspice_block.hpp
+union uData
+{
+    bool b;
+    char c;
+    unsigned char uc;
+    short s;
+    unsigned short us;
+    int i;
+    unsigned int ui;
+    float f;
+    double d;
+    long long int i64;
+    unsigned long long int ui64;
+    char* str;
+    unsigned char* bytes;
+};
+
+using EvalFn    = void (*)(void** opaque, double t, uData* data);
+using MaxStepFn = double (*)(void* inst, double t);
+using TruncFn   = void (*)(void* inst, double t, uData* data, double* timestep);
+using DestroyFn = void (*)(void* inst);
+using PrintFn   = int (*)(const char* format, ...);
+
+struct Param
+{
+    int     port;
+    char    type;       // 'f' float, 'b' bool, 'i' int
+    double  value;
+};
+
+// the symbol of a block: its ports and a working set of parameters
+struct BlockDesc
+{
+    const char*         name;
+    int                 n_ports;
+    int                 clk;
+    std::vector<int>    inputs;     // float inputs, driven with sines
+    std::vector<Param>  params;     // Ts as -1: the Ts of the run
+    bool                has_ts;
+};
+
+const std::vector<BlockDesc>& blocks()
+{
+    static const std::vector<BlockDesc> list = {
+        {"clarke", 5, 2, {0, 1}, {}, false},
+        {"iclarke", 6, 2, {0, 1}, {}, false},
+        {"park", 6, 2, {0, 1, 3}, {}, false},
+        {"ipark", 6, 2, {0, 1, 3}, {}, false},
+        {"lpf_1st", 6, 1, {0}, {{2, 'f', 0.1}, {3, 'f', 0.1}, {4, 'f', 0.8}}, false},
+        {"pid_controller", 16, 1, {0, 2, 3},
+         {{4, 'f', 10}, {5, 'f', -10}, {6, 'f', 1e3}, {7, 'f', 1}, {8, 'f', -1}, {9, 'f', 1e-3},
+          {10, 'b', 1}, {11, 'f', 0}, {12, 'b', 0}, {13, 'f', 1}}, true},
+        {"smobldc", 19, 4, {0, 1, 2, 3},
+         {{5, 'f', 0.5}, {6, 'f', 1e-3}, {7, 'f', -1}, {8, 'f', 50}, {9, 'f', 0.5}, {10, 'f', 2000},
+          {11, 'f', 100}, {12, 'f', 1e4}, {13, 'f', 3000}}, true},
+        {"svmgen", 8, 2, {0, 1}, {{3, 'i', 0}}, false},
+    };
+    return list;
+}
+
+struct Options
+{
+    std::vector<std::string>    names;
+    double                      Ts      = 100e-6;
+    uint32_t                    periods = 2000;
+    std::string                 dir     = MC_QSPICE_DIR;
+};
+
+struct Mode
+{
+    const char* name;
+    double      dtmax;      // in Ts
+    bool        max_step;
+    bool        trunc;
+    bool        needs_ts;
+};
+
+struct Result
+{
+    uint64_t    steps     = 0;
+    uint64_t    retries   = 0;
+    uint64_t    edges     = 0;      // clock edges in the run
+    uint64_t    updates   = 0;      // edges the block saw
+    double      max_delay = 0;
+    double      sum_delay = 0;
+};
+
+int quiet_print(const char*, ...)
+{
+    return 0;
+}
+
+class Module
+{
+public:
+    ~Module()
+    {
+        if (handle_ != nullptr) {
+            ::dlclose(handle_);
+        }
+    }
+
+    bool open(const std::string& path, const char* name)
+    {
+        handle_ = ::dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (handle_ == nullptr) {
+            error_ = ::dlerror();
+            return false;
+        }
+        eval_     = reinterpret_cast<EvalFn>(::dlsym(handle_, name));
+        max_step_ = reinterpret_cast<MaxStepFn>(::dlsym(handle_, "MaxExtStepSize"));
+        trunc_    = reinterpret_cast<TruncFn>(::dlsym(handle_, "Trunc"));
+        destroy_  = reinterpret_cast<DestroyFn>(::dlsym(handle_, "Destroy"));
+        auto display = reinterpret_cast<PrintFn*>(::dlsym(handle_, "Display"));
+        if (eval_ == nullptr || destroy_ == nullptr) {
+            error_ = std::string("no ") + name + "() or Destroy()";
+            return false;
+        }
+        if (display != nullptr) {
+            *display = quiet_print;     // the init messages of four runs per block
+        }
+        return true;
+    }
+
+    const std::string& error() const { return error_; }
+
+    // one transient run, as the simulator would do it
+    Result run(const BlockDesc& b, const Options& opt, const Mode& m) const
+    {
+        const double Ts    = opt.Ts;
+        const double phase = 0.37 * Ts;
+        const double t_end = phase + opt.periods * Ts;
+        const double dtmax = m.dtmax * Ts;
+
+        std::vector<uData> data(b.n_ports);
+        for (auto& d : data) {
+            d.ui64 = 0;
+        }
+        for (const Param& p : b.params) {
+            double v = p.value == -1 ? Ts : p.value;
+            if (p.type == 'f') {
+                data[p.port].f = (float)v;
+            }
+            else if (p.type == 'b') {
+                data[p.port].b = v != 0;
+            }
+            else {
+                data[p.port].i = (int)v;
+            }
+        }
+        auto drive = [&](double t) {
+            double x = (t - phase) / Ts;
+            data[b.clk].b = t >= phase && x - std::floor(x) < 0.5;
+            for (size_t k = 0; k < b.inputs.size(); k++) {
+                data[b.inputs[k]].f = (float)(0.5 * std::sin(2 * M_PI * 50 * t + k));
+            }
+        };
+
+        Result r;
+        void* inst = nullptr;
+        double t = 0;
+        bool clk_n1 = false;
+        drive(t);
+        eval_(&inst, t, data.data());
+
+        while (t < t_end) {
+            double dt = dtmax;
+            if (m.max_step && max_step_ != nullptr) {
+                dt = std::min(dt, max_step_(inst, t));
+            }
+            for (int tries = 0; tries < 64; tries++) {
+                drive(t + dt);
+                if (!m.trunc || trunc_ == nullptr) {
+                    break;
+                }
+                double step = dt;
+                trunc_(inst, t + dt, data.data(), &step);
+                if (step >= dt) {
+                    break;
+                }
+                dt = step;
+                r.retries++;
+            }
+            t += dt;
+            eval_(&inst, t, data.data());
+            r.steps++;
+
+            const bool clk = data[b.clk].b;
+            if (clk && !clk_n1) {
+                double edge = phase + std::floor((t - phase) / Ts) * Ts;
+                double delay = t - edge;
+                r.updates++;
+                r.sum_delay += delay;
+                r.max_delay = std::max(r.max_delay, delay);
+            }
+            clk_n1 = clk;
+        }
+        r.edges = (uint64_t)std::floor((t - phase) / Ts) + 1;
+        destroy_(inst);
+        return r;
+    }
+
+private:
+    void*       handle_   = nullptr;
+    EvalFn      eval_     = nullptr;
+    MaxStepFn   max_step_ = nullptr;
+    TruncFn     trunc_    = nullptr;
+    DestroyFn   destroy_  = nullptr;
+    std::string error_;
+};
+
+Options parse_args(int argc, char** argv)
+{
+    Options opt;
+    bool ok = true;
+    for (int i = 1; i < argc; i++) {
+        bool more = i + 1 < argc;
+        if (std::strcmp(argv[i], "--Ts") == 0 && more) {
+            opt.Ts = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--periods") == 0 && more) {
+            opt.periods = (uint32_t)std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--dir") == 0 && more) {
+            opt.dir = argv[++i];
+        }
+        else if (argv[i][0] != '-') {
+            opt.names.push_back(argv[i]);
+        }
+        else {
+            ok = false;
+        }
+    }
+    if (!ok || opt.Ts <= 0 || opt.periods == 0) {
+        std::fprintf(stderr, "usage: %s [block ...] [--Ts s] [--periods N] [--dir path]\n", argv[0]);
+        std::exit(2);
+    }
+    return opt;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opt = parse_args(argc, argv);
+    if (opt.names.empty()) {
+        for (const auto& b : blocks()) {
+            opt.names.push_back(b.name);
+        }
+    }
+
+    static const Mode modes[] = {
+        {"fine", 0.01, false, false, false},
+        {"coarse", 0.4, false, false, false},
+        {"hints", 0.4, true, true, false},
+        {"no-trunc", 0.4, true, false, false},
+        {"open", 10, true, true, true},
+    };
+
+    std::printf("Ts %g s, %u periods\n", opt.Ts, opt.periods);
+    std::printf("%-16s %-9s %10s %9s %8s %8s %12s %12s\n", "block", "mode", "steps", "steps/Ts", "retries",
+                "missed", "max delay", "mean delay");
+
+    bool pass = true;
+    for (const auto& name : opt.names) {
+        const BlockDesc* b = nullptr;
+        for (const auto& d : blocks()) {
+            if (name == d.name) {
+                b = &d;
+            }
+        }
+        if (b == nullptr) {
+            std::fprintf(stderr, "unknown block %s\n", name.c_str());
+            return 2;
+        }
+        Module mod;
+        std::string path = opt.dir + "/" + name + ".so";
+        if (!mod.open(path, b->name)) {
+            std::fprintf(stderr, "%s: %s\n", path.c_str(), mod.error().c_str());
+            return 2;
+        }
+
+        for (const Mode& m : modes) {
+            if (m.needs_ts && !b->has_ts) {
+                continue;
+            }
+            Result r = mod.run(*b, opt, m);
+            uint64_t missed = r.edges > r.updates ? r.edges - r.updates : 0;
+            double per_ts = (double)r.steps / (double)r.edges;
+            std::printf("%-16s %-9s %10llu %9.2f %8llu %8llu %10.3g s %10.3g s\n", b->name, m.name,
+                        (unsigned long long)r.steps, per_ts, (unsigned long long)r.retries,
+                        (unsigned long long)missed, r.max_delay, r.updates ? r.sum_delay / r.updates : 0.0);
+            if (m.max_step && m.trunc && (missed > 0 || r.max_delay > 2e-9 || (m.needs_ts && per_ts > 3.0))) {
+                pass = false;
+            }
+        }
+    }
+    return pass ? 0 : 1;
+}
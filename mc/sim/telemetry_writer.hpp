@@ -0,0 +1,201 @@
+/**
+ * @file       telemetry_writer.hpp
+ * @date       Oct 2026
+ *
+ * @brief      background consumer that drains a Telem_Ring_t to a file or a TCP socket (POSIX)
+ *
+ *      The stream is one Telem_Header_t followed by the raw Telem_Record_t's. The
+ *      thread takes up to kBatch records per telem_pop(), writes them with one
+ *      write() call and sleeps for idle_us when the ring is empty, so it never
+ *      touches the producer's cache line more than once per batch.
+ *
+ *      Destinations: a file path, or "tcp:<host>:<port>" for a socket.
+ */
+#ifndef TELEMETRY_WRITER_HPP_
+    #define TELEMETRY_WRITER_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "telemetry.h"
+
+namespace mc {
+namespace sim {
+
+class TelemetryWriter
+{
+public:
+    static constexpr uint32_t kBatch = 1024;
+#if defined(MSG_NOSIGNAL)
+    static constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+    static constexpr int kSendFlags = 0;        // SO_NOSIGPIPE is set on the socket instead
+#endif
+
+    TelemetryWriter(Telem_Ring_t& ring, float32_t Ts, unsigned idle_us = 200)
+        : ring_(ring), Ts_(Ts), idle_us_(idle_us), batch_(kBatch)
+    {
+    }
+
+    ~TelemetryWriter()
+    {
+        stop();
+    }
+
+    TelemetryWriter(const TelemetryWriter&) = delete;
+    TelemetryWriter& operator=(const TelemetryWriter&) = delete;
+
+    /**
+     * @brief      Opens the destination, writes the header and starts the thread
+     *
+     * @return     false if the destination could not be opened
+     */
+    bool start(const char* dest)
+    {
+        fd_ = open_dest(dest);
+        socket_ = std::strncmp(dest, "tcp:", 4) == 0;
+        if (fd_ < 0) {
+            return false;
+        }
+        Telem_Header_t h;
+        std::memset(&h, 0, sizeof(h));
+        h.magic = TELEM_MAGIC;
+        h.version = TELEM_VERSION;
+        h.record_size = (uint16_t)sizeof(Telem_Record_t);
+        h.Ts = Ts_;
+        if (!write_all(&h, sizeof(h))) {
+            ::close(fd_);
+            fd_ = -1;
+            return false;
+        }
+        run_.store(true, std::memory_order_relaxed);
+        thread_ = std::thread([this] { loop(); });
+        return true;
+    }
+
+    /**
+     * @brief      Drains what is left in the ring, stops the thread and closes
+     */
+    void stop()
+    {
+        if (thread_.joinable()) {
+            run_.store(false, std::memory_order_release);
+            thread_.join();
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    // records that reached the destination; after a failed write the rest are drained and dropped
+    uint64_t written() const { return written_.load(std::memory_order_relaxed); }
+    bool     failed() const { return failed_.load(std::memory_order_relaxed); }
+
+private:
+    static int open_dest(const char* dest)
+    {
+        if (std::strncmp(dest, "tcp:", 4) != 0) {
+            return ::open(dest, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        }
+
+        std::string hp(dest + 4);
+        size_t colon = hp.rfind(':');
+        if (colon == std::string::npos) {
+            return -1;
+        }
+        std::string host = hp.substr(0, colon);
+        std::string port = hp.substr(colon + 1);
+
+        addrinfo hints;
+        std::memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* res = nullptr;
+        if (getaddrinfo(host.c_str(), port.c_str(), &hints, &res) != 0) {
+            return -1;
+        }
+        int fd = -1;
+        for (addrinfo* a = res; a != nullptr; a = a->ai_next) {
+            fd = ::socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+            if (fd < 0) {
+                continue;
+            }
+            if (::connect(fd, a->ai_addr, a->ai_addrlen) == 0) {
+#if !defined(MSG_NOSIGNAL) && defined(SO_NOSIGPIPE)
+                int one = 1;
+                setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+                break;
+            }
+            ::close(fd);
+            fd = -1;
+        }
+        freeaddrinfo(res);
+        return fd;
+    }
+
+    bool write_all(const void* p, size_t n)
+    {
+        const char* c = static_cast<const char*>(p);
+        while (n > 0) {
+            // a closed peer fails the send instead of raising SIGPIPE
+            ssize_t w = socket_ ? ::send(fd_, c, n, kSendFlags) : ::write(fd_, c, n);
+            if (w <= 0) {
+                failed_.store(true, std::memory_order_relaxed);
+                return false;
+            }
+            c += w;
+            n -= (size_t)w;
+        }
+        return true;
+    }
+
+    void loop()
+    {
+        for (;;) {
+            bool running = run_.load(std::memory_order_acquire);
+            uint32_t n = telem_pop(&ring_, batch_.data(), kBatch);
+            if (n > 0) {
+                // after a failure the ring is still drained, but nothing more is counted
+                if (!failed_.load(std::memory_order_relaxed) && write_all(batch_.data(), n * sizeof(Telem_Record_t))) {
+                    written_.fetch_add(n, std::memory_order_relaxed);
+                }
+            }
+            else if (!running) {
+                return;     // stop() was called before this empty pop: all drained
+            }
+            else {
+                std::this_thread::sleep_for(std::chrono::microseconds(idle_us_));
+            }
+        }
+    }
+
+    Telem_Ring_t&               ring_;
+    float32_t                   Ts_;
+    unsigned                    idle_us_;
+    std::vector<Telem_Record_t> batch_;
+    int                         fd_ = -1;
+    bool                        socket_ = false;
+    std::thread                 thread_;
+    std::atomic<bool>           run_{false};
+    std::atomic<bool>           failed_{false};
+    std::atomic<uint64_t>       written_{0};
+};
+
+} // namespace sim
+} // namespace mc
+
+#endif // <-- !defined TELEMETRY_WRITER_HPP_
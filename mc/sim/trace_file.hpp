@@ -0,0 +1,533 @@
+/**
+ * @file       trace_file.hpp
+ * @date       Oct 2026
+ *
+ * @brief      memory-mapped columnar trace format: streaming writer and mmap reader (POSIX)
+ *
+ *      A trace is a fixed set of named float32 channels sampled every Ts, plus a
+ *      few named constants (gains, Vdc, ...). The samples are cut into blocks of
+ *      up to block_len; inside a block every channel is one contiguous column, so
+ *      a reader touches only the columns it needs and walks them linearly.
+ *
+ *      File layout (little endian, offsets from the start of the file):
+ *          TraceHeader                     64 B
+ *          TraceChannel[n_channels]        32 B each
+ *          TraceParam[n_params]            32 B each
+ *          blocks                          each 64 B aligned
+ *          uint64_t index[n_blocks]        block offsets, at index_offset
+ *
+ *      Until close() the header holds index_offset = kTraceNotClosed, so the
+ *      capture of a writer that was killed is refused instead of read as empty.
+ *
+ *      A block is a TraceBlock followed by the columns in channel order, each
+ *      4 B aligned:
+ *          TraceEncoding::raw          float32_t[n]
+ *          TraceEncoding::delta16      int32_t q0, int16_t step[n - 1]; value = q * quantum
+ *      delta16 is meant for slow channels (speed, references, Vdc): the values
+ *      are rounded to the channel's quantum and stored as 16-bit steps, half the
+ *      size of raw. A block in which a step does not fit keeps that channel raw
+ *      and flags it in raw_mask, so nothing is lost beyond the quantum. With a
+ *      power-of-two quantum the values on the grid decode exactly.
+ *
+ *      TraceWriter buffers one block and appends it with one fwrite(), its memory
+ *      does not depend on the trace length. TraceReader maps the file read-only
+ *      with sequential advice; raw columns are used in place, delta16 columns are
+ *      decoded into a caller buffer. prefetch() and release() keep a window of
+ *      the file resident, so a multi-gigabyte trace streams through a few
+ *      megabytes of memory.
+ */
+#ifndef TRACE_FILE_HPP_
+    #define TRACE_FILE_HPP_
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "commontypes.h"
+
+namespace mc {
+namespace sim {
+
+constexpr char     kTraceMagic[8]   = {'M', 'C', 'T', 'R', 'A', 'C', 'E', 0};
+constexpr uint32_t kTraceVersion    = 1;
+constexpr uint32_t kTraceMaxChannels = 32;     // one raw_mask bit each
+constexpr uint64_t kTraceNotClosed  = UINT64_MAX;   // index_offset until close()
+
+enum class TraceEncoding : uint8_t
+{
+    raw     = 0,
+    delta16 = 1,
+};
+
+struct TraceHeader
+{
+    char        magic[8];
+    uint32_t    version;
+    uint32_t    n_channels;
+    uint32_t    n_params;
+    uint32_t    block_len;      // samples per block, the last block may be shorter
+    uint64_t    n_samples;
+    uint64_t    n_blocks;
+    uint64_t    index_offset;
+    float32_t   Ts;
+    uint32_t    reserved[3];
+};
+
+struct TraceChannel
+{
+    char        name[24];
+    uint8_t     encoding;       // TraceEncoding
+    uint8_t     reserved[3];
+    float32_t   quantum;        // delta16 resolution
+};
+
+struct TraceParam
+{
+    char        name[28];
+    float32_t   value;
+};
+
+struct TraceBlock
+{
+    uint32_t    n;              // samples in this block
+    uint32_t    raw_mask;       // bit c: delta16 channel c stored raw in this block
+};
+
+static_assert(sizeof(TraceHeader) == 64, "TraceHeader layout");
+static_assert(sizeof(TraceChannel) == 32, "TraceChannel layout");
+static_assert(sizeof(TraceParam) == 32, "TraceParam layout");
+
+// bytes of one column of n samples
+inline size_t trace_column_bytes(bool raw, uint32_t n)
+{
+    if (raw || n == 0) {
+        return (size_t)n * sizeof(float32_t);
+    }
+    return (sizeof(int32_t) + (size_t)(n - 1) * sizeof(int16_t) + 3) & ~(size_t)3;
+}
+
+class TraceWriter
+{
+public:
+    explicit TraceWriter(float32_t Ts, uint32_t block_len = 4096) : Ts_(Ts), block_len_(block_len) {}
+
+    ~TraceWriter()
+    {
+        close();
+    }
+
+    TraceWriter(const TraceWriter&) = delete;
+    TraceWriter& operator=(const TraceWriter&) = delete;
+
+    /**
+     * @brief      Declares a channel, before open()
+     *
+     * @return     The channel's position in the sample passed to push()
+     */
+    uint32_t add_channel(const char* name, TraceEncoding enc = TraceEncoding::raw, float32_t quantum = 0)
+    {
+        TraceChannel c;
+        std::memset(&c, 0, sizeof(c));
+        std::strncpy(c.name, name, sizeof(c.name) - 1);
+        c.encoding = (uint8_t)enc;
+        c.quantum = quantum;
+        channels_.push_back(c);
+        return (uint32_t)channels_.size() - 1;
+    }
+
+    void add_param(const char* name, float32_t value)
+    {
+        TraceParam p;
+        std::memset(&p, 0, sizeof(p));
+        std::strncpy(p.name, name, sizeof(p.name) - 1);
+        p.value = value;
+        params_.push_back(p);
+    }
+
+    /**
+     * @brief      Creates the file and writes the channel and parameter tables
+     *
+     * @return     false if the file cannot be created or there are too many channels
+     */
+    bool open(const char* path)
+    {
+        if (channels_.empty() || channels_.size() > kTraceMaxChannels || block_len_ == 0) {
+            return false;
+        }
+        f_ = std::fopen(path, "wb");
+        if (f_ == nullptr) {
+            return false;
+        }
+        cols_.assign(channels_.size() * block_len_, 0.0f);
+        q_.resize(block_len_);
+
+        TraceHeader h = header();
+        put(&h, sizeof(h));
+        put(channels_.data(), channels_.size() * sizeof(TraceChannel));
+        put(params_.data(), params_.size() * sizeof(TraceParam));
+        pad64();
+        return ok_;
+    }
+
+    /**
+     * @brief      Appends one sample, one value per channel in add_channel() order
+     */
+    void push(const float32_t* sample)
+    {
+        for (size_t c = 0; c < channels_.size(); c++) {
+            cols_[c * block_len_ + fill_] = sample[c];
+        }
+        if (++fill_ == block_len_) {
+            flush_block();
+        }
+    }
+
+    /**
+     * @brief      Writes the last block, the block index and the final header
+     *
+     * @return     false if any write failed
+     */
+    bool close()
+    {
+        if (f_ == nullptr) {
+            return ok_;
+        }
+        if (fill_ > 0) {
+            flush_block();
+        }
+        uint64_t index_offset = pos_;
+        put(index_.data(), index_.size() * sizeof(uint64_t));
+
+        TraceHeader h = header();
+        h.index_offset = index_offset;
+        if (std::fseek(f_, 0, SEEK_SET) != 0 || std::fwrite(&h, sizeof(h), 1, f_) != 1) {
+            ok_ = false;
+        }
+        if (std::fclose(f_) != 0) {
+            ok_ = false;
+        }
+        f_ = nullptr;
+        return ok_;
+    }
+
+    uint64_t samples() const { return n_samples_; }
+    uint64_t bytes() const { return pos_; }
+
+private:
+    TraceHeader header() const
+    {
+        TraceHeader h;
+        std::memset(&h, 0, sizeof(h));
+        std::memcpy(h.magic, kTraceMagic, sizeof(h.magic));
+        h.version = kTraceVersion;
+        h.n_channels = (uint32_t)channels_.size();
+        h.n_params = (uint32_t)params_.size();
+        h.block_len = block_len_;
+        h.n_samples = n_samples_;
+        h.n_blocks = index_.size();
+        h.index_offset = kTraceNotClosed;
+        h.Ts = Ts_;
+        return h;
+    }
+
+    void put(const void* p, size_t n)
+    {
+        if (n > 0 && std::fwrite(p, 1, n, f_) != n) {
+            ok_ = false;
+        }
+        pos_ += n;
+    }
+
+    void pad64()
+    {
+        static const uint8_t zeros[64] = {0};
+        put(zeros, (64 - pos_ % 64) % 64);
+    }
+
+    // quantizes column c into q_, false if a step does not fit 16 bits
+    bool quantize(size_t c, uint32_t n)
+    {
+        const float32_t* v = &cols_[c * block_len_];
+        double inv = 1.0 / (double)channels_[c].quantum;
+        for (uint32_t i = 0; i < n; i++) {
+            double q = std::nearbyint((double)v[i] * inv);
+            if (!(q >= INT32_MIN && q <= INT32_MAX)) {
+                return false;
+            }
+            q_[i] = (int32_t)q;
+            int64_t step = i > 0 ? (int64_t)q_[i] - q_[i - 1] : 0;
+            if (step < INT16_MIN || step > INT16_MAX) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void flush_block()
+    {
+        const uint32_t n = fill_;
+        TraceBlock b = {n, 0};
+
+        block_.clear();
+        block_.resize(sizeof(b));
+        for (size_t c = 0; c < channels_.size(); c++) {
+            bool raw = channels_[c].encoding != (uint8_t)TraceEncoding::delta16 || channels_[c].quantum <= 0 ||
+                       !quantize(c, n);
+            if (channels_[c].encoding == (uint8_t)TraceEncoding::delta16 && raw) {
+                b.raw_mask |= 1u << c;
+            }
+
+            size_t at = block_.size();
+            block_.resize(at + trace_column_bytes(raw, n), 0);
+            uint8_t* dst = &block_[at];
+            if (raw) {
+                std::memcpy(dst, &cols_[c * block_len_], (size_t)n * sizeof(float32_t));
+            }
+            else {
+                std::memcpy(dst, &q_[0], sizeof(int32_t));
+                for (uint32_t i = 1; i < n; i++) {
+                    int16_t step = (int16_t)(q_[i] - q_[i - 1]);
+                    std::memcpy(dst + sizeof(int32_t) + (i - 1) * sizeof(int16_t), &step, sizeof(step));
+                }
+            }
+        }
+        std::memcpy(block_.data(), &b, sizeof(b));
+
+        index_.push_back(pos_);
+        put(block_.data(), block_.size());
+        pad64();
+        n_samples_ += n;
+        fill_ = 0;
+    }
+
+    float32_t                 Ts_;
+    uint32_t                  block_len_;
+    std::vector<TraceChannel> channels_;
+    std::vector<TraceParam>   params_;
+    std::vector<float32_t>    cols_;        // one block, column-major
+    std::vector<int32_t>      q_;
+    std::vector<uint8_t>      block_;
+    std::vector<uint64_t>     index_;
+    std::FILE*                f_ = nullptr;
+    uint32_t                  fill_ = 0;
+    uint64_t                  n_samples_ = 0;
+    uint64_t                  pos_ = 0;
+    bool                      ok_ = true;
+};
+
+class TraceReader
+{
+public:
+    struct Block
+    {
+        uint32_t        n = 0;
+        const uint8_t*  col[kTraceMaxChannels];
+        bool            raw[kTraceMaxChannels];
+    };
+
+    TraceReader() = default;
+
+    ~TraceReader()
+    {
+        if (map_ != nullptr) {
+            ::munmap(map_, size_);
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
+    TraceReader(const TraceReader&) = delete;
+    TraceReader& operator=(const TraceReader&) = delete;
+
+    /**
+     * @brief      Maps the file and checks the header, the tables and the index
+     *
+     * @return     false with error() set if the file is not a valid trace
+     */
+    bool open(const char* path)
+    {
+        fd_ = ::open(path, O_RDONLY);
+        if (fd_ < 0) {
+            return fail("cannot open");
+        }
+        struct stat st;
+        if (::fstat(fd_, &st) != 0 || st.st_size < (off_t)sizeof(TraceHeader)) {
+            return fail("too short");
+        }
+        size_t size = (size_t)st.st_size;
+        void* m = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (m == MAP_FAILED) {
+            return fail("mmap failed");
+        }
+        map_ = static_cast<uint8_t*>(m);
+        size_ = size;
+        ::madvise(map_, size_, MADV_SEQUENTIAL);
+
+        std::memcpy(&h_, map_, sizeof(h_));
+        if (std::memcmp(h_.magic, kTraceMagic, sizeof(h_.magic)) != 0 || h_.version != kTraceVersion) {
+            return fail("not a trace file");
+        }
+        if (h_.n_channels == 0 || h_.n_channels > kTraceMaxChannels || h_.block_len == 0) {
+            return fail("bad header");
+        }
+        if (h_.index_offset == kTraceNotClosed) {
+            return fail("not closed (writer killed?)");
+        }
+        uint64_t tables = sizeof(TraceHeader) + (uint64_t)h_.n_channels * sizeof(TraceChannel) +
+                          (uint64_t)h_.n_params * sizeof(TraceParam);
+        if (tables > size_ || h_.index_offset > size_ || h_.n_blocks > (size_ - h_.index_offset) / sizeof(uint64_t)) {
+            return fail("truncated (writer not closed?)");
+        }
+        channels_.resize(h_.n_channels);
+        std::memcpy(channels_.data(), map_ + sizeof(TraceHeader), h_.n_channels * sizeof(TraceChannel));
+        params_.resize(h_.n_params);
+        std::memcpy(params_.data(), map_ + sizeof(TraceHeader) + h_.n_channels * sizeof(TraceChannel),
+                    h_.n_params * sizeof(TraceParam));
+        index_.resize(h_.n_blocks);
+        std::memcpy(index_.data(), map_ + h_.index_offset, h_.n_blocks * sizeof(uint64_t));
+        return true;
+    }
+
+    const TraceHeader& header() const { return h_; }
+    const std::string& error() const { return err_; }
+    size_t             size() const { return size_; }
+    uint64_t           blocks() const { return h_.n_blocks; }
+    const TraceChannel& channel_info(uint32_t c) const { return channels_[c]; }
+
+    // channel index by name, -1 if the trace has no such channel
+    int channel(const char* name) const
+    {
+        for (size_t c = 0; c < channels_.size(); c++) {
+            if (std::strncmp(channels_[c].name, name, sizeof(channels_[c].name)) == 0) {
+                return (int)c;
+            }
+        }
+        return -1;
+    }
+
+    bool param(const char* name, float32_t& value) const
+    {
+        for (const TraceParam& p : params_) {
+            if (std::strncmp(p.name, name, sizeof(p.name)) == 0) {
+                value = p.value;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief      Locates the columns of block b
+     *
+     * @return     false if the block lies outside the file
+     */
+    bool block(uint64_t b, Block& v) const
+    {
+        uint64_t at = index_[b];
+        if (at > size_ || size_ - at < sizeof(TraceBlock)) {
+            return false;
+        }
+        TraceBlock tb;
+        std::memcpy(&tb, map_ + at, sizeof(tb));
+        if (tb.n > h_.block_len) {
+            return false;
+        }
+        at += sizeof(tb);
+        v.n = tb.n;
+        for (uint32_t c = 0; c < h_.n_channels; c++) {
+            v.raw[c] = channels_[c].encoding != (uint8_t)TraceEncoding::delta16 || ((tb.raw_mask >> c) & 1u) != 0;
+            size_t bytes = trace_column_bytes(v.raw[c], tb.n);
+            if (size_ - at < bytes) {
+                return false;
+            }
+            v.col[c] = map_ + at;
+            at += bytes;
+        }
+        return true;
+    }
+
+    /**
+     * @brief      Values of channel c in block v
+     *
+     * @param      scratch  block_len floats, used for delta16 columns
+     *
+     * @return     Pointer into the mapping for raw columns, otherwise scratch
+     */
+    const float32_t* column(const Block& v, uint32_t c, float32_t* scratch) const
+    {
+        if (v.raw[c]) {
+            return reinterpret_cast<const float32_t*>(v.col[c]);
+        }
+        const uint8_t* p = v.col[c];
+        const float32_t quantum = channels_[c].quantum;
+        int32_t q;
+        std::memcpy(&q, p, sizeof(q));
+        const int16_t* step = reinterpret_cast<const int16_t*>(p + sizeof(int32_t));
+        if (v.n > 0) {
+            scratch[0] = (float32_t)q * quantum;
+        }
+        for (uint32_t i = 1; i < v.n; i++) {
+            q += step[i - 1];
+            scratch[i] = (float32_t)q * quantum;
+        }
+        return scratch;
+    }
+
+    // asks the kernel to read blocks [b, b + count) ahead of use
+    void prefetch(uint64_t b, uint64_t count) const
+    {
+        if (b >= h_.n_blocks) {
+            return;
+        }
+        uint64_t end = b + count < h_.n_blocks ? index_[b + count] : h_.index_offset;
+        advise(index_[b], end, MADV_WILLNEED);
+    }
+
+    // drops the pages of the blocks before b from this process
+    void release(uint64_t b) const
+    {
+        if (b < h_.n_blocks) {
+            advise(0, index_[b], MADV_DONTNEED);
+        }
+    }
+
+private:
+    void advise(uint64_t from, uint64_t to, int advice) const
+    {
+        const uint64_t page = (uint64_t)::sysconf(_SC_PAGESIZE);
+        from &= ~(page - 1);
+        to &= ~(page - 1);
+        if (to > from) {
+            ::madvise(map_ + from, (size_t)(to - from), advice);
+        }
+    }
+
+    bool fail(const char* what)
+    {
+        err_ = what;
+        return false;
+    }
+
+    TraceHeader               h_ = {};
+    std::vector<TraceChannel> channels_;
+    std::vector<TraceParam>   params_;
+    std::vector<uint64_t>     index_;
+    std::string               err_;
+    uint8_t*                  map_ = nullptr;
+    size_t                    size_ = 0;
+    int                       fd_ = -1;
+};
+
+} // namespace sim
+} // namespace mc
+
+#endif // <-- !defined TRACE_FILE_HPP_
@@ -0,0 +1,190 @@
+/**
+ * @file       trace_replay.cpp
+ * @date       Oct 2026
+ *
+ * @brief      Offline replay of a current-loop capture through the library kernels
+ *
+ *      Streams a trace (trace_file.hpp) of any size through CurrentLoopReplay,
+ *      i.e. abc2AB0() / AB02dq0_sincos() / PID_Update() / dq02AB0_sincos() /
+ *      modulator(), and diffs vd, vq and the duties against the recorded ones.
+ *      The file is memory-mapped and walked block by block: the blocks ahead are
+ *      prefetched and the ones behind released every --window MiB, so the
+ *      resident set stays around two windows whatever the trace length.
+ *
+ *      --scan only decodes every column (no kernels) and reports the read rate,
+ *      the upper bound of the replay.
+ *
+ *      Usage: trace_replay <trace> [--tol X] [--show N] [--window MiB] [--scan]
+ *
+ *        --tol X      largest |replayed - recorded| that is not a mismatch, default 0
+ *        --show N     print the first N mismatches, default 10
+ *
+ *      Exit status: 0 all outputs within tol, 1 mismatches, 2 bad trace or usage.
+ *      A trace is written by motor_sim --capture.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include "current_loop_trace.hpp"
+#include "trace_file.hpp"
+
+using mc::sim::CurrentLoopReplay;
+using mc::sim::ReplayDiff;
+using mc::sim::TraceReader;
+
+namespace {
+
+struct Options
+{
+    const char* path   = nullptr;
+    double      tol    = 0;
+    uint32_t    show   = 10;
+    uint64_t    window = 16;       // MiB
+    bool        scan   = false;
+};
+
+Options parse_args(int argc, char** argv)
+{
+    Options opt;
+    for (int i = 1; i < argc; i++) {
+        bool more = i + 1 < argc;
+        if (std::strcmp(argv[i], "--tol") == 0 && more) {
+            opt.tol = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--show") == 0 && more) {
+            opt.show = (uint32_t)std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--window") == 0 && more) {
+            opt.window = (uint64_t)std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--scan") == 0) {
+            opt.scan = true;
+        }
+        else if (argv[i][0] != '-' && opt.path == nullptr) {
+            opt.path = argv[i];
+        }
+        else {
+            opt.path = nullptr;
+            break;
+        }
+    }
+    if (opt.path == nullptr) {
+        std::fprintf(stderr, "usage: %s <trace> [--tol X] [--show N] [--window MiB] [--scan]\n", argv[0]);
+        std::exit(2);
+    }
+    if (opt.window == 0) {
+        opt.window = 1;
+    }
+    return opt;
+}
+
+// blocks per prefetch/release window
+uint64_t window_blocks(const TraceReader& r, uint64_t mib)
+{
+    uint64_t per_block = r.blocks() > 0 ? (r.size() / r.blocks()) : 1;
+    uint64_t n = (mib << 20) / (per_block ? per_block : 1);
+    return n ? n : 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opt = parse_args(argc, argv);
+
+    TraceReader r;
+    if (!r.open(opt.path)) {
+        std::fprintf(stderr, "%s: %s\n", opt.path, r.error().c_str());
+        return 2;
+    }
+    const auto& h = r.header();
+    std::printf("%s: %llu samples, %u channels, Ts %g s, %llu blocks of %u, %.1f MiB (%.1f B/sample)\n", opt.path,
+                (unsigned long long)h.n_samples, h.n_channels, h.Ts, (unsigned long long)h.n_blocks, h.block_len,
+                (double)r.size() / (1 << 20), h.n_samples ? (double)r.size() / (double)h.n_samples : 0.0);
+
+    CurrentLoopReplay replay(r);
+    if (!opt.scan && !replay.init()) {
+        std::fprintf(stderr, "%s: %s\n", opt.path, replay.error().c_str());
+        return 2;
+    }
+
+    const uint64_t win = window_blocks(r, opt.window);
+    std::vector<float32_t> scratch(h.block_len);
+    double checksum = 0;
+    uint64_t samples = 0;
+    uint32_t show = opt.show;
+    bool corrupt = false;
+
+    auto t0 = std::chrono::steady_clock::now();
+    r.prefetch(0, win);
+    for (uint64_t b = 0; b < r.blocks(); b++) {
+        if (b % win == 0 && b > 0) {
+            r.prefetch(b + win, win);
+            r.release(b - win);
+        }
+        if (opt.scan) {
+            TraceReader::Block v;
+            if (!r.block(b, v)) {
+                corrupt = true;
+                break;
+            }
+            for (uint32_t c = 0; c < h.n_channels; c++) {
+                const float32_t* x = r.column(v, c, scratch.data());
+                float32_t s = 0;
+                for (uint32_t i = 0; i < v.n; i++) {
+                    s += x[i];
+                }
+                checksum += s;
+            }
+            samples += v.n;
+        }
+        else {
+            uint32_t n = replay.run_block(b, opt.tol, show);
+            if (n == 0) {
+                corrupt = true;
+                break;
+            }
+            samples += n;
+        }
+    }
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    struct rusage ru;
+    ::getrusage(RUSAGE_SELF, &ru);
+    std::printf("%s %llu samples in %.3f s: %.1f Msamples/s, %.0f MiB/s, peak RSS %.1f MiB\n",
+                opt.scan ? "scanned" : "replayed", (unsigned long long)samples, wall, (double)samples / wall * 1e-6,
+                (double)r.size() / (1 << 20) / wall, (double)ru.ru_maxrss / 1024);
+    if (corrupt) {
+        std::fprintf(stderr, "%s: corrupt block after sample %llu\n", opt.path, (unsigned long long)samples);
+        return 2;
+    }
+    if (opt.scan) {
+        std::printf("checksum %.9g (sum of every channel)\n", checksum);
+        return 0;
+    }
+
+    uint64_t bad = 0;
+    std::printf("%-4s %12s %12s %12s %14s\n", "out", "max |err|", "rms", "mismatches", "first");
+    for (int o = 0; o < CurrentLoopReplay::kNumOutputs; o++) {
+        const ReplayDiff& d = replay.diff(o);
+        if (d.channel < 0) {
+            std::printf("%-4s %12s\n", d.name, "not recorded");
+            continue;
+        }
+        double rms = samples ? std::sqrt(d.sum_sq / (double)samples) : 0.0;
+        std::printf("%-4s %12.3g %12.3g %12llu", d.name, d.max_abs, rms, (unsigned long long)d.mismatches);
+        if (d.mismatches > 0) {
+            std::printf(" %14llu", (unsigned long long)d.first);
+        }
+        std::printf("\n");
+        bad += d.mismatches;
+    }
+    return bad > 0 ? 1 : 0;
+}
@@ -0,0 +1,218 @@
+/**
+ * @file        adc_clarke.c
+ * @date        Oct 2026
+ *
+ * @brief       fused ADC-count to Clarke (alpha, beta) front end
+ *
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "adc_clarke.h"
+#include "instrument.h"
+
+// folds gain and offset into the Clarke rows, in double
+static void adc_clarke_fold(AdcClarke_Obj_t* const fe)
+{
+    const double r3 = 1.0 / sqrt(3.0);
+    double ka[3] = {0, 0, 0}, kb[3] = {0, 0, 0}, kz[3] = {0, 0, 0};
+    double ca = 0, cb = 0, cz = 0;
+    double g[3];
+    int16_t x;
+
+    for (x = 0; x < 3; x++) {
+        g[x] = (double)fe->gain[x];
+    }
+
+    if (fe->n_sensors == 2) {
+        // c = -a - b: alpha = a, beta = (a + 2 b) / sqrt(3)
+        ka[0] = g[0];
+        kb[0] = g[0] * r3;
+        kb[1] = 2.0 * g[1] * r3;
+    }
+    else {
+        ka[0] = 2.0 * g[0] / 3.0;
+        ka[1] = -g[1] / 3.0;
+        ka[2] = -g[2] / 3.0;
+        kb[1] = g[1] * r3;
+        kb[2] = -g[2] * r3;
+        kz[0] = g[0] / 3.0;
+        kz[1] = g[1] / 3.0;
+        kz[2] = g[2] / 3.0;
+    }
+
+    for (x = 0; x < 3; x++) {
+        double o = (double)fe->offset[x];
+        ca -= ka[x] * o;
+        cb -= kb[x] * o;
+        cz -= kz[x] * o;
+        fe->k_alpha[x] = (float32_t)ka[x];
+        fe->k_beta[x] = (float32_t)kb[x];
+        fe->k_zero[x] = (float32_t)kz[x];
+    }
+    fe->c_alpha = (float32_t)ca;
+    fe->c_beta = (float32_t)cb;
+    fe->c_zero = (float32_t)cz;
+}
+
+/** \copydoc adc_clarke_init */
+int16_t adc_clarke_init(AdcClarke_Obj_t* const fe, int16_t n_sensors, const float32_t* gain,
+                        const float32_t* offset, float32_t cal_tol)
+{
+    if (n_sensors != 2 && n_sensors != 3) {
+        return -1;
+    }
+
+    memset(fe, 0, sizeof(*fe));
+    fe->n_sensors = n_sensors;
+    fe->cal_tol = cal_tol;
+    memcpy(fe->gain, gain, (size_t)n_sensors * sizeof(float32_t));
+    memcpy(fe->offset, offset, (size_t)n_sensors * sizeof(float32_t));
+    memcpy(fe->offset_nom, offset, (size_t)n_sensors * sizeof(float32_t));
+    adc_clarke_fold(fe);
+    return 0;
+} //<- end of adc_clarke_init()
+
+/** \copydoc adc_clarke_set_cal */
+void adc_clarke_set_cal(AdcClarke_Obj_t* const fe, const float32_t* gain, const float32_t* offset)
+{
+    if (gain) {
+        memcpy(fe->gain, gain, (size_t)fe->n_sensors * sizeof(float32_t));
+    }
+    if (offset) {
+        memcpy(fe->offset, offset, (size_t)fe->n_sensors * sizeof(float32_t));
+    }
+    adc_clarke_fold(fe);
+} //<- end of adc_clarke_set_cal()
+
+/** \copydoc adc_clarke */
+void adc_clarke(const AdcClarke_Obj_t* const fe, const int16_t* counts, AB0_t* AB0)
+{
+    MC_INSTR_BEGIN(MC_INSTR_ADC_CLARKE);
+
+    const float32_t a = (float32_t)counts[0];
+    const float32_t b = (float32_t)counts[1];
+
+    if (fe->n_sensors == 2) {
+        AB0->alpha = fe->k_alpha[0] * a + fe->c_alpha;
+        AB0->beta = fe->k_beta[0] * a + fe->k_beta[1] * b + fe->c_beta;
+        AB0->zero_AB = 0;
+    }
+    else {
+        const float32_t c = (float32_t)counts[2];
+        AB0->alpha = fe->k_alpha[0] * a + fe->k_alpha[1] * b + fe->k_alpha[2] * c + fe->c_alpha;
+        AB0->beta = fe->k_beta[1] * b + fe->k_beta[2] * c + fe->c_beta;
+        AB0->zero_AB = fe->k_zero[0] * a + fe->k_zero[1] * b + fe->k_zero[2] * c + fe->c_zero;
+    }
+
+    MC_INSTR_END(MC_INSTR_ADC_CLARKE);
+} //<- end of adc_clarke()
+
+/** \copydoc adc_clarke_batch */
+void adc_clarke_batch(const AdcClarke_Obj_t* const fe, const int16_t* counts, uint32_t n_frames,
+                      float32_t* alpha, float32_t* beta)
+{
+    // coefficients in locals and a size_t index, so that the compiler can
+    // vectorize the loops (no reload through the output pointers, no index wrap)
+    const float32_t ka0 = fe->k_alpha[0], ka1 = fe->k_alpha[1], ka2 = fe->k_alpha[2];
+    const float32_t kb0 = fe->k_beta[0], kb1 = fe->k_beta[1], kb2 = fe->k_beta[2];
+    const float32_t ca = fe->c_alpha, cb = fe->c_beta;
+    size_t f;
+
+    MC_INSTR_BEGIN(MC_INSTR_ADC_CLARKE_BATCH);
+
+    if (fe->n_sensors == 2) {
+        for (f = 0; f < n_frames; f++) {
+            const float32_t a = (float32_t)counts[2 * f];
+            const float32_t b = (float32_t)counts[2 * f + 1];
+            alpha[f] = ka0 * a + ca;
+            beta[f] = kb0 * a + kb1 * b + cb;
+        }
+    }
+    else {
+        for (f = 0; f < n_frames; f++) {
+            const float32_t a = (float32_t)counts[3 * f];
+            const float32_t b = (float32_t)counts[3 * f + 1];
+            const float32_t c = (float32_t)counts[3 * f + 2];
+            alpha[f] = ka0 * a + ka1 * b + ka2 * c + ca;
+            beta[f] = kb1 * b + kb2 * c + cb;
+        }
+    }
+
+    MC_INSTR_END(MC_INSTR_ADC_CLARKE_BATCH);
+} //<- end of adc_clarke_batch()
+
+/** \copydoc adc_clarke_cal_start */
+void adc_clarke_cal_start(AdcClarke_Obj_t* const fe, uint16_t n)
+{
+    memset(fe->cal_sum, 0, sizeof(fe->cal_sum));
+    fe->cal_n = 0;
+    fe->cal_target = n ? n : 1;
+    fe->cal_state = ADC_CAL_RUNNING;
+} //<- end of adc_clarke_cal_start()
+
+// means of the sums, checked against the nominal offsets, and refold
+static AdcCal_State_t adc_clarke_cal_finish(AdcClarke_Obj_t* const fe)
+{
+    float32_t mean[3];
+    int16_t x;
+
+    for (x = 0; x < fe->n_sensors; x++) {
+        mean[x] = (float32_t)((double)fe->cal_sum[x] / (double)fe->cal_n);
+        if (fabsf(mean[x] - fe->offset_nom[x]) > fe->cal_tol) {
+            fe->cal_state = ADC_CAL_FAILED;
+            return fe->cal_state;
+        }
+    }
+    adc_clarke_set_cal(fe, 0, mean);
+    fe->cal_state = ADC_CAL_DONE;
+    return fe->cal_state;
+}
+
+/** \copydoc adc_clarke_cal_sample */
+AdcCal_State_t adc_clarke_cal_sample(AdcClarke_Obj_t* const fe, const int16_t* counts)
+{
+    int16_t x;
+
+    if (fe->cal_state != ADC_CAL_RUNNING) {
+        return fe->cal_state;
+    }
+    for (x = 0; x < fe->n_sensors; x++) {
+        fe->cal_sum[x] += counts[x];
+    }
+    if (++fe->cal_n < fe->cal_target) {
+        return ADC_CAL_RUNNING;
+    }
+    return adc_clarke_cal_finish(fe);
+} //<- end of adc_clarke_cal_sample()
+
+/** \copydoc adc_clarke_cal_batch */
+AdcCal_State_t adc_clarke_cal_batch(AdcClarke_Obj_t* const fe, const int16_t* counts, uint32_t n_frames)
+{
+    const int16_t ns = fe->n_sensors;
+    uint32_t f, n;
+    int16_t x;
+
+    if (fe->cal_state != ADC_CAL_RUNNING) {
+        return fe->cal_state;
+    }
+    n = (uint32_t)(fe->cal_target - fe->cal_n);
+    if (n > n_frames) {
+        n = n_frames;
+    }
+    for (x = 0; x < ns; x++) {
+        int32_t s = 0;
+        for (f = 0; f < n; f++) {
+            s += counts[f * ns + x];
+        }
+        fe->cal_sum[x] += s;
+    }
+    fe->cal_n += (uint16_t)n;
+    if (fe->cal_n < fe->cal_target) {
+        return ADC_CAL_RUNNING;
+    }
+    return adc_clarke_cal_finish(fe);
+} //<- end of adc_clarke_cal_batch()
+
+// EOF adc_clarke.c
@@ -1,89 +1,31 @@
-// Automatically generated C++ file on Fri Jan 17 16:49:49 2025
-//
-// To build with Digital Mars C++ Compiler: 
-//
-//    dmc -mn -WD ipark.cpp kernel32.lib
+// Qspice block ipark: dq02AB0() on the rising edge of clk, see
+// qspice_block.hpp. Built by dll_projects/ipark.
 
-#include <malloc.h>
 #include "transforms.h"
+#include "qspice_block.hpp"
 
-union uData
+struct IPark
 {
-   bool b;
-   char c;
-   unsigned char uc;
-   short s;
-   unsigned short us;
-   int i;
-   unsigned int ui;
-   float f;
-   double d;
-   long long int i64;
-   unsigned long long int ui64;
-   char *str;
-   unsigned char *bytes;
-};
-
-// int DllMain() must exist and return 1 for a process to load the .DLL
-// See https://docs.microsoft.com/en-us/windows/win32/dlls/dllmain for more information.
-int __stdcall DllMain(void *module, unsigned int reason, void *reserved) { return 1; }
-
-void bzero(void *ptr, unsigned int count)
-{
-   unsigned char *first = (unsigned char *) ptr; 
-   unsigned char *last  = first + count; 
-   while(first < last)
-      *first++ = '\0'; 
-}
-
-// #undef pin names lest they collide with names in any header file(s) you might include.
-#undef d
-#undef q
-#undef clk
-#undef theta_e
-#undef A
-#undef B
+   enum { d, q, clk, theta_e, A, B };    // ports
+   static const int kClk = clk;
 
-struct sIPARK
-{
-  // declare the structure here
-   bool clk_n1;
    Transform_Obj_t T_inst;
-};
-
-extern "C" __declspec(dllexport) void ipark(struct sIPARK **opaque, double t, union uData *data)
-{
-   float   d       = data[0].f; // input
-   float   q       = data[1].f; // input
-   bool    clk     = data[2].b; // input
-   float   theta_e = data[3].f; // input
-   float  &A       = data[4].f; // output
-   float  &B       = data[5].f; // output
 
-   if(!*opaque)
+   void init(uData*)
    {
-      *opaque = (struct sIPARK *) malloc(sizeof(struct sIPARK));
-      bzero(*opaque, sizeof(struct sIPARK));
    }
-   struct sIPARK *inst = *opaque;
 
-// Implement module evaluation code here:
-   if(clk && !inst->clk_n1)
+   void step(uData* data)
    {
-      inst->T_inst.dq0.d = d;
-      inst->T_inst.dq0.q = q;
-      inst->T_inst.dq0.zero_dq = 0;
+      T_inst.dq0.d = data[d].f;
+      T_inst.dq0.q = data[q].f;
+      T_inst.dq0.zero_dq = 0;
 
-      dq02AB0(&inst->T_inst, theta_e);
+      dq02AB0(&T_inst, data[theta_e].f);
 
-      A = inst->T_inst.AB0.alpha;
-      B = inst->T_inst.AB0.beta;
+      data[A].f = T_inst.AB0.alpha;
+      data[B].f = T_inst.AB0.beta;
    }
+};
 
-   inst->clk_n1 = clk;
-}
-
-extern "C" __declspec(dllexport) void Destroy(struct sIPARK *inst)
-{
-   free(inst);
-}
+QSPICE_BLOCK(ipark, IPark)
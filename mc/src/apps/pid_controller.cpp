@@ -1,140 +1,50 @@
-// Automatically generated C++ file on Wed Jan  8 09:16:35 2025
-//
-// To build with Digital Mars C++ Compiler:
-//
-//    dmc -mn -WD pid_controller.cpp kernel32.lib
+// Qspice block pid_controller: PID_Update() on the rising edge of clk, see
+// qspice_block.hpp. Built by dll_projects/pid_controller.
 
-#include <malloc.h>
 #include "pid.h"
+#include "qspice_block.hpp"
 
-extern "C" __declspec(dllexport) int (*Display)(const char *format, ...) = 0; // works like printf()
-extern "C" __declspec(dllexport) const double *DegreesC                  = 0; // pointer to current circuit temperature
-//extern "C" __declspec(dllexport) const int *StepNumber                   = 0; // pointer to current step number
-//extern "C" __declspec(dllexport) const int *NumberSteps                  = 0; // pointer to estimated number of steps
-//extern "C" __declspec(dllexport) const char* const *InstanceName         = 0; // pointer to address of instance name
-//extern "C" __declspec(dllexport) const char *QUX                         = 0; // path to QUX.exe
-//extern "C" __declspec(dllexport) const bool *ForKeeps                    = 0; // pointer to whether being evaluated non-hypothetically
-//extern "C" __declspec(dllexport) const bool *HoldICs                     = 0; // pointer to whether instance initial conditions are being held
-//extern "C" __declspec(dllexport) int (*DFFT)(struct sComplex *u, bool inv, unsigned int N, double scale) = 0; // discrete Fast Fourier function
-
-union uData
-{
-   bool b;
-   char c;
-   unsigned char uc;
-   short s;
-   unsigned short us;
-   int i;
-   unsigned int ui;
-   float f;
-   double d;
-   long long int i64;
-   unsigned long long int ui64;
-   char *str;
-   unsigned char *bytes;
-};
-
-// int DllMain() must exist and return 1 for a process to load the .DLL
-// See https://docs.microsoft.com/en-us/windows/win32/dlls/dllmain for more information.
-int __stdcall DllMain(void *module, unsigned int reason, void *reserved) { return 1; }
-
-void bzero(void *ptr, unsigned int count)
+struct PidController
 {
-   unsigned char *first = (unsigned char *) ptr;
-   unsigned char *last  = first + count;
-   while(first < last)
-      *first++ = '\0';
-}
+   enum { ref, clk, fb, uff, OutHiLim, OutLoLim, IntRateLim, Kp, Ts, Ti, Ki_enable, Td, Kd_enable, Kp_aw,
+          u, _DBG };                 // ports
+   static const int kClk = clk;
+   static const int kTs = Ts;        // sample time, seeds the step control
 
-// #undef pin names lest they collide with names in any header file(s) you might include.
-#undef ref
-#undef clk
-#undef fb
-#undef uff
-#undef u
-#undef _DBG
+   PID_Obj_t PID_inst;
 
-struct sPID_CONTROLLER
-{
-  // declare the structure here
-  bool init_done;
-  bool   clk_n1;      // clk[n-1]
-  PID_Obj_t PID_inst;
-};
-
-extern "C" __declspec(dllexport) void pid_controller(struct sPID_CONTROLLER **opaque, double t, union uData *data)
-{
-   float   ref        = data[ 0].f; // input
-   bool    clk        = data[ 1].b; // input
-   float   fb         = data[ 2].f; // input
-   float   uff        = data[ 3].f; // input
-   float   OutHiLim   = data[ 4].f; // input parameter
-   float   OutLoLim   = data[ 5].f; // input parameter
-   float   IntRateLim = data[ 6].f; // input parameter
-   float   Kp         = data[ 7].f; // input parameter
-   float   Ts         = data[ 8].f; // input parameter
-   float   Ti         = data[ 9].f; // input parameter
-   bool    Ki_enable  = data[10].b; // input parameter
-   float   Td         = data[11].f; // input parameter
-   bool    Kd_enable  = data[12].b; // input parameter
-   float   Kp_aw      = data[13].f; // input parameter
-   float  &u          = data[14].f; // output
-   float  &_DBG       = data[15].f; // debug
-
-   if(!*opaque)
+   void init(uData* data)
    {
-      *opaque = (struct sPID_CONTROLLER *) malloc(sizeof(struct sPID_CONTROLLER));
-      bzero(*opaque, sizeof(struct sPID_CONTROLLER));
-   }
-   struct sPID_CONTROLLER *inst = *opaque;
-
-// Implement module evaluation code here:
-
-   if (!inst->init_done){
-      PID_Data_Init(&inst->PID_inst,
+      PID_Data_Init(&PID_inst,
          0, //err,
          0, //ui,
          0, //u,
          0, //uff
          0); //err_aw);
 
-      PID_Param_Init(&inst->PID_inst,
-         OutHiLim,
-         OutLoLim,
-         IntRateLim,
-         Kp,
-         Ts,
-         Ti,
-         Ki_enable,
-         Td,
-         Kd_enable,
-         Kp_aw);
+      PID_Param_Init(&PID_inst,
+         data[OutHiLim].f,
+         data[OutLoLim].f,
+         data[IntRateLim].f,
+         data[Kp].f,
+         data[Ts].f,
+         data[Ti].f,
+         data[Ki_enable].b,
+         data[Td].f,
+         data[Kd_enable].b,
+         data[Kp_aw].f);
 
       Display("pid_controller: Kp=%f, Ts=%f, Ti=%f, Ki=%f, Td=%f, Kd=%f\n",
-               Kp, Ts, Ti, inst->PID_inst.Ki, Td, inst->PID_inst.Kd);
-         
-      inst->init_done = true;
+               data[Kp].f, data[Ts].f, data[Ti].f, PID_inst.Ki, data[Td].f, PID_inst.Kd);
    }
 
-   if (clk && !inst->clk_n1)   // rising edge
+   void step(uData* data)
    {
-      PID_Update(&inst->PID_inst, ref, fb, uff);
-   }
-
-   u  = inst->PID_inst.u;
-
-   inst->clk_n1 = clk;
-
-   _DBG = inst->PID_inst.ui;
-}
-
-extern "C" __declspec(dllexport) double MaxExtStepSize(struct sPID_CONTROLLER *inst, double t)
-{
-   return 1e308; // implement a good choice of max timestep size that depends on struct sPID_CONTROLLER
-}
+      PID_Update(&PID_inst, data[ref].f, data[fb].f, data[uff].f);
 
+      data[u].f = PID_inst.u;
+      data[_DBG].f = PID_inst.ui;
+   }
+};
 
-extern "C" __declspec(dllexport) void Destroy(struct sPID_CONTROLLER *inst)
-{
-   free(inst);
-}
+QSPICE_BLOCK(pid_controller, PidController)
@@ -0,0 +1,284 @@
+/**
+ * @file       qspice_block.hpp
+ * @date       Oct 2026
+ *
+ * @brief      Common adapter of the Qspice C++ blocks in src/apps
+ *
+ *      Qspice calls a block's entry point once per simulator step with the
+ *      whole port array, inputs, parameters and outputs alike. The adapter does
+ *      the part every block shares:
+ *        - allocates the instance on the first call, zeroed and at the
+ *          alignment of its kernel objects (FOC_Obj_t and SMO_Obj_t start on a
+ *          cache line), and runs Block::init(),
+ *          which decodes the parameters once and latches them in the kernel
+ *          objects; they are not read again
+ *        - detects the rising edge of data[Block::kClk] and runs Block::step(),
+ *          which reads the inputs, runs the kernel and writes the outputs; a
+ *          step without an edge costs one load and one compare
+ *        - frees the instance in Destroy(), with the cycle report of the
+ *          kernels when built with MC_INSTRUMENT=1
+ *        - tells the simulator where the next clock edge is, see below
+ *
+ *      A block is a trivial struct with the port indices in the symbol's
+ *      order, kClk, init() and step(), and optionally kTs, the index of a float
+ *      sample-time parameter. QSPICE_BLOCK(name, Block) generates the exported
+ *      symbols of the DLL:
+ *
+ *          struct Lpf
+ *          {
+ *              enum { u, clk, a0, a1, b1, y };
+ *              static const int kClk = clk;
+ *              Lpf1st_Obj_t lpf;
+ *              void init(uData* data) { lpf_1st_init(&lpf, ...); }
+ *              void step(uData* data) { lpf_1st_update(&lpf, data[u].f); data[y].f = lpf.y; }
+ *          };
+ *          QSPICE_BLOCK(lpf_1st, Lpf)
+ *
+ *      Step control: each rising edge is placed midway between the call that
+ *      saw clk low and the one that saw it high; the period is the mean interval
+ *      since the clock was first locked (edges skipped by the simulator count
+ *      as whole periods, an interval off by more than 1% restarts the mean), or
+ *      the kTs parameter until two edges were seen. Until the period and one
+ *      edge are known, the simulator's own step limit must be short enough to
+ *      see the clock pulses; with kTs the block asks for Ts/4 steps until the
+ *      first edge. From then on MaxExtStepSize() returns the step that lands
+ *      QSPICE_TTOL before the predicted edge, then QSPICE_TTOL steps across it:
+ *      between edges the simulator is free to take one step, and the update
+ *      sees its inputs within QSPICE_TTOL of the edge. An edge that does not
+ *      come when predicted is waited for with steps as long as it is late, up
+ *      to a quarter period.
+ *
+ *      Trunc() (QSPICE_TRUNC=1, default) finds the edges while there is no
+ *      prediction yet, or a wrong one: a tentative step longer than QSPICE_TTOL
+ *      across a rising clk edge is halved, so the update runs within
+ *      QSPICE_TTOL of the edge from the first edge on. Without Trunc() the
+ *      first edges are only placed as well as the steps that crossed them;
+ *      the block still locks, with that phase error.
+ *
+ *      On Windows the exports are __declspec(dllexport), elsewhere the blocks
+ *      build as host modules (MC_BUILD_QSPICE_BLOCKS) with default visibility.
+ *      sim/qspice_host.cpp (qspice_host) drives the modules the way Qspice does.
+ */
+
+#ifndef QSPICE_BLOCK_HPP_
+    #define QSPICE_BLOCK_HPP_
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+#if defined(_WIN32)
+    #include <malloc.h>
+#endif
+
+#include "instrument.h"
+
+#if defined(_WIN32)
+    #define QSPICE_API              __declspec(dllexport)
+    // int DllMain() must exist and return 1 for a process to load the .DLL
+    // See https://docs.microsoft.com/en-us/windows/win32/dlls/dllmain for more information.
+    #define QSPICE_DLLMAIN          int __stdcall DllMain(void* module, unsigned int reason, void* reserved) { return 1; }
+#else
+    #define QSPICE_API              __attribute__((visibility("default")))
+    #define QSPICE_DLLMAIN
+#endif
+#define QSPICE_EXPORT               extern "C" QSPICE_API
+
+#ifndef QSPICE_TTOL
+    #define QSPICE_TTOL             1e-9    // s, how close to a clock edge the update runs
+#endif
+#ifndef QSPICE_TRUNC
+    #define QSPICE_TRUNC            1       // export Trunc()
+#endif
+
+// one port value, as Qspice passes it
+union uData
+{
+    bool b;
+    char c;
+    unsigned char uc;
+    short s;
+    unsigned short us;
+    int i;
+    unsigned int ui;
+    float f;
+    double d;
+    long long int i64;
+    unsigned long long int ui64;
+    char* str;
+    unsigned char* bytes;
+};
+
+QSPICE_EXPORT int (*Display)(const char* format, ...);     // works like printf(), set by Qspice
+
+namespace qspice {
+
+// Block::kTs, or -1 without a sample-time parameter
+template <class Block, class = void>
+struct ts_port : std::integral_constant<int, -1>
+{
+};
+
+template <class Block>
+struct ts_port<Block, std::void_t<decltype(Block::kTs)>> : std::integral_constant<int, Block::kTs>
+{
+};
+
+template <class Block>
+struct Instance
+{
+    Block       block;
+    bool        clk_n1;     // clk[n-1]
+    double      t_n1;       // t[n-1]
+    uint32_t    edges;      // rising edges seen
+    double      t_edge;     // time of the last one
+    double      t_lock;     // first edge of the mean period
+    double      n_lock;     // periods since t_lock
+    double      period;     // sample period, 0 unknown
+};
+
+// zeroed storage at alignof(Instance<Block>), which malloc() does not promise
+// beyond alignof(std::max_align_t)
+template <class Block>
+inline Instance<Block>* alloc_instance()
+{
+    constexpr size_t size = sizeof(Instance<Block>);    // a multiple of the alignment
+#if defined(_WIN32)
+    void* p = _aligned_malloc(size, alignof(Instance<Block>));
+#else
+    void* p = std::aligned_alloc(alignof(Instance<Block>), size);
+#endif
+    if (p != nullptr) {
+        std::memset(p, 0, size);
+    }
+    return static_cast<Instance<Block>*>(p);
+}
+
+// a rising edge at te: updates the phase and the mean period
+template <class Block>
+inline void lock(Instance<Block>* inst, double te)
+{
+    if (inst->edges > 0) {
+        const double dt = te - inst->t_edge;
+        const double k = inst->period > 0 ? std::floor(dt / inst->period + 0.5) : 0;
+        if (inst->n_lock > 0 && k >= 1 && std::fabs(dt - k * inst->period) <= 0.01 * inst->period) {
+            inst->n_lock += k;
+        }
+        else {
+            inst->t_lock = inst->t_edge;
+            inst->n_lock = 1;
+        }
+        inst->period = (te - inst->t_lock) / inst->n_lock;
+    }
+    inst->t_edge = te;
+    inst->edges++;
+}
+
+template <class Block>
+inline void evaluate(Instance<Block>** opaque, double t, uData* data)
+{
+    static_assert(std::is_trivial<Block>::value, "Qspice blocks are allocated zeroed, without a constructor");
+
+    Instance<Block>* inst = *opaque;
+    if (inst == nullptr) {
+        inst = alloc_instance<Block>();
+        if (inst == nullptr) {
+            return;
+        }
+        *opaque = inst;
+        inst->block.init(data);
+        if (ts_port<Block>::value >= 0 && data[ts_port<Block>::value].f > 0) {
+            inst->period = data[ts_port<Block>::value].f;
+        }
+    }
+
+    const bool clk = data[Block::kClk].b;
+    if (clk && !inst->clk_n1) {     // rising edge
+        inst->block.step(data);
+        lock(inst, t - 0.5 * (t - inst->t_n1));
+    }
+    inst->clk_n1 = clk;
+    inst->t_n1 = t;
+}
+
+template <class Block>
+inline double max_step(const Instance<Block>* inst, double t)
+{
+    if (inst == nullptr || inst->period <= 0) {
+        return 1e308;
+    }
+    if (inst->edges == 0) {
+        return 0.25 * inst->period;     // Ts known, phase not yet: sample the clock
+    }
+
+    const double t_next = inst->t_edge + inst->period;
+    if (t_next - t > 1.5 * QSPICE_TTOL) {
+        return t_next - QSPICE_TTOL - t;    // land just before the predicted edge
+    }
+    const double late = t - t_next;
+    if (late < QSPICE_TTOL) {
+        return QSPICE_TTOL;
+    }
+    return late < 0.25 * inst->period ? late : 0.25 * inst->period;
+}
+
+template <class Block>
+inline void trunc(const Instance<Block>* inst, const uData* data, double* timestep)
+{
+    if (inst != nullptr && *timestep > QSPICE_TTOL && data[Block::kClk].b && !inst->clk_n1) {
+        *timestep = 0.5 * *timestep > QSPICE_TTOL ? 0.5 * *timestep : QSPICE_TTOL;
+    }
+}
+
+template <class Block>
+inline void destroy(Instance<Block>* inst)
+{
+#if MC_INSTRUMENT
+    if (Display != nullptr) {
+        mc_instr_report(Display);   // cycle statistics of the kernels, see instrument.h
+    }
+#endif
+#if defined(_WIN32)
+    _aligned_free(inst);
+#else
+    std::free(inst);
+#endif
+}
+
+} // namespace qspice
+
+#if QSPICE_TRUNC
+    #define QSPICE_TRUNC_EXPORT(Block)                                                  \
+        QSPICE_EXPORT void Trunc(qspice::Instance<Block>* inst, double, uData* data,    \
+                                 double* timestep)                                      \
+        {                                                                               \
+            qspice::trunc<Block>(inst, data, timestep);                                 \
+        }
+#else
+    #define QSPICE_TRUNC_EXPORT(Block)
+#endif
+
+// the exported symbols of a block DLL: Display, the entry point, MaxExtStepSize,
+// Trunc and Destroy
+#define QSPICE_BLOCK(name, Block)                                                       \
+    extern "C" {                                                                        \
+    QSPICE_API int (*Display)(const char* format, ...) = 0;                             \
+    QSPICE_API const double* DegreesC = 0;      /* current circuit temperature */       \
+    }                                                                                   \
+    QSPICE_EXPORT void name(qspice::Instance<Block>** opaque, double t, uData* data)    \
+    {                                                                                   \
+        qspice::evaluate<Block>(opaque, t, data);                                       \
+    }                                                                                   \
+    QSPICE_EXPORT double MaxExtStepSize(qspice::Instance<Block>* inst, double t)        \
+    {                                                                                   \
+        return qspice::max_step<Block>(inst, t);                                        \
+    }                                                                                   \
+    QSPICE_TRUNC_EXPORT(Block)                                                          \
+    QSPICE_EXPORT void Destroy(qspice::Instance<Block>* inst)                           \
+    {                                                                                   \
+        qspice::destroy<Block>(inst);                                                   \
+    }                                                                                   \
+    QSPICE_DLLMAIN
+
+#endif // <-- !defined QSPICE_BLOCK_HPP_
@@ -0,0 +1,38 @@
+// Qspice block smobldc: smo_update() on the rising edge of clk, see
+// qspice_block.hpp. Built by dll_projects/smobldc.
+
+#include "smo.h"
+#include "qspice_block.hpp"
+
+struct SmoBldc
+{
+   enum { Valpha, Vbeta, Ialpha, Ibeta, clk, Rs, Ls, Ts, Kslide, Phi, Wc, Kp, Ki, Wmax,
+          theta, omega, Ealpha, Ebeta, _DBG };  // ports
+   static const int kClk = clk;
+   static const int kTs = Ts;        // sample time, seeds the step control
+
+   SMO_Obj_t SMO_inst;
+
+   void init(uData* data)
+   {
+      smo_init(&SMO_inst, data[Rs].f, data[Ls].f, data[Ts].f, data[Kslide].f, data[Phi].f, data[Wc].f,
+               data[Kp].f, data[Ki].f, data[Wmax].f);
+
+      Display("smobldc: Rs=%f, Ls=%f, Ts=%f, Kslide=%f, Phi=%f, Wc=%f, Kp=%f, Ki=%f, Wmax=%f\n",
+               data[Rs].f, data[Ls].f, data[Ts].f, data[Kslide].f, data[Phi].f, data[Wc].f,
+               data[Kp].f, data[Ki].f, data[Wmax].f);
+   }
+
+   void step(uData* data)
+   {
+      smo_update(&SMO_inst, data[Valpha].f, data[Vbeta].f, data[Ialpha].f, data[Ibeta].f);
+
+      data[theta].f = SMO_inst.theta;
+      data[omega].f = SMO_inst.omega;
+      data[Ealpha].f = SMO_inst.e[0];
+      data[Ebeta].f = SMO_inst.e[1];
+      data[_DBG].f = SMO_inst.i_est[0];
+   }
+};
+
+QSPICE_BLOCK(smobldc, SmoBldc)
@@ -0,0 +1,180 @@
+/**
+ * @file        decim.c
+ * @date        Oct 2026
+ *
+ * @brief       CIC decimator of oversampled ADC channels
+ *
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "decim.h"
+#include "instrument.h"
+
+/** \copydoc decim_cic_init */
+int16_t decim_cic_init(Decim_Cic_Obj_t* const cic, uint16_t n_ch, uint16_t R, uint16_t order, int16_t comp)
+{
+    double gain = 1.0, q;
+    uint16_t bits = 0, ch;
+
+    if (n_ch == 0 || n_ch > DECIM_MAX_CHANNELS || R == 0 || order == 0 || order > DECIM_MAX_ORDER) {
+        return -1;
+    }
+    while ((1u << bits) < R) {
+        bits++;
+    }
+    if (16 + order * bits > 32) {
+        return -1;
+    }
+
+    memset(cic, 0, sizeof(*cic));
+    cic->n_ch = n_ch;
+    cic->R = R;
+    cic->order = order;
+    cic->comp = comp;
+
+    for (ch = 0; ch < order; ch++) {
+        gain *= (double)R;
+    }
+    for (ch = 0; ch < n_ch; ch++) {
+        cic->k[ch] = (float32_t)(1.0 / gain);
+    }
+
+    // |(1 + a) - a z^-1|^2 = 1 + 4 a (1 + a) sin^2(pi f) against the droop
+    // 1 - N (1 - 1/R^2) (pi f)^2 / 6 of the CIC
+    q = (double)order * (1.0 - 1.0 / ((double)R * (double)R)) / 12.0;
+    cic->comp_a = (float32_t)((sqrt(1.0 + 4.0 * q) - 1.0) / 2.0);
+
+    return 0;
+} //<- end of decim_cic_init()
+
+/** \copydoc decim_cic_set_scale */
+void decim_cic_set_scale(Decim_Cic_Obj_t* const cic, uint16_t ch, float32_t scale, float32_t offset)
+{
+    double gain = 1.0;
+    uint16_t s;
+
+    if (ch >= cic->n_ch) {
+        return;
+    }
+    for (s = 0; s < cic->order; s++) {
+        gain *= (double)cic->R;
+    }
+    cic->k[ch] = (float32_t)((double)scale / gain);
+    cic->c[ch] = scale * offset;
+} //<- end of decim_cic_set_scale()
+
+/** \copydoc decim_cic_reset */
+void decim_cic_reset(Decim_Cic_Obj_t* const cic)
+{
+    memset(cic->integ, 0, sizeof(cic->integ));
+    memset(cic->comb, 0, sizeof(cic->comb));
+    memset(cic->c_k1, 0, sizeof(cic->c_k1));
+    cic->phase = 0;
+} //<- end of decim_cic_reset()
+
+// integrators of channel ch over n frames, only additions
+static void decim_cic_integrate(Decim_Cic_Obj_t* const cic, uint16_t ch, const uint16_t* x, uint32_t n)
+{
+    const uint16_t stride = cic->n_ch;
+    uint32_t i0 = cic->integ[0][ch];
+    uint32_t i1 = cic->integ[1][ch];
+    uint32_t i2 = cic->integ[2][ch];
+    uint32_t i3 = cic->integ[3][ch];
+    uint32_t f;
+
+    switch (cic->order) {
+    case 1:
+        for (f = 0; f < n; f++) {
+            i0 += x[f * stride];
+        }
+        break;
+    case 2:
+        for (f = 0; f < n; f++) {
+            i0 += x[f * stride];
+            i1 += i0;
+        }
+        break;
+    case 3:
+        for (f = 0; f < n; f++) {
+            i0 += x[f * stride];
+            i1 += i0;
+            i2 += i1;
+        }
+        break;
+    default:
+        for (f = 0; f < n; f++) {
+            i0 += x[f * stride];
+            i1 += i0;
+            i2 += i1;
+            i3 += i2;
+        }
+        break;
+    }
+
+    cic->integ[0][ch] = i0;
+    cic->integ[1][ch] = i1;
+    cic->integ[2][ch] = i2;
+    cic->integ[3][ch] = i3;
+}
+
+// combs, scaling and compensator of channel ch at the end of a period
+static float32_t decim_cic_output(Decim_Cic_Obj_t* const cic, uint16_t ch)
+{
+    uint32_t v = cic->integ[cic->order - 1][ch];
+    float32_t y;
+    uint16_t s;
+
+    for (s = 0; s < cic->order; s++) {
+        uint32_t d = v - cic->comb[s][ch];
+        cic->comb[s][ch] = v;
+        v = d;
+    }
+
+    // 16 + N log2(R) <= 32 bits: the comb output is the unsigned sum itself
+    y = cic->k[ch] * (float32_t)v - cic->c[ch];
+    if (cic->comp) {
+        float32_t yc = (1.0f + cic->comp_a) * y - cic->comp_a * cic->c_k1[ch];
+        cic->c_k1[ch] = y;
+        y = yc;
+    }
+    return y;
+}
+
+/** \copydoc decim_cic_process */
+uint32_t decim_cic_process(Decim_Cic_Obj_t* const cic, const uint16_t* buf, uint32_t n_frames, float32_t* out)
+{
+    const uint16_t n_ch = cic->n_ch;
+    uint32_t f = 0, n_out = 0;
+    uint16_t ch;
+
+    MC_INSTR_BEGIN(MC_INSTR_DECIM_CIC_PROCESS);
+
+    while (f < n_frames) {
+        // up to the end of the current period
+        uint32_t n = cic->R - cic->phase;
+        if (n > n_frames - f) {
+            n = n_frames - f;
+        }
+
+        for (ch = 0; ch < n_ch; ch++) {
+            decim_cic_integrate(cic, ch, buf + (size_t)f * n_ch + ch, n);
+        }
+        f += n;
+        cic->phase += (uint16_t)n;
+
+        if (cic->phase == cic->R) {
+            cic->phase = 0;
+            for (ch = 0; ch < n_ch; ch++) {
+                out[(size_t)n_out * n_ch + ch] = decim_cic_output(cic, ch);
+            }
+            n_out++;
+        }
+    }
+
+    MC_INSTR_END(MC_INSTR_DECIM_CIC_PROCESS);
+    return n_out;
+} //<- end of decim_cic_process()
+
+// EOF decim.c
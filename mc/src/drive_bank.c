@@ -0,0 +1,419 @@
+/**
+ * @file        drive_bank.c
+ * @date        Oct 2026
+ *
+ * @brief       multi-motor drive bank, structure-of-arrays current loops
+ *
+ *      AVX-512 (16 lanes) and AVX2 (8 lanes) kernels for the transforms and the PI
+ *      controllers, picked once at run time from the CPU features; the scalar path
+ *      covers other targets and the tail lanes. The modulation is modulator_batch().
+ */
+
+#include <string.h>
+
+#include "ctrl_common.h"
+#include "drive_bank.h"
+#include "instrument.h"
+#include "trig.h"
+#include "trig_poly.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #define DRIVE_BANK_X86          1
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define DB_TARGET(isa)          __attribute__((target(isa)))
+#else
+    #define DB_TARGET(isa)
+#endif
+
+typedef uint32_t (*DriveBank_fn_t)(DriveBank_Obj_t* const bank, uint32_t first, uint32_t count);
+
+#if defined(DRIVE_BANK_X86)
+
+// bit k of the limit masks to sat[k], 8 lanes at a time: each mask byte copied to
+// all 8 bytes, byte k keeps bit k, +0x7F carries it to bit 7 (x86 is little-endian)
+MC_INLINE void drive_bank_sat(uint8_t* sat, uint32_t lim_d, uint32_t lim_q, uint32_t lanes)
+{
+    const uint64_t rep = 0x0101010101010101ull;
+    const uint64_t sel = 0x8040201008040201ull;
+    const uint64_t carry = 0x7F7F7F7F7F7F7F7Full;
+    uint32_t k;
+
+    for (k = 0; k < lanes; k += 8) {
+        uint64_t d = ((((uint64_t)((lim_d >> k) & 0xFFu) * rep) & sel) + carry) >> 7 & rep;
+        uint64_t q = ((((uint64_t)((lim_q >> k) & 0xFFu) * rep) & sel) + carry) >> 7 & rep;
+        uint64_t b = d * DRIVE_BANK_SAT_D | q * DRIVE_BANK_SAT_Q;
+        memcpy(sat + k, &b, sizeof(b));
+    }
+}
+
+//*****************************************************************************
+//
+// AVX2, 8 lanes
+//
+//*****************************************************************************
+#define DRIVE_BANK_FN               drive_bank_avx2
+#define DRIVE_BANK_PI               drive_bank_pi_avx2
+#define DRIVE_BANK_TARGET           DB_TARGET("avx2")
+#define DB_W                        8
+#define V_F                         __m256
+#define V_I                         __m256i
+#define V_SET1(x)                   _mm256_set1_ps(x)
+#define V_SET1I(x)                  _mm256_set1_epi32(x)
+#define V_LOADU(p)                  _mm256_loadu_ps(p)
+#define V_STOREU(p, v)              _mm256_storeu_ps(p, v)
+#define V_ADD(a, b)                 _mm256_add_ps(a, b)
+#define V_SUB(a, b)                 _mm256_sub_ps(a, b)
+#define V_MUL(a, b)                 _mm256_mul_ps(a, b)
+#define V_MIN(a, b)                 _mm256_min_ps(a, b)
+#define V_MAX(a, b)                 _mm256_max_ps(a, b)
+#define V_XOR(a, b)                 _mm256_xor_ps(a, b)
+#define V_CASTF(x)                  _mm256_castsi256_ps(x)
+#define V_CASTI(x)                  _mm256_castps_si256(x)
+#define V_CVTT(x)                   _mm256_cvttps_epi32(x)
+#define V_ADDI(a, b)                _mm256_add_epi32(a, b)
+#define V_ANDI(a, b)                _mm256_and_si256(a, b)
+#define V_XORI(a, b)                _mm256_xor_si256(a, b)
+#define V_SLLI(a, n)                _mm256_slli_epi32(a, n)
+// blendv looks at the sign bit only: bit 0 of k moved there
+#define V_SEL_ODD(k, a, b)          _mm256_blendv_ps(a, b, _mm256_castsi256_ps(_mm256_slli_epi32(k, 31)))
+#define V_NEQ_BITS(a, b)            ((uint32_t)_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_NEQ_UQ)))
+
+#include "drive_bank_simd.h"
+
+#undef DRIVE_BANK_FN
+#undef DRIVE_BANK_PI
+#undef DRIVE_BANK_TARGET
+#undef DB_W
+#undef V_F
+#undef V_I
+#undef V_SET1
+#undef V_SET1I
+#undef V_LOADU
+#undef V_STOREU
+#undef V_ADD
+#undef V_SUB
+#undef V_MUL
+#undef V_MIN
+#undef V_MAX
+#undef V_XOR
+#undef V_CASTF
+#undef V_CASTI
+#undef V_CVTT
+#undef V_ADDI
+#undef V_ANDI
+#undef V_XORI
+#undef V_SLLI
+#undef V_SEL_ODD
+#undef V_NEQ_BITS
+
+//*****************************************************************************
+//
+// AVX-512F, 16 lanes; the selects and the limit flags use mask registers
+//
+//*****************************************************************************
+#define DRIVE_BANK_FN               drive_bank_avx512
+#define DRIVE_BANK_PI               drive_bank_pi_avx512
+#define DRIVE_BANK_TARGET           DB_TARGET("avx512f")
+#define DB_W                        16
+#define V_F                         __m512
+#define V_I                         __m512i
+#define V_SET1(x)                   _mm512_set1_ps(x)
+#define V_SET1I(x)                  _mm512_set1_epi32(x)
+#define V_LOADU(p)                  _mm512_loadu_ps(p)
+#define V_STOREU(p, v)              _mm512_storeu_ps(p, v)
+#define V_ADD(a, b)                 _mm512_add_ps(a, b)
+#define V_SUB(a, b)                 _mm512_sub_ps(a, b)
+#define V_MUL(a, b)                 _mm512_mul_ps(a, b)
+#define V_MIN(a, b)                 _mm512_min_ps(a, b)
+#define V_MAX(a, b)                 _mm512_max_ps(a, b)
+// float logic is AVX512DQ, the integer one is in AVX512F
+#define V_XOR(a, b)                 _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a), _mm512_castps_si512(b)))
+#define V_CASTF(x)                  _mm512_castsi512_ps(x)
+#define V_CASTI(x)                  _mm512_castps_si512(x)
+#define V_CVTT(x)                   _mm512_cvttps_epi32(x)
+#define V_ADDI(a, b)                _mm512_add_epi32(a, b)
+#define V_ANDI(a, b)                _mm512_and_si512(a, b)
+#define V_XORI(a, b)                _mm512_xor_si512(a, b)
+#define V_SLLI(a, n)                _mm512_slli_epi32(a, n)
+#define V_SEL_ODD(k, a, b)          _mm512_mask_blend_ps(_mm512_test_epi32_mask(k, _mm512_set1_epi32(1)), a, b)
+#define V_NEQ_BITS(a, b)            ((uint32_t)_mm512_cmp_ps_mask(a, b, _CMP_NEQ_UQ))
+
+#include "drive_bank_simd.h"
+
+#endif // DRIVE_BANK_X86
+
+//*****************************************************************************
+//
+// scalar lanes
+//
+//*****************************************************************************
+
+// PID_Update_Inline() on lane i of a bank controller
+MC_INLINE float32_t drive_bank_pi(DriveBank_PI_t* pi, uint32_t i, float32_t ref, float32_t fb, float32_t uff,
+                                  uint32_t* limited)
+{
+    float32_t err = ref - fb;
+    float32_t err_k1 = pi->err[i];
+    float32_t ui = pi->ui[i];
+    float32_t u, u_sat;
+
+    float32_t up = pi->Kp[i] * err;
+    float32_t delta_ui = (pi->Ki[i] * (err + err_k1) / 2) + (pi->Kp_aw[i] * pi->err_aw[i]);
+    SATURATE(delta_ui, pi->IntRateLim[i], -pi->IntRateLim[i]);
+
+    ui += delta_ui;
+    SATURATE(ui, pi->OutHiLim[i], pi->OutLoLim[i]);
+    pi->ui[i] = ui;
+
+    float32_t ud = pi->Kd[i] * (err - err_k1);
+    u = up + ui + ud + uff;
+
+    u_sat = u;
+    SATURATE(u_sat, pi->OutHiLim[i], pi->OutLoLim[i]);
+    pi->u[i] = u_sat;
+    pi->err_aw[i] = u_sat - u;
+    pi->err[i] = err;
+
+    *limited = u_sat != u;
+    return u_sat;
+}
+
+// Clarke -> Park -> PI -> inverse Park of lanes first .. first+count-1, as foc_current_step()
+static void drive_bank_lanes(DriveBank_Obj_t* const bank, uint32_t first, uint32_t count)
+{
+    uint32_t i;
+
+    for (i = first; i < first + count; i++) {
+        float32_t alpha, beta;
+        uint32_t lim_d, lim_q;
+        SinCos_t sc;
+
+        if (bank->numSensors == 3) {
+            alpha = TWO_THIRD * bank->ia[i] - ONE_THIRD * (bank->ib[i] + bank->ic[i]);
+            beta = SQRT3REC * (bank->ib[i] - bank->ic[i]);
+        }
+        else {
+            alpha = bank->ia[i];
+            beta = SQRT3REC * (bank->ia[i] + 2 * bank->ib[i]);
+        }
+
+        trig_sincos_poly(bank->theta_e[i], &sc);
+
+        float32_t id = alpha * sc.cos + beta * sc.sin;
+        float32_t iq = - alpha * sc.sin + beta * sc.cos;
+
+        float32_t vd = drive_bank_pi(&bank->pi_d, i, bank->id_ref[i], id, bank->vd_ff[i], &lim_d);
+        float32_t vq = drive_bank_pi(&bank->pi_q, i, bank->iq_ref[i], iq, bank->vq_ff[i], &lim_q);
+
+        bank->Ualpha[i] = vd * sc.cos - vq * sc.sin;
+        bank->Ubeta[i] = vd * sc.sin + vq * sc.cos;
+        bank->id[i] = id;
+        bank->iq[i] = iq;
+        bank->sat[i] = (uint8_t)(lim_d * DRIVE_BANK_SAT_D | lim_q * DRIVE_BANK_SAT_Q);
+    }
+}
+
+//*****************************************************************************
+//
+// dispatch
+//
+//*****************************************************************************
+static DriveBank_fn_t drive_bank_fn = 0;    // NULL: scalar only
+static const char* drive_bank_name = 0;
+
+static void drive_bank_cpu(int* has_avx2, int* has_avx512)
+{
+    *has_avx2 = 0;
+    *has_avx512 = 0;
+#if defined(DRIVE_BANK_X86)
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    *has_avx2 = __builtin_cpu_supports("avx2");
+    *has_avx512 = __builtin_cpu_supports("avx512f");
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    int has_osxsave = (info[2] >> 27) & 1;
+    __cpuidex(info, 7, 0);
+    *has_avx2 = has_osxsave && ((info[1] >> 5) & 1) && ((_xgetbv(0) & 6) == 6);
+    *has_avx512 = *has_avx2 && ((info[1] >> 16) & 1) && ((_xgetbv(0) & 0xE6) == 0xE6);
+#endif
+#endif
+}
+
+static void drive_bank_select(void)
+{
+    int has_avx2, has_avx512;
+
+    drive_bank_cpu(&has_avx2, &has_avx512);
+    drive_bank_fn = 0;
+    drive_bank_name = "scalar";
+#if defined(DRIVE_BANK_X86)
+    if (has_avx512) {
+        drive_bank_fn = drive_bank_avx512;
+        drive_bank_name = "avx512";
+    }
+    else if (has_avx2) {
+        drive_bank_fn = drive_bank_avx2;
+        drive_bank_name = "avx2";
+    }
+#endif
+}
+
+/** \copydoc drive_bank_init */
+int16_t drive_bank_init(DriveBank_Obj_t* const bank, uint16_t n, int16_t numSensors, SVM_mode_t mode)
+{
+    if (n == 0 || n > DRIVE_BANK_MAX || (numSensors != 2 && numSensors != 3)) {
+        return -1;
+    }
+
+    if (drive_bank_name == 0) {
+        drive_bank_select();
+    }
+    modulator_batch_init();
+
+    memset(bank, 0, sizeof(*bank));
+    bank->n = n;
+    bank->numSensors = numSensors;
+    bank->mode = mode;
+
+    return 0;
+} //<- end of drive_bank_init()
+
+/** \copydoc drive_bank_set_pi */
+void drive_bank_set_pi(DriveBank_Obj_t* const bank, uint16_t lane, const PID_Obj_t* pid_d, const PID_Obj_t* pid_q)
+{
+    DriveBank_PI_t* pi[2] = {&bank->pi_d, &bank->pi_q};
+    const PID_Obj_t* pid[2] = {pid_d, pid_q};
+    int16_t k;
+
+    for (k = 0; k < 2; k++) {
+        pi[k]->err[lane] = pid[k]->err;
+        pi[k]->ui[lane] = pid[k]->ui;
+        pi[k]->u[lane] = pid[k]->u;
+        pi[k]->err_aw[lane] = pid[k]->err_aw;
+        pi[k]->OutHiLim[lane] = pid[k]->OutHiLim;
+        pi[k]->OutLoLim[lane] = pid[k]->OutLoLim;
+        pi[k]->IntRateLim[lane] = pid[k]->IntRateLim;
+        pi[k]->Kp[lane] = pid[k]->Kp;
+        pi[k]->Ki[lane] = pid[k]->Ki;
+        pi[k]->Kd[lane] = pid[k]->Kd;
+        pi[k]->Kp_aw[lane] = pid[k]->Kp_aw;
+    }
+} //<- end of drive_bank_set_pi()
+
+/** \copydoc drive_bank_get_pi */
+void drive_bank_get_pi(const DriveBank_Obj_t* bank, uint16_t lane, PID_Obj_t* pid_d, PID_Obj_t* pid_q)
+{
+    const DriveBank_PI_t* pi[2] = {&bank->pi_d, &bank->pi_q};
+    PID_Obj_t* pid[2] = {pid_d, pid_q};
+    int16_t k;
+
+    for (k = 0; k < 2; k++) {
+        pid[k]->err = pi[k]->err[lane];
+        pid[k]->ui = pi[k]->ui[lane];
+        pid[k]->u = pi[k]->u[lane];
+        pid[k]->err_aw = pi[k]->err_aw[lane];
+        pid[k]->OutHiLim = pi[k]->OutHiLim[lane];
+        pid[k]->OutLoLim = pi[k]->OutLoLim[lane];
+        pid[k]->IntRateLim = pi[k]->IntRateLim[lane];
+        pid[k]->Kp = pi[k]->Kp[lane];
+        pid[k]->Ki = pi[k]->Ki[lane];
+        pid[k]->Kd = pi[k]->Kd[lane];
+        pid[k]->Kp_aw = pi[k]->Kp_aw[lane];
+    }
+} //<- end of drive_bank_get_pi()
+
+/** \copydoc drive_bank_step */
+void drive_bank_step(DriveBank_Obj_t* const bank)
+{
+    drive_bank_step_range(bank, 0, bank->n);
+} //<- end of drive_bank_step()
+
+/** \copydoc drive_bank_step_range */
+void drive_bank_step_range(DriveBank_Obj_t* const bank, uint16_t first, uint16_t count)
+{
+    uint32_t n, i = 0;
+
+    if (first >= bank->n) {
+        return;
+    }
+    n = (uint32_t)first + count > bank->n ? (uint32_t)(bank->n - first) : count;
+
+    MC_INSTR_BEGIN(MC_INSTR_DRIVE_BANK_STEP);
+
+    // the kernels were picked by drive_bank_init(), nothing is written here
+    if (drive_bank_fn != 0) {
+        i = drive_bank_fn(bank, first, n);
+    }
+    drive_bank_lanes(bank, first + i, n - i);
+
+    if (drive_bank_fn != 0) {
+        modulator_batch(bank->Ualpha + first, bank->Ubeta + first, n, bank->mode,
+                        bank->ma + first, bank->mb + first, bank->mc + first, bank->sector + first);
+    }
+    else {
+        modulator_batch_scalar(bank->Ualpha + first, bank->Ubeta + first, n, bank->mode,
+                               bank->ma + first, bank->mb + first, bank->mc + first, bank->sector + first);
+    }
+
+    MC_INSTR_END(MC_INSTR_DRIVE_BANK_STEP);
+} //<- end of drive_bank_step_range()
+
+/** \copydoc drive_bank_step_range_scalar */
+void drive_bank_step_range_scalar(DriveBank_Obj_t* const bank, uint16_t first, uint16_t count)
+{
+    uint32_t n;
+
+    if (first >= bank->n) {
+        return;
+    }
+    n = (uint32_t)first + count > bank->n ? (uint32_t)(bank->n - first) : count;
+
+    drive_bank_lanes(bank, first, n);
+    modulator_batch_scalar(bank->Ualpha + first, bank->Ubeta + first, n, bank->mode,
+                           bank->ma + first, bank->mb + first, bank->mc + first, bank->sector + first);
+} //<- end of drive_bank_step_range_scalar()
+
+/** \copydoc drive_bank_isa */
+const char* drive_bank_isa(void)
+{
+    if (drive_bank_name == 0) {
+        drive_bank_select();
+    }
+    return drive_bank_name;
+} //<- end of drive_bank_isa()
+
+/** \copydoc drive_bank_set_isa */
+int16_t drive_bank_set_isa(const char* isa)
+{
+    int has_avx2, has_avx512;
+
+    drive_bank_cpu(&has_avx2, &has_avx512);
+    if (strcmp(isa, "scalar") == 0) {
+        drive_bank_fn = 0;
+        drive_bank_name = "scalar";
+        return 0;
+    }
+#if defined(DRIVE_BANK_X86)
+    if (strcmp(isa, "avx2") == 0 && has_avx2) {
+        drive_bank_fn = drive_bank_avx2;
+        drive_bank_name = "avx2";
+        return 0;
+    }
+    if (strcmp(isa, "avx512") == 0 && has_avx512) {
+        drive_bank_fn = drive_bank_avx512;
+        drive_bank_name = "avx512";
+        return 0;
+    }
+#endif
+    return -1;
+} //<- end of drive_bank_set_isa()
+
+// EOF drive_bank.c
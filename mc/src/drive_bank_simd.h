@@ -0,0 +1,117 @@
+/**
+ * @file        drive_bank_simd.h
+ *
+ * @brief      vector body of drive_bank_step_range() (private to drive_bank.c)
+ *
+ *      Included once per instruction set by drive_bank.c after defining
+ *      DRIVE_BANK_FN, DRIVE_BANK_PI, DRIVE_BANK_TARGET, the lane count DB_W and
+ *      the V_* operation macros. Each lane repeats the arithmetic of
+ *      foc_current_step(), trig_sincos_poly() and PID_Update_Inline() operation
+ *      for operation (AVX-512F implies FMA, the library builds with
+ *      -ffp-contract=off so nothing is contracted), which keeps the lanes
+ *      bit-identical to the scalar path.
+ *
+ *      V_SEL_ODD(k, a, b) returns b in the lanes where k is odd, a elsewhere;
+ *      V_NEQ_BITS(a, b) the lanes where a != b (or either is NaN) as a bit mask.
+ */
+
+// PID_Update_Inline() across lanes i .. i+DB_W-1; limits with min/max, as SATURATE()
+DRIVE_BANK_TARGET
+MC_INLINE V_F DRIVE_BANK_PI(DriveBank_PI_t* pi, uint32_t i, V_F ref, V_F fb, V_F uff, uint32_t* limited)
+{
+    const V_F half = V_SET1(0.5f);
+    const V_F sign = V_SET1(-0.0f);
+    V_F hi = V_LOADU(pi->OutHiLim + i);
+    V_F lo = V_LOADU(pi->OutLoLim + i);
+    V_F rate = V_LOADU(pi->IntRateLim + i);
+    V_F err_k1 = V_LOADU(pi->err + i);
+
+    V_F err = V_SUB(ref, fb);
+    V_F up = V_MUL(V_LOADU(pi->Kp + i), err);
+
+    // Ki*(err+err_k1)/2, the halving is exact either way
+    V_F delta_ui = V_ADD(V_MUL(V_MUL(V_LOADU(pi->Ki + i), V_ADD(err, err_k1)), half),
+                         V_MUL(V_LOADU(pi->Kp_aw + i), V_LOADU(pi->err_aw + i)));
+    delta_ui = V_MAX(V_XOR(rate, sign), V_MIN(rate, delta_ui));
+
+    V_F ui = V_ADD(V_LOADU(pi->ui + i), delta_ui);
+    ui = V_MAX(lo, V_MIN(hi, ui));
+    V_STOREU(pi->ui + i, ui);
+
+    V_F ud = V_MUL(V_LOADU(pi->Kd + i), V_SUB(err, err_k1));
+    V_F u = V_ADD(V_ADD(V_ADD(up, ui), ud), uff);
+
+    V_F u_sat = V_MAX(lo, V_MIN(hi, u));
+    V_STOREU(pi->u + i, u_sat);
+    V_STOREU(pi->err_aw + i, V_SUB(u_sat, u));
+    V_STOREU(pi->err + i, err);
+
+    *limited = V_NEQ_BITS(u_sat, u);
+    return u_sat;
+}
+
+DRIVE_BANK_TARGET
+static uint32_t DRIVE_BANK_FN(DriveBank_Obj_t* const bank, uint32_t first, uint32_t count)
+{
+    const V_F sign = V_SET1(-0.0f);
+    const V_F two = V_SET1(2.0f);
+    const V_F magic = V_SET1(TRIG_ROUND_MAGIC);
+    const V_I one_i = V_SET1I(1);
+    const V_I two_i = V_SET1I(2);
+    const int three = bank->numSensors == 3;
+    uint32_t i, n;
+
+    for (n = 0; n + DB_W <= count; n += DB_W) {
+        V_F alpha, beta;
+        uint32_t lim_d, lim_q;
+
+        i = first + n;
+
+        // Clarke
+        V_F ia = V_LOADU(bank->ia + i);
+        V_F ib = V_LOADU(bank->ib + i);
+        if (three) {
+            V_F ic = V_LOADU(bank->ic + i);
+            alpha = V_SUB(V_MUL(V_SET1(TWO_THIRD), ia), V_MUL(V_SET1(ONE_THIRD), V_ADD(ib, ic)));
+            beta = V_MUL(V_SET1(SQRT3REC), V_SUB(ib, ic));
+        }
+        else {
+            alpha = ia;
+            beta = V_MUL(V_SET1(SQRT3REC), V_ADD(ia, V_MUL(two, ib)));
+        }
+
+        // trig_sincos_poly()
+        V_F theta = V_LOADU(bank->theta_e + i);
+        V_F kf = V_SUB(V_ADD(V_MUL(theta, V_SET1(TWO_BY_PI)), magic), magic);
+        V_I q = V_CVTT(kf);
+        V_F r = V_SUB(V_SUB(V_SUB(theta, V_MUL(kf, V_SET1(PIO2_HI))), V_MUL(kf, V_SET1(PIO2_MID))),
+                      V_MUL(kf, V_SET1(PIO2_LO)));
+        V_F z = V_MUL(r, r);
+        V_F s = V_ADD(r, V_MUL(V_MUL(r, z),
+                               V_ADD(V_SET1(TRIG_S1), V_MUL(z, V_ADD(V_SET1(TRIG_S2), V_MUL(z, V_SET1(TRIG_S3)))))));
+        V_F c = V_ADD(V_SUB(V_SET1(1.0f), V_MUL(V_SET1(0.5f), z)),
+                      V_MUL(V_MUL(z, z),
+                            V_ADD(V_SET1(TRIG_C2), V_MUL(z, V_ADD(V_SET1(TRIG_C3), V_MUL(z, V_SET1(TRIG_C4)))))));
+        V_F sin_t = V_SEL_ODD(q, s, c);
+        V_F cos_t = V_SEL_ODD(q, c, s);
+        sin_t = V_CASTF(V_XORI(V_CASTI(sin_t), V_SLLI(V_ANDI(q, two_i), 30)));
+        cos_t = V_CASTF(V_XORI(V_CASTI(cos_t), V_SLLI(V_ANDI(V_ADDI(q, one_i), two_i), 30)));
+
+        // Park
+        V_F id = V_ADD(V_MUL(alpha, cos_t), V_MUL(beta, sin_t));
+        V_F iq = V_ADD(V_MUL(V_XOR(alpha, sign), sin_t), V_MUL(beta, cos_t));
+
+        V_F vd = DRIVE_BANK_PI(&bank->pi_d, i, V_LOADU(bank->id_ref + i), id, V_LOADU(bank->vd_ff + i), &lim_d);
+        V_F vq = DRIVE_BANK_PI(&bank->pi_q, i, V_LOADU(bank->iq_ref + i), iq, V_LOADU(bank->vq_ff + i), &lim_q);
+
+        // inverse Park
+        V_STOREU(bank->Ualpha + i, V_SUB(V_MUL(vd, cos_t), V_MUL(vq, sin_t)));
+        V_STOREU(bank->Ubeta + i, V_ADD(V_MUL(vd, sin_t), V_MUL(vq, cos_t)));
+        V_STOREU(bank->id + i, id);
+        V_STOREU(bank->iq + i, iq);
+
+        drive_bank_sat(bank->sat + i, lim_d, lim_q, DB_W);
+    }
+
+    return n;
+}
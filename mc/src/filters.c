@@ -8,6 +8,7 @@
  */
 
 #include "filters.h"
+#include "instrument.h"
 
 
 /** \copydoc lpf_1st_init */
@@ -25,10 +26,14 @@ void lpf_1st_init(Lpf1st_Obj_t* const lpf_1st_inst, float32_t y, float32_t u,
 /** \copydoc lpf_1st_update */
 void lpf_1st_update(Lpf1st_Obj_t* const lpf_1st_inst, float32_t u)
 {
+	MC_INSTR_BEGIN(MC_INSTR_LPF_1ST_UPDATE);
+
 	float32_t u_k1 = lpf_1st_inst->u;
 	lpf_1st_inst->y = lpf_1st_inst->b1 * lpf_1st_inst->y;
 	lpf_1st_inst->y += lpf_1st_inst->a0 * u;
 	lpf_1st_inst->y += lpf_1st_inst->a1 * u_k1;
 
 	lpf_1st_inst->u = u;
+
+	MC_INSTR_END(MC_INSTR_LPF_1ST_UPDATE);
 }
\ No newline at end of file
@@ -0,0 +1,273 @@
+/**
+ * @file        filters_biquad.c
+ * @date        Oct 2026
+ *
+ * @brief       biquad cascade over structure-of-arrays channels
+ *
+ *      AVX2 (8 lanes) and SSE (4 lanes) updates, picked by biquad_init() from the
+ *      CPU features and the channel count; the scalar update covers other targets. The coefficient
+ *      design runs in double once at init.
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "filters.h"
+#include "ctrl_common.h"
+#include "instrument.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #define BIQUAD_X86              1
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define BIQUAD_TARGET(isa)      __attribute__((target(isa)))
+#else
+    #define BIQUAD_TARGET(isa)
+#endif
+
+// normalizes b0..b2, a1, a2 by a0
+static void biquad_store(Biquad_Coef_t* c, double b0, double b1, double b2, double a0, double a1, double a2)
+{
+    c->b0 = (float32_t)(b0 / a0);
+    c->b1 = (float32_t)(b1 / a0);
+    c->b2 = (float32_t)(b2 / a0);
+    c->a1 = (float32_t)(a1 / a0);
+    c->a2 = (float32_t)(a2 / a0);
+}
+
+/** \copydoc biquad_design_lpf */
+void biquad_design_lpf(Biquad_Coef_t* c, float32_t fc, float32_t Q, float32_t Ts)
+{
+    double w0 = 2.0 * 3.14159265358979323846 * (double)fc * (double)Ts;
+    double cw = cos(w0);
+    double alpha = sin(w0) / (2.0 * (double)Q);
+
+    biquad_store(c, (1.0 - cw) / 2.0, 1.0 - cw, (1.0 - cw) / 2.0, 1.0 + alpha, -2.0 * cw, 1.0 - alpha);
+} //<- end of biquad_design_lpf()
+
+/** \copydoc biquad_design_notch */
+void biquad_design_notch(Biquad_Coef_t* c, float32_t fc, float32_t Q, float32_t Ts)
+{
+    double w0 = 2.0 * 3.14159265358979323846 * (double)fc * (double)Ts;
+    double cw = cos(w0);
+    double alpha = sin(w0) / (2.0 * (double)Q);
+
+    biquad_store(c, 1.0, -2.0 * cw, 1.0, 1.0 + alpha, -2.0 * cw, 1.0 - alpha);
+} //<- end of biquad_design_notch()
+
+/** \copydoc biquad_design_bpf */
+void biquad_design_bpf(Biquad_Coef_t* c, float32_t fc, float32_t Q, float32_t Ts)
+{
+    double w0 = 2.0 * 3.14159265358979323846 * (double)fc * (double)Ts;
+    double cw = cos(w0);
+    double alpha = sin(w0) / (2.0 * (double)Q);
+
+    biquad_store(c, alpha, 0.0, -alpha, 1.0 + alpha, -2.0 * cw, 1.0 - alpha);
+} //<- end of biquad_design_bpf()
+
+/** \copydoc biquad_set_stage */
+void biquad_set_stage(Biquad_Obj_t* const bq, uint16_t stage, uint16_t ch, const Biquad_Coef_t* c)
+{
+    uint16_t first = (ch == BIQUAD_ALL_CHANNELS) ? 0 : ch;
+    uint16_t last = (ch == BIQUAD_ALL_CHANNELS) ? bq->n_ch : ch + 1;
+    uint16_t k;
+
+    if (stage >= bq->n_stages || last > bq->n_ch) {
+        return;
+    }
+    for (k = first; k < last; k++) {
+        bq->b0[stage][k] = c->b0;
+        bq->b1[stage][k] = c->b1;
+        bq->b2[stage][k] = c->b2;
+        bq->a1[stage][k] = c->a1;
+        bq->a2[stage][k] = c->a2;
+    }
+} //<- end of biquad_set_stage()
+
+/** \copydoc biquad_reset */
+void biquad_reset(Biquad_Obj_t* const bq, const float32_t* x0)
+{
+    uint16_t k, s;
+
+    for (k = 0; k < bq->n_ch; k++) {
+        float32_t x = x0 ? x0[k] : 0;
+        for (s = 0; s < bq->n_stages; s++) {
+            // DC gain of the section, y = x (b0 + b1 + b2) / (1 + a1 + a2)
+            float32_t den = 1.0f + bq->a1[s][k] + bq->a2[s][k];
+            float32_t y = (den != 0) ? x * (bq->b0[s][k] + bq->b1[s][k] + bq->b2[s][k]) / den : 0;
+            bq->s2[s][k] = bq->b2[s][k] * x - bq->a2[s][k] * y;
+            bq->s1[s][k] = bq->b1[s][k] * x - bq->a1[s][k] * y + bq->s2[s][k];
+            x = y;
+        }
+    }
+} //<- end of biquad_reset()
+
+/** \copydoc biquad_update_scalar */
+void biquad_update_scalar(Biquad_Obj_t* const bq, const float32_t* x, float32_t* y)
+{
+    uint16_t k, s;
+
+    for (k = 0; k < bq->n_ch; k++) {
+        float32_t v = x[k];
+        for (s = 0; s < bq->n_stages; s++) {
+            float32_t out = bq->b0[s][k] * v + bq->s1[s][k];
+            bq->s1[s][k] = bq->b1[s][k] * v - bq->a1[s][k] * out + bq->s2[s][k];
+            bq->s2[s][k] = bq->b2[s][k] * v - bq->a2[s][k] * out;
+            v = out;
+        }
+        y[k] = v;
+    }
+} //<- end of biquad_update_scalar()
+
+#if defined(BIQUAD_X86)
+
+// 4 lanes per group, as many groups as n_ch needs
+BIQUAD_TARGET("sse")
+static void biquad_update_sse(Biquad_Obj_t* const bq, const float32_t* in, float32_t* out)
+{
+    uint16_t g, s, k;
+
+    for (g = 0; g < bq->n_ch; g += 4) {
+        const uint16_t n = (bq->n_ch - g < 4) ? bq->n_ch - g : 4;
+        float32_t v[4] = {0};
+        __m128 x;
+
+        for (k = 0; k < n; k++) {
+            v[k] = in[g + k];
+        }
+        x = _mm_loadu_ps(v);
+        for (s = 0; s < bq->n_stages; s++) {
+            __m128 y = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&bq->b0[s][g]), x), _mm_loadu_ps(&bq->s1[s][g]));
+            __m128 s1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(_mm_loadu_ps(&bq->b1[s][g]), x),
+                                              _mm_mul_ps(_mm_loadu_ps(&bq->a1[s][g]), y)),
+                                   _mm_loadu_ps(&bq->s2[s][g]));
+            __m128 s2 = _mm_sub_ps(_mm_mul_ps(_mm_loadu_ps(&bq->b2[s][g]), x),
+                                   _mm_mul_ps(_mm_loadu_ps(&bq->a2[s][g]), y));
+            _mm_storeu_ps(&bq->s1[s][g], s1);
+            _mm_storeu_ps(&bq->s2[s][g], s2);
+            x = y;
+        }
+        _mm_storeu_ps(v, x);
+        for (k = 0; k < n; k++) {
+            out[g + k] = v[k];
+        }
+    }
+}
+
+// all 8 lanes in one register, the n_ch used ones loaded and stored under a mask
+BIQUAD_TARGET("avx2")
+static void biquad_update_avx2(Biquad_Obj_t* const bq, const float32_t* in, float32_t* out)
+{
+    static const int32_t lanes[2 * BIQUAD_MAX_CHANNELS] = {-1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0};
+    const __m256i mask = _mm256_loadu_si256((const __m256i*)(lanes + BIQUAD_MAX_CHANNELS - bq->n_ch));
+    __m256 x = _mm256_maskload_ps(in, mask);
+    uint16_t s;
+
+    for (s = 0; s < bq->n_stages; s++) {
+        __m256 y = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(bq->b0[s]), x), _mm256_loadu_ps(bq->s1[s]));
+        __m256 s1 = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(_mm256_loadu_ps(bq->b1[s]), x),
+                                                _mm256_mul_ps(_mm256_loadu_ps(bq->a1[s]), y)),
+                                  _mm256_loadu_ps(bq->s2[s]));
+        __m256 s2 = _mm256_sub_ps(_mm256_mul_ps(_mm256_loadu_ps(bq->b2[s]), x),
+                                  _mm256_mul_ps(_mm256_loadu_ps(bq->a2[s]), y));
+        _mm256_storeu_ps(bq->s1[s], s1);
+        _mm256_storeu_ps(bq->s2[s], s2);
+        x = y;
+    }
+    _mm256_maskstore_ps(out, mask, x);
+}
+
+#endif // BIQUAD_X86
+
+//*****************************************************************************
+//
+// dispatch, at init
+//
+//*****************************************************************************
+static Biquad_fn_t biquad_fn = 0;       // NULL: scalar only
+static const char* biquad_name = 0;
+
+static void biquad_select(void)
+{
+    Biquad_fn_t fn = 0;
+    const char* name = "scalar";
+
+#if defined(BIQUAD_X86)
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    int has_sse = __builtin_cpu_supports("sse");
+    int has_avx2 = __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    int has_sse = (info[3] >> 25) & 1;
+    int has_osxsave = (info[2] >> 27) & 1;
+    __cpuidex(info, 7, 0);
+    int has_avx2 = has_osxsave && ((info[1] >> 5) & 1) && ((_xgetbv(0) & 6) == 6);
+#else
+    int has_sse = 0;
+    int has_avx2 = 0;
+#endif
+    if (has_avx2) {
+        fn = biquad_update_avx2;
+        name = "avx2";
+    }
+    else if (has_sse) {
+        fn = biquad_update_sse;
+        name = "sse";
+    }
+#endif
+
+    biquad_fn = fn;
+    biquad_name = name;
+}
+
+/** \copydoc biquad_init */
+int16_t biquad_init(Biquad_Obj_t* const bq, uint16_t n_ch, uint16_t n_stages)
+{
+    static const Biquad_Coef_t pass = {1.0f, 0, 0, 0, 0};
+    uint16_t s;
+
+    if (n_ch == 0 || n_ch > BIQUAD_MAX_CHANNELS || n_stages == 0 || n_stages > BIQUAD_MAX_STAGES) {
+        return -1;
+    }
+
+    if (biquad_name == 0) {
+        biquad_select();
+    }
+
+    memset(bq, 0, sizeof(*bq));
+    bq->update = (biquad_fn != 0 && n_ch >= BIQUAD_VECTOR_MIN_CH) ? biquad_fn : biquad_update_scalar;
+    bq->n_ch = n_ch;
+    bq->n_stages = n_stages;
+    for (s = 0; s < n_stages; s++) {
+        biquad_set_stage(bq, s, BIQUAD_ALL_CHANNELS, &pass);
+    }
+    return 0;
+} //<- end of biquad_init()
+
+/** \copydoc biquad_update */
+void biquad_update(Biquad_Obj_t* const bq, const float32_t* x, float32_t* y)
+{
+    MC_INSTR_BEGIN(MC_INSTR_BIQUAD_UPDATE);
+
+    bq->update(bq, x, y);
+
+    MC_INSTR_END(MC_INSTR_BIQUAD_UPDATE);
+} //<- end of biquad_update()
+
+/** \copydoc biquad_isa */
+const char* biquad_isa(void)
+{
+    if (biquad_name == 0) {
+        biquad_select();
+    }
+    return biquad_name;
+} //<- end of biquad_isa()
+
+// EOF filters_biquad.c
@@ -0,0 +1,37 @@
+/**
+ * @file        filters_q.c
+ * @date        Oct 2026
+ *
+ * @brief      source interface file for the fixed-point filters
+ *
+ */
+
+#include "filters_q.h"
+
+
+/** \copydoc lpf_1st_init_q */
+void lpf_1st_init_q(Lpf1stq_Obj_t* const lpf_1st_inst, q_t y, q_t u,
+                float32_t a0, float32_t a1, float32_t b1)
+{
+    lpf_1st_inst->y = y;
+    lpf_1st_inst->u = u;
+
+    lpf_1st_inst->a0 = q_from_float(a0);
+    lpf_1st_inst->a1 = q_from_float(a1);
+    lpf_1st_inst->b1 = q_from_float(b1);
+}
+
+/** \copydoc lpf_1st_update_q */
+void lpf_1st_update_q(Lpf1stq_Obj_t* const lpf_1st_inst, q_t u)
+{
+    q_acc_t acc;
+
+    acc = ((q_acc_t)lpf_1st_inst->b1 * lpf_1st_inst->y) >> 2;
+    acc += ((q_acc_t)lpf_1st_inst->a0 * u) >> 2;
+    acc += ((q_acc_t)lpf_1st_inst->a1 * lpf_1st_inst->u) >> 2;
+
+    lpf_1st_inst->y = q_sat((acc + ((q_acc_t)1 << (MC_Q_BITS - 3))) >> (MC_Q_BITS - 2));
+    lpf_1st_inst->u = u;
+}
+
+// EOF filters_q.c
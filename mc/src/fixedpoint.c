@@ -0,0 +1,153 @@
+/**
+ * @file        fixedpoint.c
+ * @date        Oct 2026
+ *
+ * @brief       fixed-point conversions and the Q sine/cosine table
+ *
+ */
+
+#include "fixedpoint.h"
+
+// sin(k*PI/512) in Q31, k = 0..256: one quadrant in 256 steps
+//
+static const int32_t q_sin_tab[257] = {
+             0,   13176712,   26352928,   39528151,   52701887,   65873638,   79042909,   92209205,
+     105372028,  118530885,  131685278,  144834714,  157978697,  171116733,  184248325,  197372981,
+     210490206,  223599506,  236700388,  249792358,  262874923,  275947592,  289009871,  302061269,
+     315101295,  328129457,  341145265,  354148230,  367137861,  380113669,  393075166,  406021865,
+     418953276,  431868915,  444768294,  457650927,  470516330,  483364019,  496193509,  509004318,
+     521795963,  534567963,  547319836,  560051104,  572761285,  585449903,  598116479,  610760536,
+     623381598,  635979190,  648552838,  661102068,  673626408,  686125387,  698598533,  711045377,
+     723465451,  735858287,  748223418,  760560380,  772868706,  785147934,  797397602,  809617249,
+     821806413,  833964638,  846091463,  858186435,  870249095,  882278992,  894275671,  906238681,
+     918167572,  930061894,  941921200,  953745043,  965532978,  977284562,  988999351, 1000676905,
+    1012316784, 1023918550, 1035481766, 1047005996, 1058490808, 1069935768, 1081340445, 1092704411,
+    1104027237, 1115308496, 1126547765, 1137744621, 1148898640, 1160009405, 1171076495, 1182099496,
+    1193077991, 1204011567, 1214899813, 1225742318, 1236538675, 1247288478, 1257991320, 1268646800,
+    1279254516, 1289814068, 1300325060, 1310787095, 1321199781, 1331562723, 1341875533, 1352137822,
+    1362349204, 1372509294, 1382617710, 1392674072, 1402678000, 1412629117, 1422527051, 1432371426,
+    1442161874, 1451898025, 1461579514, 1471205974, 1480777044, 1490292364, 1499751576, 1509154322,
+    1518500250, 1527789007, 1537020244, 1546193612, 1555308768, 1564365367, 1573363068, 1582301533,
+    1591180426, 1599999411, 1608758157, 1617456335, 1626093616, 1634669676, 1643184191, 1651636841,
+    1660027308, 1668355276, 1676620432, 1684822463, 1692961062, 1701035922, 1709046739, 1716993211,
+    1724875040, 1732691928, 1740443581, 1748129707, 1755750017, 1763304224, 1770792044, 1778213194,
+    1785567396, 1792854372, 1800073849, 1807225553, 1814309216, 1821324572, 1828271356, 1835149306,
+    1841958164, 1848697674, 1855367581, 1861967634, 1868497586, 1874957189, 1881346202, 1887664383,
+    1893911494, 1900087301, 1906191570, 1912224073, 1918184581, 1924072871, 1929888720, 1935631910,
+    1941302225, 1946899451, 1952423377, 1957873796, 1963250501, 1968553292, 1973781967, 1978936331,
+    1984016189, 1989021350, 1993951625, 1998806829, 2003586779, 2008291295, 2012920201, 2017473321,
+    2021950484, 2026351522, 2030676269, 2034924562, 2039096241, 2043191150, 2047209133, 2051150040,
+    2055013723, 2058800036, 2062508835, 2066139983, 2069693342, 2073168777, 2076566160, 2079885360,
+    2083126254, 2086288720, 2089372638, 2092377892, 2095304370, 2098151960, 2100920556, 2103610054,
+    2106220352, 2108751352, 2111202959, 2113575080, 2115867626, 2118080511, 2120213651, 2122266967,
+    2124240380, 2126133817, 2127947206, 2129680480, 2131333572, 2132906420, 2134398966, 2135811153,
+    2137142927, 2138394240, 2139565043, 2140655293, 2141664948, 2142593971, 2143442326, 2144209982,
+    2144896910, 2145503083, 2146028480, 2146473080, 2146836866, 2147119825, 2147321946, 2147443222,
+    2147483647,
+};
+
+/** \copydoc q_from_float */
+q_t q_from_float(float32_t x)
+{
+    float64_t v = (float64_t)x * Q_SCALE;
+
+    v += (v >= 0) ? 0.5 : -0.5;
+    if (v >= (float64_t)Q_MAX)
+    {
+        return Q_MAX;
+    }
+    if (v <= (float64_t)Q_MIN)
+    {
+        return Q_MIN;
+    }
+    return (q_t)v;
+} //<- end of q_from_float()
+
+/** \copydoc q_to_float */
+float32_t q_to_float(q_t x)
+{
+    return (float32_t)((float64_t)x / Q_SCALE);
+} //<- end of q_to_float()
+
+/** \copydoc q_gain_from_float */
+q_gain_t q_gain_from_float(float32_t g)
+{
+    q_gain_t gain;
+    float32_t a = (g < 0) ? -g : g;
+
+    gain.e = 0;
+    while ((a >= 1.0f) && (gain.e < MC_Q_BITS - 1))
+    {
+        a *= 0.5f;
+        g *= 0.5f;
+        gain.e++;
+    }
+    while ((a > 0.0f) && (a < 0.5f) && (gain.e > 1 - MC_Q_BITS))
+    {
+        a *= 2.0f;
+        g *= 2.0f;
+        gain.e--;
+    }
+    gain.m = q_from_float(g);
+    return gain;
+} //<- end of q_gain_from_float()
+
+// sin of a position inside the quadrant, pos in [0, 2^30] is [0, PI/2]
+//
+static int32_t q_sin_quadrant(uint32_t pos)
+{
+    uint32_t idx = pos >> 22;
+    int32_t frac = (int32_t)((pos >> 6) & 0xFFFF);
+    int32_t y0 = q_sin_tab[idx];
+
+    if (idx >= 256)
+    {
+        return y0;
+    }
+    return y0 + (int32_t)(((int64_t)(q_sin_tab[idx + 1] - y0) * frac) >> 16);
+}
+
+// Q31 table value to q_t, rounded
+//
+static q_t q_from_q31(int32_t x)
+{
+#if MC_Q_BITS == 15
+    return q_sat((q_acc_t)(((int64_t)x + 0x8000) >> 16));
+#else
+    return x;
+#endif
+}
+
+/** \copydoc q_sincos */
+void q_sincos(q_t theta, SinCos_q_t *sc)
+{
+    // [-1, 1) -> [0, 2^32) covers the full turn
+    uint32_t phase = (uint32_t)(int32_t)theta << (31 - MC_Q_BITS);
+    uint32_t quadrant = phase >> 30;
+    uint32_t pos = phase & 0x3FFFFFFFu;
+
+    int32_t s = q_sin_quadrant(pos);
+    int32_t c = q_sin_quadrant(0x40000000u - pos);
+
+    switch (quadrant)
+    {
+    case 0:
+        sc->sin = q_from_q31(s);
+        sc->cos = q_from_q31(c);
+        break;
+    case 1:
+        sc->sin = q_from_q31(c);
+        sc->cos = q_from_q31(-s);
+        break;
+    case 2:
+        sc->sin = q_from_q31(-s);
+        sc->cos = q_from_q31(-c);
+        break;
+    default:
+        sc->sin = q_from_q31(-c);
+        sc->cos = q_from_q31(s);
+        break;
+    }
+} //<- end of q_sincos()
+
+// EOF fixedpoint.c
@@ -0,0 +1,103 @@
+/**
+ * @file        foc.c
+ * @date        Oct 2026
+ *
+ * @brief       fused FOC current loop
+ *
+ */
+
+#include "ctrl_common.h"
+#include "foc.h"
+#include "instrument.h"
+#include "pid.h"
+#include "svm.h"
+#include "trig.h"
+
+/** \copydoc foc_init */
+int16_t foc_init(FOC_Obj_t* const foc_inst, int16_t numSensors, SVM_mode_t mode)
+{
+    // foc_current_step() has the two Clarke variants of abc2AB0() only
+    if (numSensors != 2 && numSensors != 3)
+    {
+        return -1;
+    }
+
+    PID_Data_Init(&foc_inst->pid_d, 0, 0, 0, 0, 0);
+    PID_Data_Init(&foc_inst->pid_q, 0, 0, 0, 0, 0);
+
+    foc_inst->svm.UAB[0] = 0;
+    foc_inst->svm.UAB[1] = 0;
+    foc_inst->svm.sector = 0;
+    foc_inst->svm.m[0] = 0;
+    foc_inst->svm.m[1] = 0;
+    foc_inst->svm.m[2] = 0;
+    foc_inst->svm.zs_shift = 0;
+
+    foc_inst->mode = mode;
+    foc_inst->numSensors = numSensors;
+    foc_inst->id = 0;
+    foc_inst->iq = 0;
+
+    return 0;
+} //<- end of foc_init()
+
+/** \copydoc foc_current_step */
+void foc_current_step(FOC_Obj_t* const foc_inst,
+    float32_t ia,
+    float32_t ib,
+    float32_t ic,
+    float32_t theta_e,
+    float32_t id_ref,
+    float32_t iq_ref,
+    float32_t duty[3])
+{
+    MC_INSTR_BEGIN(MC_INSTR_FOC_CURRENT_STEP);
+
+    float32_t alpha, beta;
+    SinCos_t sc;
+
+    // Clarke, same arithmetic as abc2AB0(); foc_init() took 2 or 3 sensors
+    //
+    if (foc_inst->numSensors == 3)
+    {
+        alpha = TWO_THIRD*ia-ONE_THIRD*(ib+ic);
+        beta = SQRT3REC*(ib-ic);
+    }
+    else
+    {
+        alpha = ia;
+        beta = SQRT3REC*(ia + 2*ib);
+    }
+
+    // one sin/cos for both Park and inverse Park
+    //
+    trig_sincos(theta_e, &sc);
+
+    float32_t id = alpha * sc.cos + beta * sc.sin;
+    float32_t iq = - alpha * sc.sin + beta * sc.cos;
+
+    float32_t vd = PID_Update_Inline(&foc_inst->pid_d, id_ref, id, 0);
+    float32_t vq = PID_Update_Inline(&foc_inst->pid_q, iq_ref, iq, 0);
+
+    // inverse Park
+    //
+    float32_t Ualpha = vd * sc.cos - vq * sc.sin;
+    float32_t Ubeta = vd * sc.sin + vq * sc.cos;
+
+    if ((foc_inst->mode & SVM_ZS_MASK) == DPWM_ADAPTIVE)
+    {
+        svm_set_load_vectors(&foc_inst->svm, vd, vq, id, iq);
+    }
+    modulator_lut(&foc_inst->svm, Ualpha, Ubeta, foc_inst->mode);
+
+    duty[0] = foc_inst->svm.m[0];
+    duty[1] = foc_inst->svm.m[1];
+    duty[2] = foc_inst->svm.m[2];
+
+    foc_inst->id = id;
+    foc_inst->iq = iq;
+
+    MC_INSTR_END(MC_INSTR_FOC_CURRENT_STEP);
+} //<- end of foc_current_step()
+
+// EOF foc.c
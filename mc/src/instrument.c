@@ -0,0 +1,146 @@
+/**
+ * @file        instrument.c
+ * @date        Oct 2026
+ *
+ * @brief       Statistics and report of the kernel cycle instrumentation
+ *
+ */
+
+#include "instrument.h"
+
+#define MC_INSTR_STAT_INIT          {0, 0xFFFFFFFFu, 0, 0, {0}}
+
+static const char* const mc_instr_names[] = {
+    "modulator",
+    "PID_Update",
+    "abc2AB0",
+    "AB02abc",
+    "AB02dq0",
+    "AB02dq0_sincos",
+    "dq02AB0",
+    "dq02AB0_sincos",
+    "lpf_1st_update",
+    "biquad_update",
+    "decim_cic_process",
+    "adc_clarke",
+    "adc_clarke_batch",
+    "drive_bank_step",
+    "foc_current_step",
+};
+
+// one name per MC_Instr_Id_t
+typedef char mc_instr_names_check[(sizeof(mc_instr_names) / sizeof(mc_instr_names[0]) == MC_INSTR_NUM) ? 1 : -1];
+
+// sized by the initializer, so a kernel added without an entry fails the check below
+MC_Instr_Stat_t mc_instr_stats[] = {
+    MC_INSTR_STAT_INIT, MC_INSTR_STAT_INIT, MC_INSTR_STAT_INIT,
+    MC_INSTR_STAT_INIT, MC_INSTR_STAT_INIT, MC_INSTR_STAT_INIT,
+    MC_INSTR_STAT_INIT, MC_INSTR_STAT_INIT, MC_INSTR_STAT_INIT,
+    MC_INSTR_STAT_INIT, MC_INSTR_STAT_INIT, MC_INSTR_STAT_INIT,
+    MC_INSTR_STAT_INIT, MC_INSTR_STAT_INIT, MC_INSTR_STAT_INIT,
+};
+
+typedef char mc_instr_stats_check[(sizeof(mc_instr_stats) / sizeof(mc_instr_stats[0]) == MC_INSTR_NUM) ? 1 : -1];
+
+static uint32_t mc_instr_zero(void)
+{
+    return 0;
+}
+
+uint32_t (*mc_instr_counter)(void) = mc_instr_zero;
+
+/** \copydoc mc_instr_reset */
+void mc_instr_reset(void)
+{
+    static const MC_Instr_Stat_t empty = MC_INSTR_STAT_INIT;
+    int16_t i;
+
+    for (i = 0; i < MC_INSTR_NUM; i++) {
+        mc_instr_stats[i] = empty;
+    }
+} //<- end of mc_instr_reset()
+
+/** \copydoc mc_instr_get */
+const MC_Instr_Stat_t* mc_instr_get(MC_Instr_Id_t id)
+{
+    return &mc_instr_stats[id];
+} //<- end of mc_instr_get()
+
+/** \copydoc mc_instr_name */
+const char* mc_instr_name(MC_Instr_Id_t id)
+{
+    return (id >= 0 && id < MC_INSTR_NUM) ? mc_instr_names[id] : "?";
+} //<- end of mc_instr_name()
+
+/** \copydoc mc_instr_set_counter */
+void mc_instr_set_counter(uint32_t (*counter)(void))
+{
+    mc_instr_counter = counter ? counter : mc_instr_zero;
+} //<- end of mc_instr_set_counter()
+
+/** \copydoc mc_instr_overhead */
+uint32_t mc_instr_overhead(void)
+{
+#if MC_INSTRUMENT
+    // the record goes to the first kernel's statistics, put back afterwards
+    const MC_Instr_Stat_t saved = mc_instr_stats[MC_INSTR_MODULATOR];
+    uint32_t empty = 0xFFFFFFFFu;
+    uint32_t full = 0xFFFFFFFFu;
+    int16_t i;
+
+    for (i = 0; i < 64; i++) {
+        uint32_t t0 = MC_CYCLE_COUNTER();
+        uint32_t t1 = MC_CYCLE_COUNTER();
+        empty = (t1 - t0) < empty ? (t1 - t0) : empty;
+
+        t0 = MC_CYCLE_COUNTER();
+        {
+            MC_INSTR_BEGIN(MC_INSTR_MODULATOR);
+            MC_INSTR_END(MC_INSTR_MODULATOR);
+        }
+        t1 = MC_CYCLE_COUNTER();
+        full = (t1 - t0) < full ? (t1 - t0) : full;
+    }
+    mc_instr_stats[MC_INSTR_MODULATOR] = saved;
+    return full > empty ? full - empty : 0;
+#else
+    return 0;
+#endif
+} //<- end of mc_instr_overhead()
+
+/** \copydoc mc_instr_report */
+void mc_instr_report(int (*print)(const char *format, ...))
+{
+    int16_t i, b;
+
+    if (!MC_INSTRUMENT) {
+        print("instrumentation compiled out, build with MC_INSTRUMENT=1\n");
+        return;
+    }
+
+    print("%-18s %10s %8s %10s %8s   (counter ticks, a record costs %u, not subtracted)\n",
+          "kernel", "calls", "min", "mean", "max", (unsigned)mc_instr_overhead());
+
+    for (i = 0; i < MC_INSTR_NUM; i++) {
+        const MC_Instr_Stat_t* s = &mc_instr_stats[i];
+        if (s->count == 0) {
+            continue;
+        }
+        print("%-18s %10u %8u %10.1f %8u\n", mc_instr_names[i], (unsigned)s->count, (unsigned)s->min,
+              (double)s->sum / (double)s->count, (unsigned)s->max);
+
+        for (b = 0; b < MC_INSTR_HIST_BINS; b++) {
+            if (s->hist[b] == 0) {
+                continue;
+            }
+            if (b == MC_INSTR_HIST_BINS - 1) {
+                print("    >= %-8u %10u\n", 1u << b, (unsigned)s->hist[b]);
+            }
+            else {
+                print("    %5u-%-5u %10u\n", 1u << b, (2u << b) - 1, (unsigned)s->hist[b]);
+            }
+        }
+    }
+} //<- end of mc_instr_report()
+
+// EOF instrument.c
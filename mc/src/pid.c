@@ -9,6 +9,7 @@
 
 #include "ctrl_common.h"
 #include "pid.h"
+#include "instrument.h"
 
 /** \copydoc PID_Data_Init */
 void PID_Data_Init(PID_Obj_t* const PID_inst,
@@ -21,8 +22,12 @@ void PID_Data_Init(PID_Obj_t* const PID_inst,
     PID_inst->err = err;
     PID_inst->ui = ui;
     PID_inst->u = u;
-    PID_inst->uff = uff;
     PID_inst->err_aw = err_aw;
+#if MC_PID_LEGACY
+    PID_inst->uff = uff;
+#else
+    (void)uff;
+#endif
 } //<- end of PID_Data_Init()
 
 
@@ -39,77 +44,58 @@ void PID_Param_Init(PID_Obj_t* const PID_inst,
     int16_t       Kd_enable, // Kd_enable == false to disable DERIVATIVE, otherwise to use the deduced value
     float32_t     Kp_aw)
 {
-    PID_inst->OutHiLim     = OutHiLim;
-    PID_inst->OutLoLim     = OutLoLim;
-    PID_inst->IntRateLim   = IntRateLim;
-    PID_inst->Kp        = Kp;
-    PID_inst->Ts        = Ts;
-    PID_inst->Ti        = Ti;
-    PID_inst->Td        = Td;
+    PID_Cfg_t cfg;
+
+    cfg.OutHiLim    = OutHiLim;
+    cfg.OutLoLim    = OutLoLim;
+    cfg.IntRateLim  = IntRateLim;
+    cfg.Kp          = Kp;
+    cfg.Ts          = Ts;
+    cfg.Ti          = Ti;
+    cfg.Td          = Td;
+    cfg.Kp_aw       = Kp_aw;
+    cfg.Ki_enable   = Ki_enable != 0;
+    cfg.Kd_enable   = Kd_enable != 0;
+
+    PID_Cfg_Apply(PID_inst, &cfg);
+} //<- end of PID_Param_Init()
 
-    if (Ki_enable){
-        PID_inst->Ki = Kp*Ts/Ti;
+
+/** \copydoc PID_Cfg_Apply */
+void PID_Cfg_Apply(PID_Obj_t* const PID_inst, const PID_Cfg_t* cfg)
+{
+    PID_inst->OutHiLim     = cfg->OutHiLim;
+    PID_inst->OutLoLim     = cfg->OutLoLim;
+    PID_inst->IntRateLim   = cfg->IntRateLim;
+    PID_inst->Kp        = cfg->Kp;
+#if MC_PID_LEGACY
+    PID_inst->Ts        = cfg->Ts;
+    PID_inst->Ti        = cfg->Ti;
+    PID_inst->Td        = cfg->Td;
+#endif
+
+    if (cfg->Ki_enable){
+        PID_inst->Ki = cfg->Kp*cfg->Ts/cfg->Ti;
     }
     else {
         PID_inst->Ki = 0; // disable INTEGRAL
     }
 
-    if (Kd_enable){
-        PID_inst->Kd = Kp*Td/Ts;
+    if (cfg->Kd_enable){
+        PID_inst->Kd = cfg->Kp*cfg->Td/cfg->Ts;
     }
     else {
         PID_inst->Kd = 0; // disable DERIVATIVE
     }
 
-    PID_inst->Kp_aw     = Kp_aw;
-} //<- end of PID_Param_Init()
+    PID_inst->Kp_aw     = cfg->Kp_aw;
+} //<- end of PID_Cfg_Apply()
 
 
 /** \copydoc PID_Update */
 void PID_Update(PID_Obj_t* const PID_inst, float32_t ref, float32_t fb, float32_t uff)
 {
-    float32_t err = ref - fb;
-    float32_t err_k1 = PID_inst->err;
-    float32_t err_aw = PID_inst->err_aw;
-    float32_t ui = PID_inst->ui;
-    float32_t u = PID_inst->u;
-
-    // compute the incremental proportional output
-    // 
-    float32_t up = PID_inst->Kp * err;
-
-    // compute the incremental integral output with anti-windup calculation applied
-    // 
-    float32_t delta_ui = (PID_inst->Ki * (err+err_k1)/2) + (PID_inst->Kp_aw * err_aw);
-
-    // integral change rate limitation
-    // 
-    SATURATE(delta_ui, PID_inst->IntRateLim, -PID_inst->IntRateLim);
-
-    ui += delta_ui;
-
-    SATURATE(ui, PID_inst->OutHiLim, PID_inst->OutLoLim);
-
-    PID_inst->ui = ui;
-    
-    // comput the incremental derivative output
-    // 
-    float32_t ud = PID_inst->Kd*(err - err_k1);
-
-    // compute the control output
-    // 
-    u = up + ui + ud + uff;
-    PID_inst->u = u;
-
-    // control output limitation
-    // 
-    SATURATE(PID_inst->u, PID_inst->OutHiLim, PID_inst->OutLoLim);
-
-    // update anti-windup error for next iteration
-    // 
-    PID_inst->err_aw = PID_inst->u - u;
-
-    // update the error history
-    //
-    PID_inst->err = err;
+    MC_INSTR_BEGIN(MC_INSTR_PID_UPDATE);
+    (void)PID_Update_Inline(PID_inst, ref, fb, uff);
+    MC_INSTR_END(MC_INSTR_PID_UPDATE);
 } //<- end of PID_Update()
@@ -0,0 +1,108 @@
+/**
+ * @file        pid_q.c
+ * @date        Oct 2026
+ *
+ * @brief      source file for the fixed-point PID Controller
+ *
+ */
+
+#include "pid_q.h"
+
+/** \copydoc PID_Data_Init_q */
+void PID_Data_Init_q(PIDq_Obj_t* const PID_inst,
+    q_t err,
+    q_t ui,
+    q_t u,
+    q_t uff,
+    q_t err_aw)
+{
+    PID_inst->err = err;
+    PID_inst->ui = ui;
+    PID_inst->ui_w = (q_acc_t)ui * ((q_acc_t)1 << Q_WIDE_SHIFT);
+    PID_inst->u = u;
+    PID_inst->err_aw = err_aw;
+    (void)uff;
+} //<- end of PID_Data_Init_q()
+
+
+/** \copydoc PID_Param_Init_q */
+void PID_Param_Init_q(PIDq_Obj_t* const PID_inst,
+    float32_t     OutHiLim,
+    float32_t     OutLoLim,
+    float32_t     IntRateLim,
+    float32_t     Kp,
+    float32_t     Ts,
+    float32_t     Ti,
+    int16_t       Ki_enable,
+    float32_t     Td,
+    int16_t       Kd_enable,
+    float32_t     Kp_aw)
+{
+    PID_inst->OutHiLim     = q_from_float(OutHiLim);
+    PID_inst->OutLoLim     = q_from_float(OutLoLim);
+    PID_inst->IntRateLim   = q_from_float(IntRateLim);
+    PID_inst->Kp           = q_gain_from_float(Kp);
+    PID_inst->Ki           = q_gain_from_float(Ki_enable ? Kp*Ts/Ti : 0);
+    PID_inst->Kd           = q_gain_from_float(Kd_enable ? Kp*Td/Ts : 0);
+    PID_inst->Kp_aw        = q_gain_from_float(Kp_aw);
+} //<- end of PID_Param_Init_q()
+
+
+/** \copydoc PID_Update_q */
+void PID_Update_q(PIDq_Obj_t* const PID_inst, q_t ref, q_t fb, q_t uff)
+{
+    q_t err = q_sub(ref, fb);
+    q_t err_k1 = PID_inst->err;
+    q_acc_t ui_w = PID_inst->ui_w;
+    q_acc_t u;
+    q_t u_sat;
+
+    // compute the incremental proportional output
+    //
+    q_t up = q_mul_gain(err, PID_inst->Kp);
+
+    // compute the incremental integral output with anti-windup calculation applied,
+    // (err+err_k1)/2 cannot overflow in the wide type; the integral is summed in the
+    // wide format, each term is below 1 in magnitude so the sum cannot overflow
+    //
+    q_t err_avg = (q_t)(((q_acc_t)err + err_k1) >> 1);
+    q_acc_t delta_ui = q_mul_gain_wide(err_avg, PID_inst->Ki) + q_mul_gain_wide(PID_inst->err_aw, PID_inst->Kp_aw);
+    q_acc_t rate_lim = (q_acc_t)PID_inst->IntRateLim * ((q_acc_t)1 << Q_WIDE_SHIFT);
+
+    // integral change rate limitation
+    //
+    SATURATE(delta_ui, rate_lim, -rate_lim);
+
+    ui_w += delta_ui;
+
+    SATURATE(ui_w, (q_acc_t)PID_inst->OutHiLim * ((q_acc_t)1 << Q_WIDE_SHIFT),
+             (q_acc_t)PID_inst->OutLoLim * ((q_acc_t)1 << Q_WIDE_SHIFT));
+
+    PID_inst->ui_w = ui_w;
+    q_t ui = q_from_wide(ui_w);
+    PID_inst->ui = ui;
+
+    // comput the incremental derivative output
+    //
+    q_t ud = q_mul_gain(q_sub(err, err_k1), PID_inst->Kd);
+
+    // compute the control output, unsaturated sum in the wide type
+    //
+    u = (q_acc_t)up + ui + ud + uff;
+
+    // control output limitation
+    //
+    u_sat = q_sat(u);
+    SATURATE(u_sat, PID_inst->OutHiLim, PID_inst->OutLoLim);
+    PID_inst->u = u_sat;
+
+    // update anti-windup error for next iteration
+    //
+    PID_inst->err_aw = q_sat(u_sat - u);
+
+    // update the error history
+    //
+    PID_inst->err = err;
+} //<- end of PID_Update_q()
+
+// EOF pid_q.c
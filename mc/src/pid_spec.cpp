@@ -0,0 +1,29 @@
+/**
+ * @file        pid_spec.cpp
+ * @date        Oct 2026
+ *
+ * @brief       C entry points of the compile-time specialized PID controllers
+ *
+ */
+
+#include "pid.hpp"
+
+/** \copydoc PID_Update_P */
+extern "C" void PID_Update_P(PID_Obj_t* const PID_inst, float32_t ref, float32_t fb, float32_t uff)
+{
+    (void)mc::Pid<mc::PidP>::update(*PID_inst, ref, fb, uff);
+} //<- end of PID_Update_P()
+
+/** \copydoc PID_Update_PI */
+extern "C" void PID_Update_PI(PID_Obj_t* const PID_inst, float32_t ref, float32_t fb, float32_t uff)
+{
+    (void)mc::Pid<mc::PidPI>::update(*PID_inst, ref, fb, uff);
+} //<- end of PID_Update_PI()
+
+/** \copydoc PID_Update_PID */
+extern "C" void PID_Update_PID(PID_Obj_t* const PID_inst, float32_t ref, float32_t fb, float32_t uff)
+{
+    (void)mc::Pid<mc::PidPID>::update(*PID_inst, ref, fb, uff);
+} //<- end of PID_Update_PID()
+
+// EOF pid_spec.cpp
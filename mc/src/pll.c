@@ -0,0 +1,85 @@
+/**
+ * @file        pll.c
+ * @date        Oct 2026
+ *
+ * @brief       quadrature PLL angle/speed tracker
+ *
+ */
+
+#include "ctrl_common.h"
+#include "filters.h"
+#include "pid.h"
+#include "pll.h"
+#include "trig.h"
+
+/** \copydoc pll_init */
+void pll_init(PLL_Obj_t* const pll_inst,
+    float32_t Ts,
+    float32_t Kp,
+    float32_t Ki,
+    float32_t omega_max,
+    float32_t wc)
+{
+    // backward-Euler first order low pass, y = (1-a) y + a u
+    float32_t a = wc * Ts / (1.0f + wc * Ts);
+
+    // Ki = Kp/Ti, the integral is trapezoidal; the rate limit is left open and the
+    // anti-windup takes the whole excess back out of the integral
+    PID_Param_Init(&pll_inst->pid,
+        omega_max,
+        -omega_max,
+        omega_max,
+        Kp,
+        Ts,
+        (Ki > 0) ? Kp / Ki : 1.0f,
+        Ki > 0,
+        0,
+        0,
+        1.0f);
+
+    lpf_1st_init(&pll_inst->lpf_omega, 0, 0, a, 0, 1.0f - a);
+    pll_inst->Ts = Ts;
+
+    pll_reset(pll_inst, 0, 0);
+} //<- end of pll_init()
+
+/** \copydoc pll_reset */
+void pll_reset(PLL_Obj_t* const pll_inst, float32_t theta_e, float32_t omega)
+{
+    PID_Data_Init(&pll_inst->pid, 0, omega, omega, 0, 0);
+    pll_inst->lpf_omega.y = omega;
+    pll_inst->lpf_omega.u = omega;
+
+    pll_inst->err = 0;
+    pll_inst->omega = omega;
+    pll_inst->omega_f = omega;
+    pll_inst->theta_e = theta_e;
+    trig_sincos(theta_e, &pll_inst->sc);
+} //<- end of pll_reset()
+
+/** \copydoc pll_update */
+void pll_update(PLL_Obj_t* const pll_inst, float32_t x_sin, float32_t x_cos)
+{
+    // phase error against the angle of the last update
+    //
+    float32_t err = x_sin * pll_inst->sc.cos - x_cos * pll_inst->sc.sin;
+
+    float32_t omega = PID_Update_Inline(&pll_inst->pid, err, 0, 0);
+
+    // integrate and wrap to [0, 2*PI), |omega*Ts| < PI
+    //
+    float32_t theta = pll_inst->theta_e + omega * pll_inst->Ts;
+    theta = (theta >= TWO_PI) ? theta - TWO_PI : theta;
+    theta = (theta < 0.0f) ? theta + TWO_PI : theta;
+
+    trig_sincos(theta, &pll_inst->sc);
+
+    lpf_1st_update(&pll_inst->lpf_omega, omega);
+
+    pll_inst->err = err;
+    pll_inst->omega = omega;
+    pll_inst->omega_f = pll_inst->lpf_omega.y;
+    pll_inst->theta_e = theta;
+} //<- end of pll_update()
+
+// EOF pll.c
@@ -0,0 +1,120 @@
+/**
+ * @file        smo.c
+ * @date        Oct 2026
+ *
+ * @brief       sliding-mode back-EMF observer
+ *
+ */
+
+#include "ctrl_common.h"
+#include "filters.h"
+#include "pll.h"
+#include "smo.h"
+
+#define SMO_ATAN_K                  (0.273F)    // atan(x) ~ PI/4*x + K*x*(1-|x|), |x| <= 1
+
+// smooth sign of the current error, see SMO_SWITCH
+//
+static float32_t smo_switch(float32_t x, float32_t phi_rec)
+{
+    float32_t y = x * phi_rec;
+
+    SATURATE(y, 1.0f, -1.0f);
+#if SMO_SWITCH == SMO_SWITCH_SIGMOID
+    y = y * (1.5f - 0.5f * y * y);
+#endif
+    return y;
+}
+
+// wrap to [0, 2*PI), for steps smaller than one turn
+//
+static float32_t smo_wrap(float32_t theta)
+{
+    theta = (theta >= TWO_PI) ? theta - TWO_PI : theta;
+    theta = (theta < 0.0f) ? theta + TWO_PI : theta;
+    return theta;
+}
+
+/** \copydoc smo_init */
+void smo_init(SMO_Obj_t* const smo_inst,
+    float32_t Rs,
+    float32_t Ls,
+    float32_t Ts,
+    float32_t k_slide,
+    float32_t phi,
+    float32_t wc,
+    float32_t Kp,
+    float32_t Ki,
+    float32_t omega_max)
+{
+    // backward-Euler first order low pass, y = (1-a) y + a u
+    float32_t a = wc * Ts / (1.0f + wc * Ts);
+
+    smo_inst->F = 1.0f - Rs * Ts / Ls;
+    smo_inst->G = Ts / Ls;
+    smo_inst->k_slide = k_slide;
+    smo_inst->phi_rec = 1.0f / phi;
+    smo_inst->i_est[0] = 0;
+    smo_inst->i_est[1] = 0;
+    smo_inst->z[0] = 0;
+    smo_inst->z[1] = 0;
+
+    lpf_1st_init(&smo_inst->lpf_e[0], 0, 0, a, 0, 1.0f - a);
+    lpf_1st_init(&smo_inst->lpf_e[1], 0, 0, a, 0, 1.0f - a);
+    smo_inst->wc_rec = 1.0f / wc;
+
+    pll_init(&smo_inst->pll, Ts, Kp, Ki, omega_max, wc);
+
+    smo_inst->e[0] = 0;
+    smo_inst->e[1] = 0;
+    smo_inst->omega = 0;
+    smo_inst->theta = 0;
+} //<- end of smo_init()
+
+/** \copydoc smo_update */
+void smo_update(SMO_Obj_t* const smo_inst,
+    float32_t v_alpha,
+    float32_t v_beta,
+    float32_t i_alpha,
+    float32_t i_beta)
+{
+    // switching term from the current estimation error
+    //
+    float32_t z_alpha = smo_inst->k_slide * smo_switch(smo_inst->i_est[0] - i_alpha, smo_inst->phi_rec);
+    float32_t z_beta = smo_inst->k_slide * smo_switch(smo_inst->i_est[1] - i_beta, smo_inst->phi_rec);
+
+    // current observer, forward Euler of L di/dt = v - R i - z
+    //
+    smo_inst->i_est[0] = smo_inst->F * smo_inst->i_est[0] + smo_inst->G * (v_alpha - z_alpha);
+    smo_inst->i_est[1] = smo_inst->F * smo_inst->i_est[1] + smo_inst->G * (v_beta - z_beta);
+    smo_inst->z[0] = z_alpha;
+    smo_inst->z[1] = z_beta;
+
+    // back-EMF is the low-frequency part of z
+    //
+    lpf_1st_update(&smo_inst->lpf_e[0], z_alpha);
+    lpf_1st_update(&smo_inst->lpf_e[1], z_beta);
+    float32_t e_alpha = smo_inst->lpf_e[0].y;
+    float32_t e_beta = smo_inst->lpf_e[1].y;
+
+    // angle tracker, e = omega*psi * (-sin, cos) of the rotor angle; the phase
+    // error changes sign with the direction of rotation, so follow the speed
+    // integral
+    //
+    float32_t dir = (smo_inst->pll.pid.ui < 0.0f) ? -1.0f : 1.0f;
+    pll_update(&smo_inst->pll, -dir * e_alpha, dir * e_beta);
+    float32_t omega = smo_inst->pll.omega;
+
+    // add back the phase lag of the back-EMF filter
+    //
+    float32_t x = omega * smo_inst->wc_rec;
+    SATURATE(x, 1.0f, -1.0f);
+    float32_t lag = PI * 0.25f * x + SMO_ATAN_K * x * (1.0f - ((x < 0.0f) ? -x : x));
+
+    smo_inst->e[0] = e_alpha;
+    smo_inst->e[1] = e_beta;
+    smo_inst->omega = smo_inst->pll.omega_f;
+    smo_inst->theta = smo_wrap(smo_inst->pll.theta_e + lag);
+} //<- end of smo_update()
+
+// EOF smo.c
@@ -1,20 +1,45 @@
 
 #include "svm.h"
+#include "svm_kernel.h"
+#include "svm_tables.h"
 #include "ctrl_common.h"
+#include "instrument.h"
+
+#define SVM_ADAPT_TAN_IN		(0.17632694F)	// tan(15 degrees - SVM_ADAPT_HYST)
+#define SVM_ADAPT_TAN_OUT		(0.36397028F)	// tan(15 degrees + SVM_ADAPT_HYST)
 
-static void calc_tabc(float32_t tabc[3], float32_t UAB[2]);
 static int16_t determine_sector_6N(float32_t tabc[3]); 
-static int16_t determine_sector_12N(float32_t tabc[3]); 
 static void calc_svm_duty(SVM_t* svm, float32_t tabc[3], SVM_mode_t mode);
 
-static void calc_tabc(float32_t tabc[3], float32_t UAB[2]) 
+typedef union
+{
+	float32_t		f;
+	int32_t			i;
+} SVM_f32_bits_t;
+
+/*!
+* @brief		max(x, 0) by masking with the sign bit, compilers tend to turn
+*				a compare against zero into a branch
+*/
+static float32_t clip_negative(float32_t x)
 {
-	float32_t Ualpha = UAB[0];
-	float32_t Ubeta = UAB[1];
+	SVM_f32_bits_t v;
+	v.f = x;
+	v.i &= ~(v.i >> 31);
+	return v.f;
+}
 
-	tabc[0] = Ubeta;
-	tabc[1] = (-SQRT3 * Ualpha - Ubeta) / 2.0f;
-	tabc[2] = (SQRT3 * Ualpha - Ubeta) / 2.0f;
+/*!
+* @brief		c ? a : b for c = 0 or 1, by masking the bits, for the same reason
+*/
+static float32_t select_f32(uint32_t c, float32_t a, float32_t b)
+{
+	SVM_f32_bits_t va, vb;
+	int32_t mask = -(int32_t)c;
+	va.f = a;
+	vb.f = b;
+	va.i = (va.i & mask) | (vb.i & ~mask);
+	return va.f;
 }
 
 /*!
@@ -65,89 +90,6 @@ static int16_t determine_sector_6N(float32_t tabc[3])
 	return sector;
 }
 
-/*!
-* 
-* @brief		identify 12 sectors of SVM modulation
-*                   0° to  30° Sector 0
-*				   30° to  60° Sector 1
-*				   60° to	90° Sector 2
-*                  90° to 120° Sector 3
-*				  120° to 150° Sector 4
-*				  150° to 180° Sector 5
-*                 180° to 210° Sector 6
-*                 210° to 240° Sector 7
-*                 240° to 270° Sector 8
-*	              270° to 300° Sector 9
-*                 300° to 330° Sector 10
-*                 330° to 360° Sector 11
-*/
-static int16_t determine_sector_12N(float32_t tabc[3])
-{
-    int16_t sector;
-    float32_t ta = tabc[0];
-    float32_t tb = tabc[1];
-    float32_t tc = tabc[2];
-
-	if (ta > 0) {
-		if (tc > 0) {
-			if (ta < tc) {
-				sector = 0;
-			}
-			else {
-				sector = 1;
-			}
-		}
-		else {
-			if (tb < 0) {
-				if (tb < tc) {
-					sector = 2;
-				}
-				else {
-					sector = 3;
-				}
-			}
-			else {
-				if (tb < ta) {
-					sector = 4;
-				}
-				else {
-					sector = 5;
-				}
-			}
-		}
-	}
-    else { // ta < 0
-		if (tc < 0) {
-			if (tc < ta) {
-				sector = 6;
-			}
-			else {
-				sector = 7;
-			}
-		}
-		else {
-			if (tb > 0) {
-				if (tb > tc) {
-					sector = 8;
-				}
-				else {
-					sector = 9;
-				}
-			}
-			else {
-				if (ta < tb) {
-					sector = 10;
-				}
-				else {
-					sector = 11;
-				}
-			}
-		}
-	}
-
-	return sector;
-}
-
 /*!
 *
 * @brief		calculate duty cycle for SVM modulation
@@ -157,141 +99,134 @@ static int16_t determine_sector_12N(float32_t tabc[3])
 */
 static void calc_svm_duty(SVM_t* svm, float32_t tabc[3], SVM_mode_t mode)
 {
-	float32_t ta = tabc[0];
-	float32_t tb = tabc[1];
-	float32_t tc = tabc[2];
+	float32_t d1, d2;
+	float32_t V0min, V0max;
 
-	float32_t d1 = 0, d2 = 0;
+	svm_active_durations(svm->sector, tabc, &d1, &d2);
 
-	switch (svm->sector)
+	// overmodulation: d1 + d2 > 1 is outside the hexagon
+	float32_t d12 = d1 + d2;
+	uint8_t ovm = SVM_OVM_SEL(mode);
+	if (d12 > 1.0f && ovm == 1) // MPE, scaled onto the hexagon side
 	{
-	case 0: case 1: // V0(000) <=> V1(100) <=> V2(110) <=> V7(111)
-		d1 = tc; // V1(100)
-		d2 = ta; // V2(110)
-		break;
-	case 2: case 3: // V0(000) <=> V3(010) <=> V2(110) <=> V7(111)
-		d1 = -tc; // V3(010)
-		d2 = -tb; // V2(110)
-		break;
-	case 4: case 5: // V0(000) <=> V3(010) <=> V4(011) <=> V7(111)
-		d1 = ta; // V3(010)
-		d2 = tb; //  V4(011)
-		break;
-	case 6: case 7: // V0(000) <=> V5(001) <=> V4(011) <=> V7(111)
-		d1 = -ta; // V5(001)
-		d2 = -tc; // V4(011)
-			break;
-	case 8: case 9: // V0(000) <=> V5(001) <=> V6(101) <=> V7(111)
-		d1 = tb; // V5(001)
-		d2 = tc; // V6(101)
-		break;
-	case 10: case 11: // V0(000) <=> V1(100) <=> V6(101) <=> V7(111)
-		d1 = -tb; // V1(100)
-		d2 = -ta; // V6(101)
-		break;
-	default:
-		break;
+		svm_ovm_mpe(&d1, &d2, d12);
+	}
+	else if (d12 > 1.0f && ovm == 2) // MME, projected onto the side, at most to a vertex
+	{
+		svm_ovm_mme(&d1, &d2, d12);
 	}
 
-	float32_t V0min = -1.0f / 2 + d1 / 3.0f + 2.0f * d2 / 3;
-	float32_t V0max = 1.0f / 2 - 2.0f * d1 / 3 - d2 / 3.0f;
+	float32_t v_cm = svm_zero_sequence(d1, d2, &V0min, &V0max);
 
-	float32_t v_cm = (d2 - d1) / 6; //SVPWM by default
-	if (v_cm > V0max)
+	uint32_t row = SVM_ZS_ROW(mode);
+	if (row == DPWM_ADAPTIVE)
 	{
-		v_cm = V0max;
+		row = SVM_ADAPT_ROW(svm->zs_shift);
 	}
-	if (v_cm < V0min)
+	if (svm_zs_sel[row][svm->sector] == 1)
 	{
 		v_cm = V0min;
 	}
-
-    if (mode == DMPWM3)
+	else if (svm_zs_sel[row][svm->sector] == 2)
 	{
-        if (((int16_t)((svm->sector + 1) / 2)) % 2 == 0)	// Sectors 0, 3, 4, 7, 8, 11
-		{
-			v_cm = V0min;
-		}
-        else // Sectors 1, 2, 5, 6, 9, 10
-		{
-			v_cm = V0max;
-		}
+		v_cm = V0max;
 	}
 
-	float32_t ma, mb, mc;
-	switch (svm->sector)
-	{
-	case 0: case 1: // V0(000) <=> V1(100) <=> V2(110) <=> V7(111)
-		mc = 1.0f / 2 + v_cm - d1 / 3.0f - 2.0f * d2 / 3;
-		mb = mc + d2;
-		ma = mb + d1;
-		break;
-	case 2: case 3: // V0(000) <=> V3(010) <=> V2(110) <=> V7(111)
-		mc = 1.0f / 2 + v_cm - d1 / 3.0f - 2.0f * d2 / 3;
-		ma = mc + d2;
-		mb = ma + d1;
-		break;
-	case 4: case 5: // V0(000) <=> V3(010) <=> V4(011) <=> V7(111)
-		ma = 1.0f / 2 + v_cm - d1 / 3.0f - 2.0f * d2 / 3;
-		mc = ma + d2;
-		mb = mc + d1;
-		break;
-	case 6: case 7: // V0(000) <=> V5(001) <=> V4(011) <=> V7(111)
-		ma = 1.0f / 2 + v_cm - d1 / 3.0f - 2.0f * d2 / 3;
-		mb = ma + d2;
-		mc = mb + d1;
-		break;
-	case 8: case 9: // V0(000) <=> V5(001) <=> V6(101) <=> V7(111)
-		mb = 1.0f / 2 + v_cm - d1 / 3.0f - 2.0f * d2 / 3;
-		ma = mb + d2;
-		mc = ma + d1;
-		break;
-	case 10: case 11: // V0(000) <=> V1(100) <=> V6(101) <=> V7(111)
-		mb = 1.0f / 2 + v_cm - d1 / 3.0f - 2.0f * d2 / 3;
-		mc = mb + d2;
-		ma = mc + d1;
-		break;
-	default:
-		ma = 0;
-		mb = 0;
-		mc = 0;
-		break;
-	}
+	svm_phase_duties(svm, v_cm, d1, d2);
+}
+
+/*!
+*
+* @brief		SVM modulation
+* @param[in]	svm: SVM_t structure
+* @param[in]	Ualpha: alpha
+* @param[in]	Ubeta: beta
+* @param[in]	mode: SVM mode
+* @param[out]	svm->UAB: array of alpha, beta
+* @param[out]	svm->sector: sector
+* @param[out]	svm->m: array of duty cycle for phase A, B, C
+*/
+void modulator(SVM_t * svm, const float32_t Ualpha, const float32_t Ubeta, SVM_mode_t mode)
+{
+	MC_INSTR_BEGIN(MC_INSTR_MODULATOR);
+
+	svm->UAB[0] = Ualpha;
+	svm->UAB[1] = Ubeta;
+
+	float32_t tabc[3] = {0}; // Initialize tabc array to zero
+
+	calc_tabc(tabc, svm->UAB);
+	
+	//svm->sector = determine_sector_6N(tabc);
+	svm->sector = determine_sector_12N(tabc);
+
+	calc_svm_duty(svm, tabc, mode);
+
+	MC_INSTR_END(MC_INSTR_MODULATOR);
+}
+
+/*!
+*
+* @brief		DPWM_ADAPTIVE rule from the load angle
+* @param[in]	svm: SVM_t structure
+* @param[in]	phi: current lag behind the voltage, rad
+* @param[out]	svm->zs_shift: -1 DPWM0, 0 DPWM1, +1 DPWM2
+*/
+void svm_set_load_angle(SVM_t* svm, float32_t phi)
+{
+	// +-15 degrees, moved away from the current choice by the hysteresis
+	float32_t up = 0.5f * PI_SIXTH + ((svm->zs_shift > 0) ? -SVM_ADAPT_HYST : SVM_ADAPT_HYST);
+	float32_t dn = -0.5f * PI_SIXTH - ((svm->zs_shift < 0) ? -SVM_ADAPT_HYST : SVM_ADAPT_HYST);
 
-	if (ma < 0)
+	if (phi > up)
 	{
-		ma = 0;
+		svm->zs_shift = 1;
 	}
-	if (mb < 0)
+	else if (phi < dn)
 	{
-		mb = 0;
+		svm->zs_shift = -1;
 	}
-	if (mc < 0)
+	else
 	{
-		mc = 0;
+		svm->zs_shift = 0;
 	}
+}
+
+/*!
+*
+* @brief		DPWM_ADAPTIVE rule from the voltage and current vectors
+* @param[in]	svm: SVM_t structure
+* @param[in]	vx, vy: voltage vector
+* @param[in]	ix, iy: current vector, same frame
+* @param[out]	svm->zs_shift: -1 DPWM0, 0 DPWM1, +1 DPWM2
+*/
+void svm_set_load_vectors(SVM_t* svm, float32_t vx, float32_t vy, float32_t ix, float32_t iy)
+{
+	float32_t s = vy * ix - vx * iy;	// |v||i| sin(phi), phi the current lag
+	float32_t c = vx * ix + vy * iy;	// |v||i| cos(phi)
+
+	// tan() of the thresholds of svm_set_load_angle(), 15 degrees -+ the hysteresis
+	float32_t t_up = (svm->zs_shift > 0) ? SVM_ADAPT_TAN_IN : SVM_ADAPT_TAN_OUT;
+	float32_t t_dn = (svm->zs_shift < 0) ? SVM_ADAPT_TAN_IN : SVM_ADAPT_TAN_OUT;
 
-	if (ma > 1)
+	// past a threshold below 90 degrees: beyond it on the same side, or further
+	if (s > 0 && (c <= 0 || s > t_up * c))
 	{
-		ma = 1;
+		svm->zs_shift = 1;
 	}
-	if (mb > 1)
+	else if (s < 0 && (c <= 0 || -s > t_dn * c))
 	{
-		mb = 1;
+		svm->zs_shift = -1;
 	}
-	if (mc > 1)
+	else
 	{
-		mc = 1;
+		svm->zs_shift = 0;
 	}
-
-	svm->m[0] = ma;
-	svm->m[1] = mb;
-	svm->m[2] = mc;
 }
 
 /*!
 *
-* @brief		SVM modulation
+* @brief		Table-driven SVM modulation
 * @param[in]	svm: SVM_t structure
 * @param[in]	Ualpha: alpha
 * @param[in]	Ubeta: beta
@@ -300,17 +235,77 @@ static void calc_svm_duty(SVM_t* svm, float32_t tabc[3], SVM_mode_t mode)
 * @param[out]	svm->sector: sector
 * @param[out]	svm->m: array of duty cycle for phase A, B, C
 */
-void modulator(SVM_t * svm, const float32_t Ualpha, const float32_t Ubeta, SVM_mode_t mode)
+void modulator_lut(SVM_t* svm, const float32_t Ualpha, const float32_t Ubeta, SVM_mode_t mode)
 {
+	float32_t tabc[3];
+	float32_t d1_sel[3], d2_sel[3];
+	float32_t v_cm_sel[3];
+	float32_t m[3];
+
 	svm->UAB[0] = Ualpha;
 	svm->UAB[1] = Ubeta;
 
-	float32_t tabc[3] = {0}; // Initialize tabc array to zero
-
 	calc_tabc(tabc, svm->UAB);
-	
-	//svm->sector = determine_sector_6N(tabc);
-	svm->sector = determine_sector_12N(tabc);
 
-	calc_svm_duty(svm, tabc, mode);
-}
\ No newline at end of file
+	// sector, same result as determine_sector_12N()
+	int16_t pair = svm_pair_lut[9 * SIGN(tabc[0]) + 3 * SIGN(tabc[1]) + SIGN(tabc[2]) + 13];
+	const SVM_pair_t* p = &svm_pair_tab[pair];
+	int16_t sector = 2 * pair + !(tabc[p->cmp_lo] < tabc[p->cmp_hi]);
+
+	float32_t d1 = p->d1_sgn * tabc[p->d1_idx];
+	float32_t d2 = p->d2_sgn * tabc[p->d2_idx];
+
+	// overmodulation, all candidates computed as in calc_svm_duty() and selected
+	float32_t d12 = d1 + d2;
+	uint32_t outside = (uint32_t)(d12 > 1.0f);
+	float32_t k = 1.0f / select_f32(outside, d12, 1.0f);
+	float32_t d1_mme = d1 - (d12 - 1.0f) * 0.5f;
+	d1_mme = select_f32((uint32_t)(d1_mme < 0), 0, d1_mme);
+	d1_mme = select_f32((uint32_t)(1.0f < d1_mme), 1.0f, d1_mme);
+	d1_sel[0] = d1;
+	d1_sel[1] = d1 * k;
+	d1_sel[2] = d1_mme;
+	d2_sel[0] = d2;
+	d2_sel[1] = d2 * k;
+	d2_sel[2] = 1.0f - d1_mme;
+	uint32_t ovm = SVM_OVM_SEL(mode) & (0u - outside);
+	d1 = d1_sel[ovm];
+	d2 = d2_sel[ovm];
+
+	float32_t V0min = -1.0f / 2 + d1 / 3.0f + 2.0f * d2 / 3;
+	float32_t V0max = 1.0f / 2 - 2.0f * d1 / 3 - d2 / 3.0f;
+
+	float32_t v_cm = (d2 - d1) / 6; //SVPWM by default
+	v_cm = (v_cm > V0max) ? V0max : v_cm;
+	v_cm = (v_cm < V0min) ? V0min : v_cm;
+
+	// unknown modes fall back to SVPWM like calc_svm_duty()
+	uint32_t row = SVM_ZS_ROW(mode);
+	uint32_t adapt = 0u - (uint32_t)(row == DPWM_ADAPTIVE);
+	row = (row & ~adapt) | (SVM_ADAPT_ROW(svm->zs_shift) & adapt);
+	v_cm_sel[0] = v_cm;
+	v_cm_sel[1] = V0min;
+	v_cm_sel[2] = V0max;
+	v_cm = v_cm_sel[svm_zs_sel[row][sector]];
+
+	float32_t m_lo = 1.0f / 2 + v_cm - d1 / 3.0f - 2.0f * d2 / 3;
+	float32_t m_mid = m_lo + d2;
+	float32_t m_hi = m_mid + d1;
+
+	// limit to [0, 1] as calc_svm_duty() does, without compares
+	m_lo = clip_negative(m_lo);
+	m_mid = clip_negative(m_mid);
+	m_hi = clip_negative(m_hi);
+	m_lo = (1.0f < m_lo) ? 1.0f : m_lo;
+	m_mid = (1.0f < m_mid) ? 1.0f : m_mid;
+	m_hi = (1.0f < m_hi) ? 1.0f : m_hi;
+
+	m[p->phase[0]] = m_lo;
+	m[p->phase[1]] = m_mid;
+	m[p->phase[2]] = m_hi;
+
+	svm->m[0] = m[0];
+	svm->m[1] = m[1];
+	svm->m[2] = m[2];
+	svm->sector = sector;
+}
@@ -0,0 +1,347 @@
+/**
+ * @file        svm_batch.c
+ * @date        Oct 2026
+ *
+ * @brief       batched SVM modulation over structure-of-arrays input
+ *
+ *      AVX-512 (16 lanes), AVX2 (8 lanes) and SSE4.1 (4 lanes) kernels, picked once
+ *      at run time from the CPU features; the scalar path covers other targets and
+ *      the loop tails.
+ */
+
+#include "svm.h"
+#include "svm_tables.h"
+#include "ctrl_common.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #define SVM_BATCH_X86           1
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define SVM_TARGET(isa)         __attribute__((target(isa)))
+#else
+    #define SVM_TARGET(isa)
+#endif
+
+typedef uint32_t (*SVM_batch_fn_t)(const float32_t* Ualpha, const float32_t* Ubeta, uint32_t count,
+                                   uint32_t sel_min, uint32_t sel_max, uint32_t ovm,
+                                   float32_t* ma, float32_t* mb, float32_t* mc, int16_t* sector);
+
+#if defined(SVM_BATCH_X86)
+
+//*****************************************************************************
+//
+// SSE4.1, 4 lanes
+//
+//*****************************************************************************
+#define SVM_BATCH_FN                modulator_batch_sse41
+#define SVM_BATCH_TARGET            SVM_TARGET("sse4.1")
+#define SVM_W                       4
+#define V_F                         __m128
+#define V_I                         __m128i
+#define V_SET1(x)                   _mm_set1_ps(x)
+#define V_SET1I(x)                  _mm_set1_epi32(x)
+#define V_LOADU(p)                  _mm_loadu_ps(p)
+#define V_STOREU(p, v)              _mm_storeu_ps(p, v)
+#define V_ADD(a, b)                 _mm_add_ps(a, b)
+#define V_SUB(a, b)                 _mm_sub_ps(a, b)
+#define V_MUL(a, b)                 _mm_mul_ps(a, b)
+#define V_DIV(a, b)                 _mm_div_ps(a, b)
+#define V_MIN(a, b)                 _mm_min_ps(a, b)
+#define V_MAX(a, b)                 _mm_max_ps(a, b)
+#define V_AND(a, b)                 _mm_and_ps(a, b)
+#define V_ANDNOT(a, b)              _mm_andnot_ps(a, b)
+#define V_OR(a, b)                  _mm_or_ps(a, b)
+#define V_XOR(a, b)                 _mm_xor_ps(a, b)
+#define V_LT(a, b)                  _mm_cmplt_ps(a, b)
+#define V_GT(a, b)                  _mm_cmpgt_ps(a, b)
+#define V_EQ(a, b)                  _mm_cmpeq_ps(a, b)
+#define V_BLEND(a, b, m)            _mm_blendv_ps(a, b, m)
+#define V_CASTF(x)                  _mm_castsi128_ps(x)
+#define V_CASTI(x)                  _mm_castps_si128(x)
+#define V_CVTT(x)                   _mm_cvttps_epi32(x)
+#define V_ADDI(a, b)                _mm_add_epi32(a, b)
+#define V_ANDI(a, b)                _mm_and_si128(a, b)
+#define V_SLLI(a, n)                _mm_slli_epi32(a, n)
+#define V_SRAI(a, n)                _mm_srai_epi32(a, n)
+#define V_NOT_ZEROI(a)              _mm_xor_si128(_mm_cmpeq_epi32(a, _mm_setzero_si128()), _mm_set1_epi32(-1))
+#define V_STORE_SECTOR(p, v)        _mm_storel_epi64((__m128i*)(p), _mm_packs_epi32(v, v))
+
+#include "svm_batch_simd.h"
+
+#undef SVM_BATCH_FN
+#undef SVM_BATCH_TARGET
+#undef SVM_W
+#undef V_F
+#undef V_I
+#undef V_SET1
+#undef V_SET1I
+#undef V_LOADU
+#undef V_STOREU
+#undef V_ADD
+#undef V_SUB
+#undef V_MUL
+#undef V_DIV
+#undef V_MIN
+#undef V_MAX
+#undef V_AND
+#undef V_ANDNOT
+#undef V_OR
+#undef V_XOR
+#undef V_LT
+#undef V_GT
+#undef V_EQ
+#undef V_BLEND
+#undef V_CASTF
+#undef V_CASTI
+#undef V_CVTT
+#undef V_ADDI
+#undef V_ANDI
+#undef V_SLLI
+#undef V_SRAI
+#undef V_NOT_ZEROI
+#undef V_STORE_SECTOR
+
+//*****************************************************************************
+//
+// AVX2, 8 lanes
+//
+//*****************************************************************************
+#define SVM_BATCH_FN                modulator_batch_avx2
+#define SVM_BATCH_TARGET            SVM_TARGET("avx2")
+#define SVM_W                       8
+#define V_F                         __m256
+#define V_I                         __m256i
+#define V_SET1(x)                   _mm256_set1_ps(x)
+#define V_SET1I(x)                  _mm256_set1_epi32(x)
+#define V_LOADU(p)                  _mm256_loadu_ps(p)
+#define V_STOREU(p, v)              _mm256_storeu_ps(p, v)
+#define V_ADD(a, b)                 _mm256_add_ps(a, b)
+#define V_SUB(a, b)                 _mm256_sub_ps(a, b)
+#define V_MUL(a, b)                 _mm256_mul_ps(a, b)
+#define V_DIV(a, b)                 _mm256_div_ps(a, b)
+#define V_MIN(a, b)                 _mm256_min_ps(a, b)
+#define V_MAX(a, b)                 _mm256_max_ps(a, b)
+#define V_AND(a, b)                 _mm256_and_ps(a, b)
+#define V_ANDNOT(a, b)              _mm256_andnot_ps(a, b)
+#define V_OR(a, b)                  _mm256_or_ps(a, b)
+#define V_XOR(a, b)                 _mm256_xor_ps(a, b)
+#define V_LT(a, b)                  _mm256_cmp_ps(a, b, _CMP_LT_OQ)
+#define V_GT(a, b)                  _mm256_cmp_ps(a, b, _CMP_GT_OQ)
+#define V_EQ(a, b)                  _mm256_cmp_ps(a, b, _CMP_EQ_OQ)
+#define V_BLEND(a, b, m)            _mm256_blendv_ps(a, b, m)
+#define V_CASTF(x)                  _mm256_castsi256_ps(x)
+#define V_CASTI(x)                  _mm256_castps_si256(x)
+#define V_CVTT(x)                   _mm256_cvttps_epi32(x)
+#define V_ADDI(a, b)                _mm256_add_epi32(a, b)
+#define V_ANDI(a, b)                _mm256_and_si256(a, b)
+#define V_SLLI(a, n)                _mm256_slli_epi32(a, n)
+#define V_SRAI(a, n)                _mm256_srai_epi32(a, n)
+#define V_NOT_ZEROI(a)              _mm256_xor_si256(_mm256_cmpeq_epi32(a, _mm256_setzero_si256()), _mm256_set1_epi32(-1))
+#define V_STORE_SECTOR(p, v)        _mm_storeu_si128((__m128i*)(p), \
+                                        _mm_packs_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1)))
+
+#include "svm_batch_simd.h"
+
+#undef SVM_BATCH_FN
+#undef SVM_BATCH_TARGET
+#undef SVM_W
+#undef V_F
+#undef V_I
+#undef V_SET1
+#undef V_SET1I
+#undef V_LOADU
+#undef V_STOREU
+#undef V_ADD
+#undef V_SUB
+#undef V_MUL
+#undef V_DIV
+#undef V_MIN
+#undef V_MAX
+#undef V_AND
+#undef V_ANDNOT
+#undef V_OR
+#undef V_XOR
+#undef V_LT
+#undef V_GT
+#undef V_EQ
+#undef V_BLEND
+#undef V_CASTF
+#undef V_CASTI
+#undef V_CVTT
+#undef V_ADDI
+#undef V_ANDI
+#undef V_SLLI
+#undef V_SRAI
+#undef V_NOT_ZEROI
+#undef V_STORE_SECTOR
+
+//*****************************************************************************
+//
+// AVX-512, 16 lanes; compares give mask registers, expanded to lane masks so
+// that the body stays the same (vpmovm2d/vpmovd2m, AVX512DQ)
+//
+//*****************************************************************************
+#define SVM_BATCH_FN                modulator_batch_avx512
+#define SVM_BATCH_TARGET            SVM_TARGET("avx512f,avx512dq")
+#define SVM_W                       16
+#define V_F                         __m512
+#define V_I                         __m512i
+#define V_SET1(x)                   _mm512_set1_ps(x)
+#define V_SET1I(x)                  _mm512_set1_epi32(x)
+#define V_LOADU(p)                  _mm512_loadu_ps(p)
+#define V_STOREU(p, v)              _mm512_storeu_ps(p, v)
+#define V_ADD(a, b)                 _mm512_add_ps(a, b)
+#define V_SUB(a, b)                 _mm512_sub_ps(a, b)
+#define V_MUL(a, b)                 _mm512_mul_ps(a, b)
+#define V_DIV(a, b)                 _mm512_div_ps(a, b)
+#define V_MIN(a, b)                 _mm512_min_ps(a, b)
+#define V_MAX(a, b)                 _mm512_max_ps(a, b)
+#define V_AND(a, b)                 _mm512_and_ps(a, b)
+#define V_ANDNOT(a, b)              _mm512_andnot_ps(a, b)
+#define V_OR(a, b)                  _mm512_or_ps(a, b)
+#define V_XOR(a, b)                 _mm512_xor_ps(a, b)
+#define V_MASK(k)                   _mm512_castsi512_ps(_mm512_movm_epi32(k))
+#define V_LT(a, b)                  V_MASK(_mm512_cmp_ps_mask(a, b, _CMP_LT_OQ))
+#define V_GT(a, b)                  V_MASK(_mm512_cmp_ps_mask(a, b, _CMP_GT_OQ))
+#define V_EQ(a, b)                  V_MASK(_mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ))
+#define V_BLEND(a, b, m)            _mm512_mask_blend_ps(_mm512_movepi32_mask(_mm512_castps_si512(m)), a, b)
+#define V_CASTF(x)                  _mm512_castsi512_ps(x)
+#define V_CASTI(x)                  _mm512_castps_si512(x)
+#define V_CVTT(x)                   _mm512_cvttps_epi32(x)
+#define V_ADDI(a, b)                _mm512_add_epi32(a, b)
+#define V_ANDI(a, b)                _mm512_and_si512(a, b)
+#define V_SLLI(a, n)                _mm512_slli_epi32(a, n)
+#define V_SRAI(a, n)                _mm512_srai_epi32(a, n)
+#define V_NOT_ZEROI(a)              _mm512_movm_epi32(_mm512_test_epi32_mask(a, a))
+#define V_STORE_SECTOR(p, v)        _mm256_storeu_si256((__m256i*)(p), _mm512_cvtsepi32_epi16(v))
+
+#include "svm_batch_simd.h"
+
+#endif // SVM_BATCH_X86
+
+//*****************************************************************************
+//
+// dispatch
+//
+//*****************************************************************************
+static SVM_batch_fn_t svm_batch_fn = 0;     // NULL: scalar only
+static const char* svm_batch_name = 0;
+
+static void modulator_batch_select(void)
+{
+    SVM_batch_fn_t fn = 0;
+    const char* name = "scalar";
+
+#if defined(SVM_BATCH_X86)
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    int has_sse41 = __builtin_cpu_supports("sse4.1");
+    int has_avx2 = __builtin_cpu_supports("avx2");
+    int has_avx512 = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq");
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    int has_sse41 = (info[2] >> 19) & 1;
+    int has_osxsave = (info[2] >> 27) & 1;
+    __cpuidex(info, 7, 0);
+    int has_avx2 = has_osxsave && ((info[1] >> 5) & 1) && ((_xgetbv(0) & 6) == 6);
+    int has_avx512 = has_avx2 && ((info[1] >> 16) & 1) && ((info[1] >> 17) & 1) && ((_xgetbv(0) & 0xE6) == 0xE6);
+#else
+    int has_sse41 = 0;
+    int has_avx2 = 0;
+    int has_avx512 = 0;
+#endif
+    if (has_avx512)
+    {
+        fn = modulator_batch_avx512;
+        name = "avx512";
+    }
+    else if (has_avx2)
+    {
+        fn = modulator_batch_avx2;
+        name = "avx2";
+    }
+    else if (has_sse41)
+    {
+        fn = modulator_batch_sse41;
+        name = "sse4.1";
+    }
+#endif
+
+    svm_batch_fn = fn;
+    svm_batch_name = name;
+}
+
+/** \copydoc modulator_batch */
+void modulator_batch(const float32_t* Ualpha, const float32_t* Ubeta, uint32_t count, SVM_mode_t mode,
+                     float32_t* ma, float32_t* mb, float32_t* mc, int16_t* sector)
+{
+    uint32_t sel_min = 0, sel_max = 0;
+    uint32_t row = SVM_ZS_ROW(mode);
+    uint32_t i = 0;
+
+    if (svm_batch_name == 0)
+    {
+        modulator_batch_select();
+    }
+
+    // per-mode zero-sequence choice as sector bit masks
+    for (i = 0; i < 12; i++)
+    {
+        sel_min |= (uint32_t)(svm_zs_sel[row][i] == 1) << i;
+        sel_max |= (uint32_t)(svm_zs_sel[row][i] == 2) << i;
+    }
+
+    i = 0;
+    if (svm_batch_fn != 0)
+    {
+        i = svm_batch_fn(Ualpha, Ubeta, count, sel_min, sel_max, SVM_OVM_SEL(mode), ma, mb, mc, sector);
+    }
+
+    modulator_batch_scalar(Ualpha + i, Ubeta + i, count - i, mode, ma + i, mb + i, mc + i, sector + i);
+}
+
+/** \copydoc modulator_batch_scalar */
+void modulator_batch_scalar(const float32_t* Ualpha, const float32_t* Ubeta, uint32_t count, SVM_mode_t mode,
+                            float32_t* ma, float32_t* mb, float32_t* mc, int16_t* sector)
+{
+    SVM_t svm;
+    uint32_t i;
+
+    svm.zs_shift = 0;   // DPWM_ADAPTIVE as DPWM1, as the vector kernels
+
+    for (i = 0; i < count; i++)
+    {
+        modulator_lut(&svm, Ualpha[i], Ubeta[i], mode);
+        ma[i] = svm.m[0];
+        mb[i] = svm.m[1];
+        mc[i] = svm.m[2];
+        sector[i] = svm.sector;
+    }
+}
+
+/** \copydoc modulator_batch_init */
+void modulator_batch_init(void)
+{
+    if (svm_batch_name == 0)
+    {
+        modulator_batch_select();
+    }
+}
+
+/** \copydoc modulator_batch_isa */
+const char* modulator_batch_isa(void)
+{
+    if (svm_batch_name == 0)
+    {
+        modulator_batch_select();
+    }
+    return svm_batch_name;
+}
+
+// EOF svm_batch.c
@@ -0,0 +1,137 @@
+/**
+ * @file        svm_batch_simd.h
+ *
+ * @brief      vector body of modulator_batch() (private to svm_batch.c)
+ *
+ *      Included once per instruction set by svm_batch.c after defining
+ *      SVM_BATCH_FN, SVM_BATCH_TARGET, the lane count SVM_W and the V_* operation
+ *      macros. Each lane repeats the arithmetic of modulator_lut() operation for
+ *      operation (no FMA contraction: the SSE4.1 and AVX2 targets do not enable FMA,
+ *      and the library builds with -ffp-contract=off for AVX-512, which implies it),
+ *      so the batch results are bit-identical to modulator().
+ *
+ *      V_BLEND(a, b, m) returns b where m is set, a elsewhere.
+ */
+
+SVM_BATCH_TARGET
+static uint32_t SVM_BATCH_FN(const float32_t* Ualpha, const float32_t* Ubeta, uint32_t count,
+                             uint32_t sel_min, uint32_t sel_max, uint32_t ovm,
+                             float32_t* ma, float32_t* mb, float32_t* mc, int16_t* sector)
+{
+    const V_F zero = V_SET1(0.0f);
+    const V_F one = V_SET1(1.0f);
+    const V_F two = V_SET1(2.0f);
+    const V_F three = V_SET1(3.0f);
+    const V_F six = V_SET1(6.0f);
+    const V_F sign = V_SET1(-0.0f);
+    const V_I sel_min_bits = V_SET1I((int32_t)sel_min);
+    const V_I sel_max_bits = V_SET1I((int32_t)sel_max);
+    uint32_t i;
+
+    for (i = 0; i + SVM_W <= count; i += SVM_W)
+    {
+        V_F ua = V_LOADU(Ualpha + i);
+        V_F ub = V_LOADU(Ubeta + i);
+
+        // calc_tabc()
+        V_F ta = ub;
+        V_F tb = V_DIV(V_SUB(V_MUL(V_SET1(-SQRT3), ua), ub), two);
+        V_F tc = V_DIV(V_SUB(V_MUL(V_SET1(SQRT3), ua), ub), two);
+
+        // sector pair, the first level of determine_sector_12N()
+        V_F p_pos = V_BLEND(V_BLEND(V_SET1(2.0f), V_SET1(1.0f), V_LT(tb, zero)), zero, V_GT(tc, zero));
+        V_F p_neg = V_BLEND(V_BLEND(V_SET1(5.0f), V_SET1(4.0f), V_GT(tb, zero)), V_SET1(3.0f), V_LT(tc, zero));
+        V_F pair = V_BLEND(p_neg, p_pos, V_GT(ta, zero));
+
+        V_F m0 = V_EQ(pair, zero);
+        V_F m1 = V_EQ(pair, one);
+        V_F m2 = V_EQ(pair, two);
+        V_F m3 = V_EQ(pair, three);
+        V_F m4 = V_EQ(pair, V_SET1(4.0f));
+        V_F m5 = V_EQ(pair, V_SET1(5.0f));
+
+        // 30 degree split inside the pair
+        V_F lower = V_AND(m0, V_LT(ta, tc));
+        lower = V_OR(lower, V_AND(m1, V_LT(tb, tc)));
+        lower = V_OR(lower, V_AND(m2, V_LT(tb, ta)));
+        lower = V_OR(lower, V_AND(m3, V_LT(tc, ta)));
+        lower = V_OR(lower, V_AND(m4, V_LT(tc, tb)));
+        lower = V_OR(lower, V_AND(m5, V_LT(ta, tb)));
+        V_F sec = V_ADD(V_ADD(pair, pair), V_ANDNOT(lower, one));
+
+        // active vectors
+        V_F d1 = tc;
+        d1 = V_BLEND(d1, V_XOR(tc, sign), m1);
+        d1 = V_BLEND(d1, ta, m2);
+        d1 = V_BLEND(d1, V_XOR(ta, sign), m3);
+        d1 = V_BLEND(d1, tb, m4);
+        d1 = V_BLEND(d1, V_XOR(tb, sign), m5);
+
+        V_F d2 = ta;
+        d2 = V_BLEND(d2, V_XOR(tb, sign), m1);
+        d2 = V_BLEND(d2, tb, m2);
+        d2 = V_BLEND(d2, V_XOR(tc, sign), m3);
+        d2 = V_BLEND(d2, tc, m4);
+        d2 = V_BLEND(d2, V_XOR(ta, sign), m5);
+
+        // overmodulation, the candidate of the batch where d1 + d2 > 1
+        if (ovm != 0)
+        {
+            V_F d12 = V_ADD(d1, d2);
+            V_F over = V_GT(d12, one);
+            V_F d1_o, d2_o;
+            if (ovm == 1)
+            {
+                V_F k = V_DIV(one, V_BLEND(one, d12, over));
+                d1_o = V_MUL(d1, k);
+                d2_o = V_MUL(d2, k);
+            }
+            else
+            {
+                d1_o = V_SUB(d1, V_MUL(V_SUB(d12, one), V_SET1(0.5f)));
+                d1_o = V_MIN(one, V_MAX(zero, d1_o));
+                d2_o = V_SUB(one, d1_o);
+            }
+            d1 = V_BLEND(d1, d1_o, over);
+            d2 = V_BLEND(d2, d2_o, over);
+        }
+
+        V_F d1_3 = V_DIV(d1, three);
+        V_F d2x2_3 = V_DIV(V_MUL(two, d2), three);
+
+        V_F V0min = V_ADD(V_ADD(V_SET1(-0.5f), d1_3), d2x2_3);
+        V_F V0max = V_SUB(V_SUB(V_SET1(0.5f), V_DIV(V_MUL(two, d1), three)), V_DIV(d2, three));
+
+        V_F v_cm = V_DIV(V_SUB(d2, d1), six);
+        v_cm = V_MIN(V0max, v_cm);
+        v_cm = V_MAX(V0min, v_cm);
+
+        // zero-sequence selection: bit 'sector' of the per-mode masks, with
+        // 1 << sector built from the float exponent (no variable shift in SSE)
+        V_I sec_i = V_CVTT(sec);
+        V_I bit = V_CVTT(V_CASTF(V_ADDI(V_SLLI(sec_i, 23), V_SET1I(127 << 23))));
+        v_cm = V_BLEND(v_cm, V0min, V_CASTF(V_NOT_ZEROI(V_ANDI(bit, sel_min_bits))));
+        v_cm = V_BLEND(v_cm, V0max, V_CASTF(V_NOT_ZEROI(V_ANDI(bit, sel_max_bits))));
+
+        V_F m_lo = V_SUB(V_SUB(V_ADD(V_SET1(0.5f), v_cm), d1_3), d2x2_3);
+        V_F m_mid = V_ADD(m_lo, d2);
+        V_F m_hi = V_ADD(m_mid, d1);
+
+        // [0, 1] limits, the lower one clears lanes with the sign bit set
+        m_lo = V_MIN(one, V_ANDNOT(V_CASTF(V_SRAI(V_CASTI(m_lo), 31)), m_lo));
+        m_mid = V_MIN(one, V_ANDNOT(V_CASTF(V_SRAI(V_CASTI(m_mid), 31)), m_mid));
+        m_hi = V_MIN(one, V_ANDNOT(V_CASTF(V_SRAI(V_CASTI(m_hi), 31)), m_hi));
+
+        // phase ordering of svm_pair_tab[].phase
+        V_F a = V_BLEND(V_BLEND(m_lo, m_hi, V_OR(m0, m5)), m_mid, V_OR(m1, m4));
+        V_F b = V_BLEND(V_BLEND(m_lo, m_mid, V_OR(m0, m3)), m_hi, V_OR(m1, m2));
+        V_F c = V_BLEND(V_BLEND(m_hi, m_lo, V_OR(m0, m1)), m_mid, V_OR(m2, m5));
+
+        V_STOREU(ma + i, a);
+        V_STOREU(mb + i, b);
+        V_STOREU(mc + i, c);
+        V_STORE_SECTOR(sector + i, sec_i);
+    }
+
+    return i;
+}
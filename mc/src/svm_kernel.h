@@ -0,0 +1,284 @@
+/**
+ * @file        svm_kernel.h
+ * @date        Oct 2026
+ *
+ * @brief      steps of the float SVM modulator (private to src/)
+ *
+ *      The parts of modulator() that do not depend on the mode. modulator() in
+ *      svm.c chains them with the rules of a run-time mode, the specializations
+ *      in svm_spec.cpp with the rules of a compile-time one; both give the same
+ *      results because they run the same steps.
+ */
+#ifndef SVM_KERNEL_H_
+    #define SVM_KERNEL_H_
+
+#include "commontypes.h"
+#include "ctrl_common.h"
+#include "svm.h"
+
+MC_INLINE void calc_tabc(float32_t tabc[3], const float32_t UAB[2])
+{
+	float32_t Ualpha = UAB[0];
+	float32_t Ubeta = UAB[1];
+
+	tabc[0] = Ubeta;
+	tabc[1] = (-SQRT3 * Ualpha - Ubeta) / 2.0f;
+	tabc[2] = (SQRT3 * Ualpha - Ubeta) / 2.0f;
+}
+
+/*!
+*
+* @brief		identify 12 sectors of SVM modulation
+*                   0° to  30° Sector 0
+*				   30° to  60° Sector 1
+*				   60° to	90° Sector 2
+*                  90° to 120° Sector 3
+*				  120° to 150° Sector 4
+*				  150° to 180° Sector 5
+*                 180° to 210° Sector 6
+*                 210° to 240° Sector 7
+*                 240° to 270° Sector 8
+*	              270° to 300° Sector 9
+*                 300° to 330° Sector 10
+*                 330° to 360° Sector 11
+*/
+MC_INLINE int16_t determine_sector_12N(const float32_t tabc[3])
+{
+    int16_t sector;
+    float32_t ta = tabc[0];
+    float32_t tb = tabc[1];
+    float32_t tc = tabc[2];
+
+	if (ta > 0) {
+		if (tc > 0) {
+			if (ta < tc) {
+				sector = 0;
+			}
+			else {
+				sector = 1;
+			}
+		}
+		else {
+			if (tb < 0) {
+				if (tb < tc) {
+					sector = 2;
+				}
+				else {
+					sector = 3;
+				}
+			}
+			else {
+				if (tb < ta) {
+					sector = 4;
+				}
+				else {
+					sector = 5;
+				}
+			}
+		}
+	}
+    else { // ta < 0
+		if (tc < 0) {
+			if (tc < ta) {
+				sector = 6;
+			}
+			else {
+				sector = 7;
+			}
+		}
+		else {
+			if (tb > 0) {
+				if (tb > tc) {
+					sector = 8;
+				}
+				else {
+					sector = 9;
+				}
+			}
+			else {
+				if (ta < tb) {
+					sector = 10;
+				}
+				else {
+					sector = 11;
+				}
+			}
+		}
+	}
+
+	return sector;
+}
+
+/*!
+*
+* @brief		durations d1, d2 of the two active vectors of a 12N sector
+*/
+MC_INLINE void svm_active_durations(int16_t sector, const float32_t tabc[3], float32_t* d1, float32_t* d2)
+{
+	float32_t ta = tabc[0];
+	float32_t tb = tabc[1];
+	float32_t tc = tabc[2];
+
+	*d1 = 0;
+	*d2 = 0;
+
+	switch (sector)
+	{
+	case 0: case 1: // V0(000) <=> V1(100) <=> V2(110) <=> V7(111)
+		*d1 = tc; // V1(100)
+		*d2 = ta; // V2(110)
+		break;
+	case 2: case 3: // V0(000) <=> V3(010) <=> V2(110) <=> V7(111)
+		*d1 = -tc; // V3(010)
+		*d2 = -tb; // V2(110)
+		break;
+	case 4: case 5: // V0(000) <=> V3(010) <=> V4(011) <=> V7(111)
+		*d1 = ta; // V3(010)
+		*d2 = tb; //  V4(011)
+		break;
+	case 6: case 7: // V0(000) <=> V5(001) <=> V4(011) <=> V7(111)
+		*d1 = -ta; // V5(001)
+		*d2 = -tc; // V4(011)
+			break;
+	case 8: case 9: // V0(000) <=> V5(001) <=> V6(101) <=> V7(111)
+		*d1 = tb; // V5(001)
+		*d2 = tc; // V6(101)
+		break;
+	case 10: case 11: // V0(000) <=> V1(100) <=> V6(101) <=> V7(111)
+		*d1 = -tb; // V1(100)
+		*d2 = -ta; // V6(101)
+		break;
+	default:
+		break;
+	}
+}
+
+/*!
+*
+* @brief		SVM_OVM_MPE for d12 = d1 + d2 > 1: scaled onto the hexagon side
+*/
+MC_INLINE void svm_ovm_mpe(float32_t* d1, float32_t* d2, float32_t d12)
+{
+	float32_t k = 1.0f / d12;
+	*d1 = *d1 * k;
+	*d2 = *d2 * k;
+}
+
+/*!
+*
+* @brief		SVM_OVM_MME for d12 = d1 + d2 > 1: projected onto the side, at most to a vertex
+*/
+MC_INLINE void svm_ovm_mme(float32_t* d1, float32_t* d2, float32_t d12)
+{
+	*d1 = *d1 - (d12 - 1.0f) * 0.5f;
+	if (*d1 < 0)
+	{
+		*d1 = 0;
+	}
+	if (1.0f < *d1)
+	{
+		*d1 = 1.0f;
+	}
+	*d2 = 1.0f - *d1;
+}
+
+/*!
+*
+* @brief		zero-sequence range [V0min, V0max] and the SVPWM offset limited to it
+*/
+MC_INLINE float32_t svm_zero_sequence(float32_t d1, float32_t d2, float32_t* V0min, float32_t* V0max)
+{
+	*V0min = -1.0f / 2 + d1 / 3.0f + 2.0f * d2 / 3;
+	*V0max = 1.0f / 2 - 2.0f * d1 / 3 - d2 / 3.0f;
+
+	float32_t v_cm = (d2 - d1) / 6; //SVPWM by default
+	if (v_cm > *V0max)
+	{
+		v_cm = *V0max;
+	}
+	if (v_cm < *V0min)
+	{
+		v_cm = *V0min;
+	}
+	return v_cm;
+}
+
+/*!
+*
+* @brief		phase duties of svm->sector from the zero sequence, limited to [0, 1]
+* @param[out]	svm->m: array of duty cycle for phase A, B, C
+*/
+MC_INLINE void svm_phase_duties(SVM_t* svm, float32_t v_cm, float32_t d1, float32_t d2)
+{
+	float32_t ma, mb, mc;
+	switch (svm->sector)
+	{
+	case 0: case 1: // V0(000) <=> V1(100) <=> V2(110) <=> V7(111)
+		mc = 1.0f / 2 + v_cm - d1 / 3.0f - 2.0f * d2 / 3;
+		mb = mc + d2;
+		ma = mb + d1;
+		break;
+	case 2: case 3: // V0(000) <=> V3(010) <=> V2(110) <=> V7(111)
+		mc = 1.0f / 2 + v_cm - d1 / 3.0f - 2.0f * d2 / 3;
+		ma = mc + d2;
+		mb = ma + d1;
+		break;
+	case 4: case 5: // V0(000) <=> V3(010) <=> V4(011) <=> V7(111)
+		ma = 1.0f / 2 + v_cm - d1 / 3.0f - 2.0f * d2 / 3;
+		mc = ma + d2;
+		mb = mc + d1;
+		break;
+	case 6: case 7: // V0(000) <=> V5(001) <=> V4(011) <=> V7(111)
+		ma = 1.0f / 2 + v_cm - d1 / 3.0f - 2.0f * d2 / 3;
+		mb = ma + d2;
+		mc = mb + d1;
+		break;
+	case 8: case 9: // V0(000) <=> V5(001) <=> V6(101) <=> V7(111)
+		mb = 1.0f / 2 + v_cm - d1 / 3.0f - 2.0f * d2 / 3;
+		ma = mb + d2;
+		mc = ma + d1;
+		break;
+	case 10: case 11: // V0(000) <=> V1(100) <=> V6(101) <=> V7(111)
+		mb = 1.0f / 2 + v_cm - d1 / 3.0f - 2.0f * d2 / 3;
+		mc = mb + d2;
+		ma = mc + d1;
+		break;
+	default:
+		ma = 0;
+		mb = 0;
+		mc = 0;
+		break;
+	}
+
+	if (ma < 0)
+	{
+		ma = 0;
+	}
+	if (mb < 0)
+	{
+		mb = 0;
+	}
+	if (mc < 0)
+	{
+		mc = 0;
+	}
+
+	if (ma > 1)
+	{
+		ma = 1;
+	}
+	if (mb > 1)
+	{
+		mb = 1;
+	}
+	if (mc > 1)
+	{
+		mc = 1;
+	}
+
+	svm->m[0] = ma;
+	svm->m[1] = mb;
+	svm->m[2] = mc;
+}
+
+#endif //<- !defined SVM_KERNEL_H_
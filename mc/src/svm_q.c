@@ -0,0 +1,102 @@
+
+#include "svm_q.h"
+#include "svm_tables.h"
+#include "ctrl_common.h"
+
+#define Q_HALF			Q_CONST(0.5)
+#define Q_ONE_THIRD		Q_CONST(ONE_THIRD)
+#define Q_TWO_THIRD		Q_CONST(TWO_THIRD)
+#define Q_ONE_SIXTH		Q_CONST(ONE_SIXTH)
+#define Q_SIN60			Q_CONST(SIN60)		// SQRT3/2
+
+/*!
+*
+* @brief		Fixed-point SVM modulation
+* @param[in]	svm: SVMq_t structure
+* @param[in]	Ualpha: alpha
+* @param[in]	Ubeta: beta
+* @param[in]	mode: SVM mode
+* @param[out]	svm->UAB: array of alpha, beta
+* @param[out]	svm->sector: sector
+* @param[out]	svm->m: array of duty cycle for phase A, B, C
+*/
+void modulator_q(SVMq_t* svm, const q_t Ualpha, const q_t Ubeta, SVM_mode_t mode)
+{
+	q_t tabc[3];
+	q_t v_cm_sel[3];
+	q_t m[3];
+
+	svm->UAB[0] = Ualpha;
+	svm->UAB[1] = Ubeta;
+
+	// calc_tabc(), (-+SQRT3 * Ualpha - Ubeta) / 2 with in-range constants
+	q_t ka = q_mul(Q_SIN60, Ualpha);
+	q_t hb = q_mul(Q_HALF, Ubeta);
+	tabc[0] = Ubeta;
+	tabc[1] = q_sat(-(q_acc_t)ka - hb);
+	tabc[2] = q_sat((q_acc_t)ka - hb);
+
+	// sector, same result as determine_sector_12N()
+	int16_t pair = svm_pair_lut[9 * SIGN(tabc[0]) + 3 * SIGN(tabc[1]) + SIGN(tabc[2]) + 13];
+	const SVM_pair_t* p = &svm_pair_tab[pair];
+	int16_t sector = 2 * pair + !(tabc[p->cmp_lo] < tabc[p->cmp_hi]);
+
+	// the odd pairs take both active vectors negated
+	q_t d1 = tabc[p->d1_idx];
+	q_t d2 = tabc[p->d2_idx];
+	if (pair & 1)
+	{
+		d1 = q_neg(d1);
+		d2 = q_neg(d2);
+	}
+
+	// overmodulation, d1 + d2 > 1 (Q_MAX) is outside the hexagon
+	q_acc_t d12 = (q_acc_t)d1 + d2;
+	if (d12 > Q_MAX)
+	{
+		uint8_t ovm = SVM_OVM_SEL(mode);
+		if (ovm == 1)	// MPE
+		{
+			d1 = q_sat(((q_acc_t)d1 << MC_Q_BITS) / d12);
+			d2 = q_sat(((q_acc_t)d2 << MC_Q_BITS) / d12);
+		}
+		else if (ovm == 2)	// MME
+		{
+			q_acc_t d = d1 - ((d12 - Q_MAX) >> 1);
+			d1 = q_sat((d < 0) ? 0 : d);
+			d2 = q_sub(Q_MAX, d1);
+		}
+	}
+
+	q_t d1_3 = q_mul(d1, Q_ONE_THIRD);
+	q_t d2x2_3 = q_mul(d2, Q_TWO_THIRD);
+
+	q_t V0min = q_sat(-(q_acc_t)Q_HALF + d1_3 + d2x2_3);
+	q_t V0max = q_sat((q_acc_t)Q_HALF - q_mul(d1, Q_TWO_THIRD) - q_mul(d2, Q_ONE_THIRD));
+
+	q_t v_cm = q_sub(q_mul(d2, Q_ONE_SIXTH), q_mul(d1, Q_ONE_SIXTH)); //SVPWM by default
+	v_cm = (v_cm > V0max) ? V0max : v_cm;
+	v_cm = (v_cm < V0min) ? V0min : v_cm;
+
+	// unknown modes fall back to SVPWM like calc_svm_duty(), DPWM_ADAPTIVE is DPWM1
+	v_cm_sel[0] = v_cm;
+	v_cm_sel[1] = V0min;
+	v_cm_sel[2] = V0max;
+	v_cm = v_cm_sel[svm_zs_sel[SVM_ZS_ROW(mode)][sector]];
+
+	// the chain stays wide so that only the final duties saturate
+	q_acc_t m_lo = (q_acc_t)Q_HALF + v_cm - d1_3 - d2x2_3;
+	q_acc_t m_mid = m_lo + d2;
+	q_acc_t m_hi = m_mid + d1;
+
+	m[p->phase[0]] = q_sat((m_lo < 0) ? 0 : m_lo);
+	m[p->phase[1]] = q_sat((m_mid < 0) ? 0 : m_mid);
+	m[p->phase[2]] = q_sat((m_hi < 0) ? 0 : m_hi);
+
+	svm->m[0] = m[0];
+	svm->m[1] = m[1];
+	svm->m[2] = m[2];
+	svm->sector = sector;
+}
+
+// EOF svm_q.c
@@ -0,0 +1,97 @@
+/**
+ * @file        svm_spec.cpp
+ * @date        Oct 2026
+ *
+ * @brief       SVM modulator specialized at compile time, see svm.hpp
+ *
+ */
+
+#include "svm.hpp"
+#include "svm_kernel.h"
+#include "svm_tables.h"
+
+namespace mc {
+namespace detail {
+
+/** \copydoc mc::modulator */
+template <SVM_mode_t Mode>
+void modulator_spec(SVM_t* svm, float32_t Ualpha, float32_t Ubeta)
+{
+    constexpr uint32_t row = (uint32_t)Mode & SVM_ZS_MASK;
+    constexpr uint32_t ovm = ((uint32_t)Mode & SVM_OVM_MASK) >> 4;    // 1 MPE, 2 MME, see svm_ovm_sel
+    float32_t tabc[3];
+    float32_t d1, d2;
+    float32_t V0min, V0max;
+
+    svm->UAB[0] = Ualpha;
+    svm->UAB[1] = Ubeta;
+
+    calc_tabc(tabc, svm->UAB);
+    svm->sector = determine_sector_12N(tabc);
+    svm_active_durations(svm->sector, tabc, &d1, &d2);
+
+    if constexpr (ovm == 1) {
+        float32_t d12 = d1 + d2;
+        if (d12 > 1.0f) {
+            svm_ovm_mpe(&d1, &d2, d12);
+        }
+    }
+    else if constexpr (ovm == 2) {
+        float32_t d12 = d1 + d2;
+        if (d12 > 1.0f) {
+            svm_ovm_mme(&d1, &d2, d12);
+        }
+    }
+
+    float32_t v_cm = svm_zero_sequence(d1, d2, &V0min, &V0max);
+
+    if constexpr (row == DPWMMIN) {
+        v_cm = V0min;
+    }
+    else if constexpr (row == DPWMMAX) {
+        v_cm = V0max;
+    }
+    else if constexpr (row != SVPWM) {
+        uint32_t r = (row == DPWM_ADAPTIVE) ? SVM_ADAPT_ROW(svm->zs_shift) : row;
+        uint8_t sel = svm_zs_sel[r][svm->sector];
+        if (sel == 1) {
+            v_cm = V0min;
+        }
+        else if (sel == 2) {
+            v_cm = V0max;
+        }
+    }
+
+    svm_phase_duties(svm, v_cm, d1, d2);
+} //<- end of modulator_spec()
+
+#define SVM_SPEC_INSTANTIATE(zs) \
+    template void modulator_spec<SVM_MODE(zs, SVM_OVM_CLAMP)>(SVM_t*, float32_t, float32_t); \
+    template void modulator_spec<SVM_MODE(zs, SVM_OVM_MPE)>(SVM_t*, float32_t, float32_t); \
+    template void modulator_spec<SVM_MODE(zs, SVM_OVM_MME)>(SVM_t*, float32_t, float32_t);
+
+SVM_SPEC_INSTANTIATE(SVPWM)
+SVM_SPEC_INSTANTIATE(DMPWM3)
+SVM_SPEC_INSTANTIATE(DPWMMIN)
+SVM_SPEC_INSTANTIATE(DPWMMAX)
+SVM_SPEC_INSTANTIATE(DPWM0)
+SVM_SPEC_INSTANTIATE(DPWM1)
+SVM_SPEC_INSTANTIATE(DPWM2)
+SVM_SPEC_INSTANTIATE(DPWM_ADAPTIVE)
+
+} // namespace detail
+} // namespace mc
+
+/** \copydoc modulator_SVPWM */
+extern "C" void modulator_SVPWM(SVM_t* svm, const float32_t Ualpha, const float32_t Ubeta)
+{
+    mc::modulator<SVPWM>(*svm, Ualpha, Ubeta);
+} //<- end of modulator_SVPWM()
+
+/** \copydoc modulator_DMPWM3 */
+extern "C" void modulator_DMPWM3(SVM_t* svm, const float32_t Ualpha, const float32_t Ubeta)
+{
+    mc::modulator<DMPWM3>(*svm, Ualpha, Ubeta);
+} //<- end of modulator_DMPWM3()
+
+// EOF svm_spec.cpp
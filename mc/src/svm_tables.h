@@ -0,0 +1,92 @@
+/**
+ * @file        svm_tables.h
+ *
+ * @brief      lookup tables of the table-driven modulators (private to src/)
+ *
+ *      Shared by modulator_lut() in svm.c and modulator_batch() in svm_batch.c.
+ */
+#ifndef SVM_TABLES_H_
+    #define SVM_TABLES_H_
+
+#include "commontypes.h"
+#include "svm.h"
+
+#define SIGN(x)		(((x) > 0) - ((x) < 0))
+
+/*!
+* @brief		60° sector pair (sector_12N / 2) chosen by determine_sector_12N(),
+*				indexed by 9*SIGN(ta) + 3*SIGN(tb) + SIGN(tc) + 13
+*/
+static const uint8_t svm_pair_lut[27] = {
+	3, 5, 5, 3, 5, 5, 3, 4, 4,		// ta < 0
+	3, 5, 5, 3, 5, 5, 3, 4, 4,		// ta == 0
+	1, 1, 0, 2, 2, 0, 2, 2, 0,		// ta > 0
+};
+
+/*!
+* @brief		per sector pair: the active vector durations d1 = d1_sgn * tabc[d1_idx],
+*				d2 = d2_sgn * tabc[d2_idx] (the two switch statements of calc_svm_duty()),
+*				the 30° split (lower sector when tabc[cmp_lo] < tabc[cmp_hi]) and the
+*				phases receiving the lowest, middle and highest duty.
+*/
+typedef struct
+{
+	uint8_t			d1_idx;
+	uint8_t			d2_idx;
+	float32_t		d1_sgn;
+	float32_t		d2_sgn;
+	uint8_t			cmp_lo;
+	uint8_t			cmp_hi;
+	uint8_t			phase[3];
+} SVM_pair_t;
+
+static const SVM_pair_t svm_pair_tab[6] = {
+	{2, 0,  1.0f,  1.0f, 0, 2, {2, 1, 0}},	// V1(100), V2(110)
+	{2, 1, -1.0f, -1.0f, 1, 2, {2, 0, 1}},	// V3(010), V2(110)
+	{0, 1,  1.0f,  1.0f, 1, 0, {0, 2, 1}},	// V3(010), V4(011)
+	{0, 2, -1.0f, -1.0f, 2, 0, {0, 1, 2}},	// V5(001), V4(011)
+	{1, 2,  1.0f,  1.0f, 2, 1, {1, 0, 2}},	// V5(001), V6(101)
+	{1, 0, -1.0f, -1.0f, 0, 1, {1, 2, 0}},	// V1(100), V6(101)
+};
+
+/*!
+* @brief		zero-sequence selection per mode and 12N sector:
+*				0 = SVPWM offset limited to [V0min, V0max], 1 = V0min, 2 = V0max.
+*				The DPWM_ADAPTIVE row is the fallback used without an SVM_t, the
+*				float modulators pick the DPWM0..DPWM2 row from svm->zs_shift.
+*/
+static const uint8_t svm_zs_sel[SVM_MODE_NUM][12] = {
+	{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},	// SVPWM
+	{1, 2, 2, 1, 1, 2, 2, 1, 1, 2, 2, 1},	// DMPWM3
+	{1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1},	// DPWMMIN
+	{2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2},	// DPWMMAX
+	{1, 1, 2, 2, 1, 1, 2, 2, 1, 1, 2, 2},	// DPWM0
+	{2, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1, 2},	// DPWM1
+	{2, 2, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1},	// DPWM2
+	{2, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1, 2},	// DPWM_ADAPTIVE, as DPWM1
+};
+
+/*!
+* @brief		overmodulation candidate per (mode & SVM_OVM_MASK) >> 4:
+*				0 = d1, d2 as they are (clamp), 1 = MPE, 2 = MME; unknown bits clamp
+*/
+static const uint8_t svm_ovm_sel[4] = {0, 1, 2, 0};
+
+/*!
+* @brief		zero-sequence row of a mode, unknown rules fall back to SVPWM (row 0)
+*				by masking, so that the table-driven modulators stay branch-free
+*/
+#define SVM_ZS_ROW(mode)	(((uint32_t)(mode) & SVM_ZS_MASK) & (0u - (uint32_t)(((uint32_t)(mode) & SVM_ZS_MASK) < SVM_MODE_NUM)))
+
+/*!
+* @brief		overmodulation candidate of a mode
+*/
+#define SVM_OVM_SEL(mode)	(svm_ovm_sel[((uint32_t)(mode) & SVM_OVM_MASK) >> 4])
+
+/*!
+* @brief		DPWM0..DPWM2 row of DPWM_ADAPTIVE from svm->zs_shift, bounded to
+*				the three rows (only the sign counts), without a compare-and-branch
+*/
+#define SVM_ADAPT_ROW(shift)	((uint32_t)(DPWM1 + ((shift) > 0) - ((shift) < 0)))
+
+#endif //<- !defined SVM_TABLES_H_
@@ -0,0 +1,227 @@
+/**
+ * @file        task_sched.c
+ * @date        Oct 2026
+ *
+ * @brief       static multi-rate task scheduler
+ *
+ */
+
+#include <string.h>
+
+#include "task_sched.h"
+
+static uint32_t sched_gcd(uint32_t a, uint32_t b)
+{
+    while (b != 0) {
+        uint32_t r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+/** \copydoc sched_hyperperiod */
+uint32_t sched_hyperperiod(const Sched_Task_t* tasks, uint16_t n_tasks)
+{
+    uint32_t hyper = 1;
+    uint16_t k;
+
+    for (k = 0; k < n_tasks; k++) {
+        uint32_t d = tasks[k].divisor;
+        if (d == 0) {
+            return 0;
+        }
+        hyper = hyper / sched_gcd(hyper, d) * d;
+        if (hyper > SCHED_MAX_HYPER) {
+            return 0;
+        }
+    }
+    return hyper;
+} //<- end of sched_hyperperiod()
+
+// the checks of sched_init(), hyperperiod or 0
+static uint32_t sched_check(const Sched_Task_t* tasks, uint16_t n_tasks)
+{
+    uint16_t k;
+
+    if (n_tasks == 0 || n_tasks > SCHED_MAX_TASKS) {
+        return 0;
+    }
+    for (k = 0; k < n_tasks; k++) {
+        if (tasks[k].fn == 0 || tasks[k].divisor == 0 || tasks[k].phase >= tasks[k].divisor) {
+            return 0;
+        }
+    }
+    return sched_hyperperiod(tasks, n_tasks);
+}
+
+/** \copydoc sched_init */
+int16_t sched_init(Sched_Obj_t* const s, const Sched_Task_t* tasks, uint16_t n_tasks, uint32_t tick_budget,
+                   uint32_t (*counter)(void))
+{
+    uint32_t hyper = sched_check(tasks, n_tasks);
+    uint16_t k;
+
+    if (hyper == 0) {
+        return -1;
+    }
+
+    memset(s, 0, sizeof(*s));
+    s->tasks = tasks;
+    s->n_tasks = n_tasks;
+    s->hyper = hyper;
+    s->tick_budget = tick_budget;
+    s->counter = counter;
+    for (k = 0; k < n_tasks; k++) {
+        s->countdown[k] = tasks[k].phase;
+    }
+
+    return 0;
+} //<- end of sched_init()
+
+/** \copydoc sched_reset_stats */
+void sched_reset_stats(Sched_Obj_t* const s)
+{
+    memset(s->stat, 0, sizeof(s->stat));
+    s->tick_last = 0;
+    s->tick_max = 0;
+    s->tick_max_at = 0;
+    s->tick_overruns = 0;
+    s->tick_sum = 0;
+} //<- end of sched_reset_stats()
+
+/** \copydoc sched_tick */
+void sched_tick(Sched_Obj_t* const s)
+{
+    uint32_t (*counter)(void) = s->counter;
+    const uint32_t t_tick = counter ? counter() : 0;
+    uint32_t load = 0;
+    uint16_t k;
+
+    for (k = 0; k < s->n_tasks; k++) {
+        if (s->countdown[k] == 0) {
+            const Sched_Task_t* task = &s->tasks[k];
+            Sched_Stat_t* st = &s->stat[k];
+            uint32_t dt;
+
+            s->countdown[k] = task->divisor;
+            if (counter) {
+                const uint32_t t0 = counter();
+                task->fn(task->ctx);
+                dt = counter() - t0;
+            }
+            else {
+                task->fn(task->ctx);
+                dt = task->budget;
+                load += dt;
+            }
+
+            st->runs++;
+            st->last = dt;
+            st->max = dt > st->max ? dt : st->max;
+            st->sum += dt;
+            if (task->budget != 0 && dt > task->budget) {
+                st->overruns++;
+            }
+        }
+        s->countdown[k]--;
+    }
+
+    // with a counter the whole tick, dispatch included
+    if (counter) {
+        load = counter() - t_tick;
+    }
+    s->tick_last = load;
+    s->tick_sum += load;
+    if (load > s->tick_max) {
+        s->tick_max = load;
+        s->tick_max_at = s->tick;
+    }
+    if (s->tick_budget != 0 && load > s->tick_budget) {
+        s->tick_overruns++;
+    }
+    s->tick++;
+} //<- end of sched_tick()
+
+/** \copydoc sched_static_load */
+uint32_t sched_static_load(const Sched_Task_t* tasks, uint16_t n_tasks, uint32_t tick)
+{
+    uint32_t load = 0;
+    uint16_t k;
+
+    for (k = 0; k < n_tasks; k++) {
+        if (tick % tasks[k].divisor == tasks[k].phase) {
+            load += tasks[k].budget;
+        }
+    }
+    return load;
+} //<- end of sched_static_load()
+
+// busiest tick of the hyperperiod among those where task k would run at phase
+static uint32_t sched_peak_at(const Sched_Task_t* tasks, const uint8_t* placed, uint16_t n_tasks, uint16_t k,
+                              uint32_t phase, uint32_t hyper)
+{
+    uint32_t peak = 0, t;
+    uint16_t j;
+
+    for (t = phase; t < hyper; t += tasks[k].divisor) {
+        uint32_t load = 0;
+        for (j = 0; j < n_tasks; j++) {
+            if (placed[j] && t % tasks[j].divisor == tasks[j].phase) {
+                load += tasks[j].budget;
+            }
+        }
+        peak = load > peak ? load : peak;
+    }
+    return peak;
+}
+
+/** \copydoc sched_spread */
+uint32_t sched_spread(Sched_Task_t* tasks, uint16_t n_tasks)
+{
+    uint8_t placed[SCHED_MAX_TASKS];
+    uint32_t hyper = sched_check(tasks, n_tasks);
+    uint32_t peak = 0, t;
+    uint16_t k, n;
+
+    if (hyper == 0) {
+        return 0;
+    }
+
+    // fixed first: every-tick and unbudgeted tasks
+    for (k = 0; k < n_tasks; k++) {
+        placed[k] = tasks[k].divisor == 1 || tasks[k].budget == 0;
+    }
+
+    for (n = 0; n < n_tasks; n++) {
+        // the largest budget not placed yet, table order on ties
+        uint16_t best = n_tasks;
+        for (k = 0; k < n_tasks; k++) {
+            if (!placed[k] && (best == n_tasks || tasks[k].budget > tasks[best].budget)) {
+                best = k;
+            }
+        }
+        if (best == n_tasks) {
+            break;
+        }
+
+        uint32_t best_phase = 0, best_peak = 0xFFFFFFFFu, phase;
+        for (phase = 0; phase < tasks[best].divisor; phase++) {
+            uint32_t p = sched_peak_at(tasks, placed, n_tasks, best, phase, hyper);
+            if (p < best_peak) {
+                best_peak = p;
+                best_phase = phase;
+            }
+        }
+        tasks[best].phase = (uint16_t)best_phase;
+        placed[best] = 1;
+    }
+
+    for (t = 0; t < hyper; t++) {
+        uint32_t load = sched_static_load(tasks, n_tasks, t);
+        peak = load > peak ? load : peak;
+    }
+    return peak;
+} //<- end of sched_spread()
+
+// EOF task_sched.c
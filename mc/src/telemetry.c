@@ -0,0 +1,88 @@
+/**
+ * @file        telemetry.c
+ * @date        Oct 2026
+ *
+ * @brief       SPSC telemetry ring, consumer side and record helpers
+ *
+ */
+
+#include <string.h>
+
+#include "telemetry.h"
+
+/** \copydoc telem_ring_init */
+int16_t telem_ring_init(Telem_Ring_t* const ring, Telem_Record_t* buf, uint32_t capacity)
+{
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+        return -1;
+    }
+
+    memset(ring, 0, sizeof(*ring));
+    ring->buf = buf;
+    ring->mask = capacity - 1;
+    return 0;
+} //<- end of telem_ring_init()
+
+/** \copydoc telem_record_fill */
+void telem_record_fill(Telem_Record_t* rec, uint32_t tick, const PID_Obj_t* pid, const Transform_Obj_t* T,
+                       const SVM_t* svm)
+{
+    memset(rec, 0, sizeof(*rec));
+    rec->tick = tick;
+
+    if (pid) {
+        rec->pid_err = pid->err;
+        rec->pid_ui = pid->ui;
+        rec->pid_u = pid->u;
+    }
+    if (T) {
+        rec->a = T->abc.a;
+        rec->b = T->abc.b;
+        rec->alpha = T->AB0.alpha;
+        rec->beta = T->AB0.beta;
+        rec->d = T->dq0.d;
+        rec->q = T->dq0.q;
+    }
+    if (svm) {
+        rec->sector = svm->sector;
+        rec->m[0] = svm->m[0];
+        rec->m[1] = svm->m[1];
+        rec->m[2] = svm->m[2];
+    }
+} //<- end of telem_record_fill()
+
+/** \copydoc telem_pop */
+uint32_t telem_pop(Telem_Ring_t* const ring, Telem_Record_t* out, uint32_t max)
+{
+    uint32_t tail = ring->tail;     // only the consumer writes tail
+    uint32_t head = MC_TELEM_LOAD_ACQ(&ring->head);
+    uint32_t n = head - tail;
+    uint32_t first, i;
+
+    if (n > max) {
+        n = max;
+    }
+    if (n == 0) {
+        return 0;
+    }
+
+    // at most two contiguous pieces
+    i = tail & ring->mask;
+    first = ring->mask + 1 - i;
+    if (first > n) {
+        first = n;
+    }
+    memcpy(out, &ring->buf[i], first * sizeof(Telem_Record_t));
+    memcpy(out + first, &ring->buf[0], (n - first) * sizeof(Telem_Record_t));
+
+    MC_TELEM_STORE_REL(&ring->tail, tail + n);
+    return n;
+} //<- end of telem_pop()
+
+/** \copydoc telem_pending */
+uint32_t telem_pending(const Telem_Ring_t* const ring)
+{
+    return MC_TELEM_LOAD_ACQ(&ring->head) - ring->tail;
+} //<- end of telem_pending()
+
+// EOF telemetry.c
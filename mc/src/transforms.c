@@ -7,52 +7,77 @@
  * 
  */
 
- #include <math.h>
  #include "ctrl_common.h"
  #include "transforms.h"
+ #include "trig.h"
+ #include "instrument.h"
 
     /** \copydoc abc2AB0 */
 void abc2AB0(Transform_Obj_t *T_inst, int16_t numSensors)
 {
-    if (numSensors == 2)
-    {// assume phase a&b sensing, a+b+c = 0
-        T_inst->abc.c = -T_inst->abc.a - T_inst->abc.b;
-
-        T_inst->AB0.alpha = T_inst->abc.a;
-        T_inst->AB0.beta = SQRT3REC*(T_inst->abc.a + 2*T_inst->abc.b);
-        T_inst->AB0.zero_AB = 0;
-    }
-    else if (numSensors == 3)   // 3-phase
-    {
-        T_inst->AB0.alpha = TWO_THIRD*T_inst->abc.a-ONE_THIRD*(T_inst->abc.b+T_inst->abc.c);
-        T_inst->AB0.beta = SQRT3REC*(T_inst->abc.b-T_inst->abc.c);
-        T_inst->AB0.zero_AB = ONE_THIRD*(T_inst->abc.a+T_inst->abc.b+T_inst->abc.c);
-    }
-    
+    MC_INSTR_BEGIN(MC_INSTR_ABC2AB0);
+
+    abc2AB0_Inline(&T_inst->abc, &T_inst->AB0, numSensors);
+
+    MC_INSTR_END(MC_INSTR_ABC2AB0);
 } //<- end of abc2AB0
 
     /** \copydoc AB02dq0 */
 void AB02dq0(Transform_Obj_t *T_inst, float32_t theta_e)
 {
-    T_inst->dq0.d = T_inst->AB0.alpha * cos(theta_e) + T_inst->AB0.beta * sin(theta_e);
-    T_inst->dq0.q = - T_inst->AB0.alpha * sin(theta_e) + T_inst->AB0.beta * cos(theta_e);
-    T_inst->dq0.zero_dq = T_inst->AB0.zero_AB;
+    MC_INSTR_BEGIN(MC_INSTR_AB02DQ0);
+
+    SinCos_t sc;
+
+    // the inline body, AB02dq0_sincos() would record its own call inside this one
+    trig_sincos(theta_e, &sc);
+    AB02dq0_Inline(&T_inst->AB0, &sc, &T_inst->dq0);
+
+    MC_INSTR_END(MC_INSTR_AB02DQ0);
 } //<- end of AB02dq0
 
+    /** \copydoc AB02dq0_sincos */
+void AB02dq0_sincos(Transform_Obj_t *T_inst, const SinCos_t *sc)
+{
+    MC_INSTR_BEGIN(MC_INSTR_AB02DQ0_SINCOS);
+
+    AB02dq0_Inline(&T_inst->AB0, sc, &T_inst->dq0);
+
+    MC_INSTR_END(MC_INSTR_AB02DQ0_SINCOS);
+} //<- end of AB02dq0_sincos
+
     /** \copydoc dq02AB0 */
 void dq02AB0(Transform_Obj_t *T_inst, float32_t theta_e)
 {
-    T_inst->AB0.alpha = T_inst->dq0.d * cos(theta_e) - T_inst->dq0.q * sin(theta_e);
-    T_inst->AB0.beta = T_inst->dq0.d * sin(theta_e) + T_inst->dq0.q * cos(theta_e);
-    T_inst->AB0.zero_AB = T_inst->dq0.zero_dq;
+    MC_INSTR_BEGIN(MC_INSTR_DQ02AB0);
+
+    SinCos_t sc;
+
+    // the inline body, as in AB02dq0()
+    trig_sincos(theta_e, &sc);
+    dq02AB0_Inline(&T_inst->dq0, &sc, &T_inst->AB0);
+
+    MC_INSTR_END(MC_INSTR_DQ02AB0);
 } //<- end of dq02AB0
 
+    /** \copydoc dq02AB0_sincos */
+void dq02AB0_sincos(Transform_Obj_t *T_inst, const SinCos_t *sc)
+{
+    MC_INSTR_BEGIN(MC_INSTR_DQ02AB0_SINCOS);
+
+    dq02AB0_Inline(&T_inst->dq0, sc, &T_inst->AB0);
+
+    MC_INSTR_END(MC_INSTR_DQ02AB0_SINCOS);
+} //<- end of dq02AB0_sincos
+
 /** \copydoc AB02abc */
 void AB02abc(Transform_Obj_t *T_inst)
 {
-    T_inst->abc.a = T_inst->AB0.alpha + T_inst->AB0.zero_AB;
-    T_inst->abc.b = -T_inst->AB0.alpha/2 + SQRT3/2*T_inst->AB0.beta + T_inst->AB0.zero_AB;
-    T_inst->abc.c = -T_inst->AB0.alpha/2 - SQRT3/2*T_inst->AB0.beta + T_inst->AB0.zero_AB;
+    MC_INSTR_BEGIN(MC_INSTR_AB02ABC);
+
+    AB02abc_Inline(&T_inst->AB0, &T_inst->abc);
+
+    MC_INSTR_END(MC_INSTR_AB02ABC);
 } //<- end of AB02abc
 
 // EOF transform.c
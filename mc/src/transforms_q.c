@@ -0,0 +1,83 @@
+/**
+ * @file        transforms_q.c
+ * @date        Oct 2026
+ *
+ * @brief       Implements the fixed-point Clarke, iClarke, Park & iPark transformation
+ *
+ */
+
+#include "ctrl_common.h"
+#include "transforms_q.h"
+
+#define Q_ONE_THIRD                 Q_CONST(ONE_THIRD)
+#define Q_TWO_THIRD                 Q_CONST(TWO_THIRD)
+#define Q_SQRT3REC                  Q_CONST(SQRT3REC)
+#define Q_SIN60                     Q_CONST(SIN60)      // SQRT3/2
+#define Q_HALF                      Q_CONST(0.5)
+
+/** \copydoc abc2AB0_q */
+void abc2AB0_q(Transformq_Obj_t *T_inst, int16_t numSensors)
+{
+    if (numSensors == 2)
+    {// assume phase a&b sensing, a+b+c = 0
+        q_t kb = q_mul(Q_SQRT3REC, T_inst->abc.b);
+
+        T_inst->abc.c = q_sub(q_neg(T_inst->abc.a), T_inst->abc.b);
+
+        T_inst->AB0.alpha = T_inst->abc.a;
+        T_inst->AB0.beta = q_sat((q_acc_t)q_mul(Q_SQRT3REC, T_inst->abc.a) + kb + kb);
+        T_inst->AB0.zero_AB = 0;
+    }
+    else if (numSensors == 3)   // 3-phase
+    {
+        q_t a3 = q_mul(Q_ONE_THIRD, T_inst->abc.a);
+        q_t b3 = q_mul(Q_ONE_THIRD, T_inst->abc.b);
+        q_t c3 = q_mul(Q_ONE_THIRD, T_inst->abc.c);
+
+        T_inst->AB0.alpha = q_sat((q_acc_t)q_mul(Q_TWO_THIRD, T_inst->abc.a) - b3 - c3);
+        T_inst->AB0.beta = q_sub(q_mul(Q_SQRT3REC, T_inst->abc.b), q_mul(Q_SQRT3REC, T_inst->abc.c));
+        T_inst->AB0.zero_AB = q_sat((q_acc_t)a3 + b3 + c3);
+    }
+
+} //<- end of abc2AB0_q
+
+/** \copydoc AB02dq0_q */
+void AB02dq0_q(Transformq_Obj_t *T_inst, q_t theta_e)
+{
+    q_t alpha = T_inst->AB0.alpha;
+    q_t beta = T_inst->AB0.beta;
+    SinCos_q_t sc;
+
+    q_sincos(theta_e, &sc);
+
+    T_inst->dq0.d = q_add(q_mul(alpha, sc.cos), q_mul(beta, sc.sin));
+    T_inst->dq0.q = q_sub(q_mul(beta, sc.cos), q_mul(alpha, sc.sin));
+    T_inst->dq0.zero_dq = T_inst->AB0.zero_AB;
+} //<- end of AB02dq0_q
+
+/** \copydoc dq02AB0_q */
+void dq02AB0_q(Transformq_Obj_t *T_inst, q_t theta_e)
+{
+    q_t d = T_inst->dq0.d;
+    q_t q = T_inst->dq0.q;
+    SinCos_q_t sc;
+
+    q_sincos(theta_e, &sc);
+
+    T_inst->AB0.alpha = q_sub(q_mul(d, sc.cos), q_mul(q, sc.sin));
+    T_inst->AB0.beta = q_add(q_mul(d, sc.sin), q_mul(q, sc.cos));
+    T_inst->AB0.zero_AB = T_inst->dq0.zero_dq;
+} //<- end of dq02AB0_q
+
+/** \copydoc AB02abc_q */
+void AB02abc_q(Transformq_Obj_t *T_inst)
+{
+    q_t half_alpha = q_mul(Q_HALF, T_inst->AB0.alpha);
+    q_t k_beta = q_mul(Q_SIN60, T_inst->AB0.beta);
+
+    T_inst->abc.a = q_add(T_inst->AB0.alpha, T_inst->AB0.zero_AB);
+    T_inst->abc.b = q_sat((q_acc_t)k_beta - half_alpha + T_inst->AB0.zero_AB);
+    T_inst->abc.c = q_sat(-(q_acc_t)k_beta - half_alpha + T_inst->AB0.zero_AB);
+} //<- end of AB02abc_q
+
+// EOF transforms_q.c
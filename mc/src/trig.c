@@ -0,0 +1,161 @@
+/**
+ * @file        trig.c
+ * @date        Oct 2026
+ *
+ * @brief       single-precision sine/cosine engine
+ *
+ */
+
+#include <math.h>
+#include "ctrl_common.h"
+#include "trig.h"
+#include "trig_poly.h"
+
+#define TRIG_TAB_SIZE               (256)
+#define TRIG_TAB_MASK               (TRIG_TAB_SIZE - 1)
+#define TRIG_TAB_QUARTER            (TRIG_TAB_SIZE / 4)
+#define TRIG_TAB_SCALE              (40.74366543152521F)    // 256/(2*PI)
+#define TRIG_TAB_STEP_HI            (0.0245361328125F)      // 2*PI/256, exact part
+#define TRIG_TAB_STEP_LO            (7.559793630207423E-6F) // 2*PI/256 - TRIG_TAB_STEP_HI
+
+typedef union
+{
+    float32_t   f;
+    uint32_t    u;
+} F32_Bits_t;
+
+// sin(2*PI*k/256), k = 0..255; cos is read a quarter period ahead
+static const float32_t trig_sin_tab[TRIG_TAB_SIZE] = {
+     0.000000000e+00f,  2.454122901e-02f,  4.906767607e-02f,  7.356456667e-02f,
+     9.801714122e-02f,  1.224106774e-01f,  1.467304677e-01f,  1.709618866e-01f,
+     1.950903237e-01f,  2.191012353e-01f,  2.429801822e-01f,  2.667127550e-01f,
+     2.902846634e-01f,  3.136817515e-01f,  3.368898630e-01f,  3.598950505e-01f,
+     3.826834261e-01f,  4.052413106e-01f,  4.275550842e-01f,  4.496113360e-01f,
+     4.713967443e-01f,  4.928981960e-01f,  5.141027570e-01f,  5.349976420e-01f,
+     5.555702448e-01f,  5.758081675e-01f,  5.956993103e-01f,  6.152315736e-01f,
+     6.343932748e-01f,  6.531728506e-01f,  6.715589762e-01f,  6.895405650e-01f,
+     7.071067691e-01f,  7.242470980e-01f,  7.409511209e-01f,  7.572088242e-01f,
+     7.730104327e-01f,  7.883464098e-01f,  8.032075167e-01f,  8.175848126e-01f,
+     8.314695954e-01f,  8.448535800e-01f,  8.577286005e-01f,  8.700869679e-01f,
+     8.819212914e-01f,  8.932242990e-01f,  9.039893150e-01f,  9.142097831e-01f,
+     9.238795042e-01f,  9.329928160e-01f,  9.415440559e-01f,  9.495281577e-01f,
+     9.569403529e-01f,  9.637760520e-01f,  9.700312614e-01f,  9.757021070e-01f,
+     9.807852507e-01f,  9.852776527e-01f,  9.891765118e-01f,  9.924795628e-01f,
+     9.951847196e-01f,  9.972904325e-01f,  9.987954497e-01f,  9.996988177e-01f,
+     1.000000000e+00f,  9.996988177e-01f,  9.987954497e-01f,  9.972904325e-01f,
+     9.951847196e-01f,  9.924795628e-01f,  9.891765118e-01f,  9.852776527e-01f,
+     9.807852507e-01f,  9.757021070e-01f,  9.700312614e-01f,  9.637760520e-01f,
+     9.569403529e-01f,  9.495281577e-01f,  9.415440559e-01f,  9.329928160e-01f,
+     9.238795042e-01f,  9.142097831e-01f,  9.039893150e-01f,  8.932242990e-01f,
+     8.819212914e-01f,  8.700869679e-01f,  8.577286005e-01f,  8.448535800e-01f,
+     8.314695954e-01f,  8.175848126e-01f,  8.032075167e-01f,  7.883464098e-01f,
+     7.730104327e-01f,  7.572088242e-01f,  7.409511209e-01f,  7.242470980e-01f,
+     7.071067691e-01f,  6.895405650e-01f,  6.715589762e-01f,  6.531728506e-01f,
+     6.343932748e-01f,  6.152315736e-01f,  5.956993103e-01f,  5.758081675e-01f,
+     5.555702448e-01f,  5.349976420e-01f,  5.141027570e-01f,  4.928981960e-01f,
+     4.713967443e-01f,  4.496113360e-01f,  4.275550842e-01f,  4.052413106e-01f,
+     3.826834261e-01f,  3.598950505e-01f,  3.368898630e-01f,  3.136817515e-01f,
+     2.902846634e-01f,  2.667127550e-01f,  2.429801822e-01f,  2.191012353e-01f,
+     1.950903237e-01f,  1.709618866e-01f,  1.467304677e-01f,  1.224106774e-01f,
+     9.801714122e-02f,  7.356456667e-02f,  4.906767607e-02f,  2.454122901e-02f,
+     1.224646853e-16f, -2.454122901e-02f, -4.906767607e-02f, -7.356456667e-02f,
+    -9.801714122e-02f, -1.224106774e-01f, -1.467304677e-01f, -1.709618866e-01f,
+    -1.950903237e-01f, -2.191012353e-01f, -2.429801822e-01f, -2.667127550e-01f,
+    -2.902846634e-01f, -3.136817515e-01f, -3.368898630e-01f, -3.598950505e-01f,
+    -3.826834261e-01f, -4.052413106e-01f, -4.275550842e-01f, -4.496113360e-01f,
+    -4.713967443e-01f, -4.928981960e-01f, -5.141027570e-01f, -5.349976420e-01f,
+    -5.555702448e-01f, -5.758081675e-01f, -5.956993103e-01f, -6.152315736e-01f,
+    -6.343932748e-01f, -6.531728506e-01f, -6.715589762e-01f, -6.895405650e-01f,
+    -7.071067691e-01f, -7.242470980e-01f, -7.409511209e-01f, -7.572088242e-01f,
+    -7.730104327e-01f, -7.883464098e-01f, -8.032075167e-01f, -8.175848126e-01f,
+    -8.314695954e-01f, -8.448535800e-01f, -8.577286005e-01f, -8.700869679e-01f,
+    -8.819212914e-01f, -8.932242990e-01f, -9.039893150e-01f, -9.142097831e-01f,
+    -9.238795042e-01f, -9.329928160e-01f, -9.415440559e-01f, -9.495281577e-01f,
+    -9.569403529e-01f, -9.637760520e-01f, -9.700312614e-01f, -9.757021070e-01f,
+    -9.807852507e-01f, -9.852776527e-01f, -9.891765118e-01f, -9.924795628e-01f,
+    -9.951847196e-01f, -9.972904325e-01f, -9.987954497e-01f, -9.996988177e-01f,
+    -1.000000000e+00f, -9.996988177e-01f, -9.987954497e-01f, -9.972904325e-01f,
+    -9.951847196e-01f, -9.924795628e-01f, -9.891765118e-01f, -9.852776527e-01f,
+    -9.807852507e-01f, -9.757021070e-01f, -9.700312614e-01f, -9.637760520e-01f,
+    -9.569403529e-01f, -9.495281577e-01f, -9.415440559e-01f, -9.329928160e-01f,
+    -9.238795042e-01f, -9.142097831e-01f, -9.039893150e-01f, -8.932242990e-01f,
+    -8.819212914e-01f, -8.700869679e-01f, -8.577286005e-01f, -8.448535800e-01f,
+    -8.314695954e-01f, -8.175848126e-01f, -8.032075167e-01f, -7.883464098e-01f,
+    -7.730104327e-01f, -7.572088242e-01f, -7.409511209e-01f, -7.242470980e-01f,
+    -7.071067691e-01f, -6.895405650e-01f, -6.715589762e-01f, -6.531728506e-01f,
+    -6.343932748e-01f, -6.152315736e-01f, -5.956993103e-01f, -5.758081675e-01f,
+    -5.555702448e-01f, -5.349976420e-01f, -5.141027570e-01f, -4.928981960e-01f,
+    -4.713967443e-01f, -4.496113360e-01f, -4.275550842e-01f, -4.052413106e-01f,
+    -3.826834261e-01f, -3.598950505e-01f, -3.368898630e-01f, -3.136817515e-01f,
+    -2.902846634e-01f, -2.667127550e-01f, -2.429801822e-01f, -2.191012353e-01f,
+    -1.950903237e-01f, -1.709618866e-01f, -1.467304677e-01f, -1.224106774e-01f,
+    -9.801714122e-02f, -7.356456667e-02f, -4.906767607e-02f, -2.454122901e-02f,
+};
+
+static float32_t flip_sign(float32_t x, uint32_t sign_bit)
+{
+    F32_Bits_t v;
+    v.f = x;
+    v.u ^= sign_bit;
+    return v.f;
+}
+
+/** \copydoc trig_sincos */
+void trig_sincos(float32_t theta, SinCos_t *sc)
+{
+#if TRIG_BACKEND == TRIG_LIBM
+    trig_sincos_libm(theta, sc);
+#elif TRIG_BACKEND == TRIG_TABLE
+    trig_sincos_table(theta, sc);
+#else
+    trig_sincos_poly(theta, sc);
+#endif
+} //<- end of trig_sincos
+
+/** \copydoc trig_sincos_libm */
+void trig_sincos_libm(float32_t theta, SinCos_t *sc)
+{
+    sc->sin = sinf(theta);
+    sc->cos = cosf(theta);
+} //<- end of trig_sincos_libm
+
+/** \copydoc trig_sincos_poly */
+void trig_sincos_poly(float32_t theta, SinCos_t *sc)
+{
+    // quadrant k = round(theta / (PI/2)), remainder r in [-PI/4, PI/4]
+    float32_t kf = (theta * TWO_BY_PI + TRIG_ROUND_MAGIC) - TRIG_ROUND_MAGIC;
+    uint32_t  k = (uint32_t)(int32_t)kf;
+    float32_t r = ((theta - kf * PIO2_HI) - kf * PIO2_MID) - kf * PIO2_LO;
+    float32_t z = r * r;
+
+    // minimax polynomials on [-PI/4, PI/4]
+    float32_t s = r + r * z * (TRIG_S1 + z * (TRIG_S2 + z * TRIG_S3));
+    float32_t c = 1.0F - 0.5F * z + z * z * (TRIG_C2 + z * (TRIG_C3 + z * TRIG_C4));
+
+    // odd quadrants swap sin/cos; quadrants 2,3 negate sin, quadrants 1,2 negate cos
+    float32_t sin_r = (k & 1u) ? c : s;
+    float32_t cos_r = (k & 1u) ? s : c;
+
+    sc->sin = flip_sign(sin_r, (k & 2u) << 30);
+    sc->cos = flip_sign(cos_r, ((k + 1u) & 2u) << 30);
+} //<- end of trig_sincos_poly
+
+/** \copydoc trig_sincos_table */
+void trig_sincos_table(float32_t theta, SinCos_t *sc)
+{
+    // nearest table point x0 = k*2*PI/256, remainder d in [-PI/256, PI/256]
+    float32_t kf = (theta * TRIG_TAB_SCALE + TRIG_ROUND_MAGIC) - TRIG_ROUND_MAGIC;
+    uint32_t  k = (uint32_t)(int32_t)kf;
+    float32_t d = (theta - kf * TRIG_TAB_STEP_HI) - kf * TRIG_TAB_STEP_LO;
+
+    float32_t s0 = trig_sin_tab[k & TRIG_TAB_MASK];
+    float32_t c0 = trig_sin_tab[(k + TRIG_TAB_QUARTER) & TRIG_TAB_MASK];
+
+    float32_t cos_d = 1.0F - 0.5F * d * d;
+    float32_t sin_d = d - d * d * d * ONE_SIXTH;
+
+    sc->sin = s0 * cos_d + c0 * sin_d;
+    sc->cos = c0 * cos_d - s0 * sin_d;
+} //<- end of trig_sincos_table
+
+// EOF trig.c
@@ -0,0 +1,31 @@
+/**
+ * @file        trig_poly.h
+ *
+ * @brief      constants of the polynomial sine/cosine (private to src/)
+ *
+ *      Shared by trig_sincos_poly() in trig.c and the vector kernels of
+ *      drive_bank.c, which must evaluate the same expressions with the same
+ *      constants to stay bit-identical to it.
+ */
+#ifndef TRIG_POLY_H_
+    #define TRIG_POLY_H_
+
+// adding then subtracting 1.5*2^23 rounds a float to the nearest integer
+#define TRIG_ROUND_MAGIC            (12582912.0F)
+
+#define TWO_BY_PI                   (0.636619772367581F)    // 2/PI
+// PI/2 split so that k*PIO2_HI is exact for |k| < 2^15 (Cody-Waite reduction)
+#define PIO2_HI                     (1.5703125F)
+#define PIO2_MID                    (4.837512969970703125E-4F)
+#define PIO2_LO                     (7.54978995489188216E-8F)
+
+// minimax polynomials on [-PI/4, PI/4]:
+// sin r = r + r*z*(S1 + z*(S2 + z*S3)), cos r = 1 - z/2 + z*z*(C2 + z*(C3 + z*C4)), z = r*r
+#define TRIG_S1                     (-1.6666654611E-1F)
+#define TRIG_S2                     (8.3321608736E-3F)
+#define TRIG_S3                     (-1.9515295891E-4F)
+#define TRIG_C2                     (4.166664568298827E-2F)
+#define TRIG_C3                     (-1.388731625493765E-3F)
+#define TRIG_C4                     (2.443315711809948E-5F)
+
+#endif //<- !defined TRIG_POLY_H_